@@ -0,0 +1,30 @@
+#pragma once
+#include <array>
+#include <string_view>
+
+#include <PositionState.hpp>
+
+/**
+ * @brief fixed corpus every benchmark runs over, results stay comparable between runs only as long
+ *  as this list is unchanged
+ */
+struct BenchPosition
+{
+    std::string_view name;
+    std::string_view fen;
+};
+
+inline constexpr std::array<BenchPosition, 6> BENCH_POSITIONS{{
+    {"opening/start", "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1"},
+    {"opening/ruy_lopez", "r1bqkbnr/pppp1ppp/2n5/1B2p3/4P3/5N2/PPPP1PPP/RNBQK2R b KQkq - 3 3"},
+    {"middlegame/kiwipete",
+     "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1"},
+    {"middlegame/open", "r4rk1/1pp1qppp/p1np1n2/2b1p1B1/2B1P1b1/P1NP1N2/1PP1QPPP/R4RK1 w - - 0 10"},
+    {"endgame/rook_pawns", "8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8 w - - 0 1"},
+    {"endgame/queen_vs_rook", "8/8/2k5/8/2r5/8/3QK3/8 w - - 0 1"},
+}};
+
+inline PositionState load_bench_position(std::size_t index)
+{
+    return PositionState::from_fen(BENCH_POSITIONS[index].fen);
+}
@@ -0,0 +1,37 @@
+#include <benchmark/benchmark.h>
+
+#include "BenchPositions.hpp"
+#include <Board.hpp>
+
+namespace
+{
+void BM_board_clone(benchmark::State& state)
+{
+    const auto index = static_cast<std::size_t>(state.range(0));
+    const auto position = load_bench_position(index);
+    const auto& board = position.get_board();
+    for (auto _ : state)
+    {
+        auto copy = board.clone();
+        benchmark::DoNotOptimize(copy);
+    }
+    state.SetLabel(std::string{BENCH_POSITIONS[index].name});
+}
+
+void BM_board_for_each_piece(benchmark::State& state)
+{
+    const auto index = static_cast<std::size_t>(state.range(0));
+    const auto position = load_bench_position(index);
+    const auto& board = position.get_board();
+    for (auto _ : state)
+    {
+        std::size_t piece_count = 0;
+        board.for_each_piece([&piece_count](const auto&...) { ++piece_count; });
+        benchmark::DoNotOptimize(piece_count);
+    }
+    state.SetLabel(std::string{BENCH_POSITIONS[index].name});
+}
+}  // namespace
+
+BENCHMARK(BM_board_clone)->DenseRange(0, BENCH_POSITIONS.size() - 1);
+BENCHMARK(BM_board_for_each_piece)->DenseRange(0, BENCH_POSITIONS.size() - 1);
@@ -0,0 +1,151 @@
+#include <benchmark/benchmark.h>
+
+#include "BenchPositions.hpp"
+#include <AttackMap.hpp>
+#include <MoveGenerator.hpp>
+
+namespace
+{
+void BM_generate_available_moves(benchmark::State& state)
+{
+    const auto index = static_cast<std::size_t>(state.range(0));
+    auto position = load_bench_position(index);
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(position.generate_available_moves());
+    }
+    state.SetLabel(std::string{BENCH_POSITIONS[index].name});
+    state.SetItemsProcessed(state.iterations());
+}
+
+void BM_generate_legal_moves(benchmark::State& state)
+{
+    const auto index = static_cast<std::size_t>(state.range(0));
+    auto position = load_bench_position(index);
+    std::vector<Move> moves;
+    for (auto _ : state)
+    {
+        position.generate_legal_moves(moves);
+        benchmark::DoNotOptimize(moves.data());
+    }
+    state.SetLabel(std::string{BENCH_POSITIONS[index].name});
+    state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(moves.size()));
+}
+
+void BM_count_legal_moves(benchmark::State& state)
+{
+    const auto index = static_cast<std::size_t>(state.range(0));
+    const auto position = load_bench_position(index);
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(position.count_legal_moves());
+    }
+    state.SetLabel(std::string{BENCH_POSITIONS[index].name});
+}
+
+void BM_generate_squares_under_attack(benchmark::State& state)
+{
+    const auto index = static_cast<std::size_t>(state.range(0));
+    auto position = load_bench_position(index);
+    auto& board = position.get_board();
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(generate_squares_under_attack(board, PieceColor::WHITE));
+        benchmark::DoNotOptimize(generate_squares_under_attack(board, PieceColor::BLACK));
+    }
+    state.SetLabel(std::string{BENCH_POSITIONS[index].name});
+}
+
+void BM_make_unmake_move(benchmark::State& state)
+{
+    const auto index = static_cast<std::size_t>(state.range(0));
+    auto position = load_bench_position(index);
+    std::vector<Move> moves;
+    position.generate_legal_moves(moves);
+    for (auto _ : state)
+    {
+        for (const auto& move : moves)
+        {
+            const auto undo_info = position.make_move(move);
+            benchmark::DoNotOptimize(position.get_board());
+            position.unmake_move(move, undo_info);
+        }
+    }
+    state.SetLabel(std::string{BENCH_POSITIONS[index].name});
+    state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(moves.size()));
+}
+
+void BM_attack_map_update(benchmark::State& state)
+{
+    const auto index = static_cast<std::size_t>(state.range(0));
+    auto position = load_bench_position(index);
+    AttackMap attack_map{position.get_board()};
+    std::vector<Move> moves;
+    position.generate_legal_moves(moves);
+    for (auto _ : state)
+    {
+        for (const auto& move : moves)
+        {
+            const auto undo_info = position.make_move(move);
+            attack_map.update(position.get_board(), move);
+            benchmark::DoNotOptimize(attack_map.get_attacked_squares(PieceColor::WHITE));
+            position.unmake_move(move, undo_info);
+            attack_map.update(position.get_board(), move);
+        }
+    }
+    state.SetLabel(std::string{BENCH_POSITIONS[index].name});
+    state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(moves.size()));
+}
+
+void BM_attack_map_rebuild(benchmark::State& state)
+{
+    const auto index = static_cast<std::size_t>(state.range(0));
+    auto position = load_bench_position(index);
+    std::vector<Move> moves;
+    position.generate_legal_moves(moves);
+    for (auto _ : state)
+    {
+        for (const auto& move : moves)
+        {
+            const auto undo_info = position.make_move(move);
+            const AttackMap attack_map{position.get_board()};
+            benchmark::DoNotOptimize(attack_map.get_attacked_squares(PieceColor::WHITE));
+            position.unmake_move(move, undo_info);
+            benchmark::DoNotOptimize(AttackMap{position.get_board()});
+        }
+    }
+    state.SetLabel(std::string{BENCH_POSITIONS[index].name});
+    state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(moves.size()));
+}
+
+/**
+ * @brief arg 0 validates consistent data, arg 1 data with a rook missing from its square
+ */
+void BM_validate_special_moves(benchmark::State& state)
+{
+    const auto index = static_cast<std::size_t>(state.range(0));
+    const auto position = load_bench_position(index);
+    auto special_moves_data = position.get_special_moves_data();
+    if (state.range(1) == 1)
+    {
+        special_moves_data.queen_side_rook = Position{1, 0};
+    }
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(
+            special_moves_data.validate(position.get_board(), position.get_side_to_move()));
+    }
+    state.SetLabel(std::string{BENCH_POSITIONS[index].name}
+                   + (state.range(1) == 1 ? "/invalid" : "/valid"));
+}
+}  // namespace
+
+BENCHMARK(BM_generate_available_moves)->DenseRange(0, BENCH_POSITIONS.size() - 1);
+BENCHMARK(BM_generate_legal_moves)->DenseRange(0, BENCH_POSITIONS.size() - 1);
+BENCHMARK(BM_count_legal_moves)->DenseRange(0, BENCH_POSITIONS.size() - 1);
+BENCHMARK(BM_generate_squares_under_attack)->DenseRange(0, BENCH_POSITIONS.size() - 1);
+BENCHMARK(BM_make_unmake_move)->DenseRange(0, BENCH_POSITIONS.size() - 1);
+BENCHMARK(BM_attack_map_update)->DenseRange(0, BENCH_POSITIONS.size() - 1);
+BENCHMARK(BM_attack_map_rebuild)->DenseRange(0, BENCH_POSITIONS.size() - 1);
+BENCHMARK(BM_validate_special_moves)
+    ->ArgsProduct({benchmark::CreateDenseRange(0, BENCH_POSITIONS.size() - 1, 1), {0, 1}});
@@ -0,0 +1,72 @@
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+
+#include "AnalysisServer.hpp"
+#include "UnixSocket.hpp"
+
+/**
+ * @brief replies queued for a client but not yet written, beyond this the client is dropped
+ */
+constexpr std::size_t DEFAULT_MAX_OUTBOUND_BYTES = 1 << 20;
+
+/**
+ * @brief serves one client of AnalysisServer over a unix socket
+ * @note requests are read and submitted on a reader thread, replies are queued by server
+ *  threads and written on a writer thread of the connection, so server threads never block on
+ *  a client. A client that does not read its replies until max_outbound_bytes pile up is
+ *  disconnected
+ */
+class AnalysisConnection
+{
+public:
+    AnalysisConnection(UnixSocket socket,
+                       AnalysisServer& server,
+                       std::size_t max_outbound_bytes = DEFAULT_MAX_OUTBOUND_BYTES);
+    /**
+     * @brief disconnects client, replies still queued are dropped
+     */
+    ~AnalysisConnection();
+    AnalysisConnection(const AnalysisConnection&) = delete;
+    AnalysisConnection& operator=(const AnalysisConnection&) = delete;
+
+    /**
+     * @brief client disconnected or was disconnected, no more requests are read
+     */
+    bool is_closed() const;
+    bool is_slow_consumer() const;
+
+private:
+    /**
+     * @brief shared with reply callbacks, which may outlive the connection inside the server
+     */
+    struct Outbound
+    {
+        UnixSocket socket;
+        std::mutex mutex;
+        std::condition_variable condition;
+        std::deque<std::string> frames;
+        std::size_t byte_count{0};
+        std::size_t max_byte_count{0};
+        bool is_closed{false};
+        std::atomic<bool> is_slow_consumer{false};
+
+        void push(std::string payload);
+        void close();
+    };
+
+    void read_requests(AnalysisServer& server);
+    void write_replies();
+
+private:
+    std::shared_ptr<Outbound> m_outbound;
+    std::atomic<bool> m_is_closed{false};
+    std::thread m_reader;
+    std::thread m_writer;
+};
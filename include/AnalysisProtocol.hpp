@@ -0,0 +1,96 @@
+#pragma once
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+
+#include "Move.hpp"
+#include "Search.hpp"
+
+/**
+ * @brief requests understood by the analysis server
+ * @note payloads are text, one request per frame:
+ *  "<id> moves <fen>", "<id> eval <fen>", "<id> metrics" and
+ *  "<id> search <max depth> <move time ms> <deadline ms> <fen>" where 0 means no limit.
+ *  Replies are "<id> ok ..." or "<id> error <reason>", replies may come in different order than
+ *  requests so the id chosen by the client is echoed
+ */
+enum class AnalysisCommand : std::uint8_t
+{
+    LEGAL_MOVES,
+    EVALUATE,
+    SEARCH,
+    METRICS
+};
+constexpr std::size_t ANALYSIS_COMMAND_COUNT = 4;
+const char* to_c_str(AnalysisCommand command);
+
+struct AnalysisRequest
+{
+    std::uint64_t id{0};
+    AnalysisCommand command{AnalysisCommand::LEGAL_MOVES};
+    std::string fen;
+    SearchLimits limits;
+    /**
+     * @brief time after receipt until which a reply is useful, counted by the server
+     */
+    std::optional<std::chrono::milliseconds> deadline;
+};
+
+/**
+ * @warning throws invalid_argument if payload is malformed, fen itself is not validated here
+ */
+AnalysisRequest parse_analysis_request(std::string_view payload);
+std::string format_analysis_request(const AnalysisRequest& request);
+/**
+ * @brief id at the start of request or reply payload, 0 if there is none
+ */
+std::uint64_t get_payload_id(std::string_view payload);
+
+std::string format_error_reply(std::uint64_t id, std::string_view reason);
+/**
+ * @brief "<id> ok e2e4 g1f3 ..."
+ */
+std::string format_legal_moves_reply(std::uint64_t id,
+                                     const Move* moves_begin,
+                                     const Move* moves_end);
+/**
+ * @brief "<id> ok <centipawns from point of view of side to move>"
+ */
+std::string format_evaluation_reply(std::uint64_t id, std::int32_t score);
+/**
+ * @brief "<id> ok bestmove <move or none> score <score> depth <depth> nodes <nodes> pv <moves>"
+ */
+std::string format_search_reply(std::uint64_t id, const SearchResult& result);
+/**
+ * @brief "<id> ok <metrics as json>"
+ */
+std::string format_metrics_reply(std::uint64_t id, std::string_view metrics_json);
+
+constexpr std::size_t FRAME_HEADER_SIZE = 4;
+constexpr std::size_t MAX_FRAME_SIZE = 1 << 20;
+
+/**
+ * @brief payload prefixed by its size as 4 byte little endian number
+ */
+std::string encode_frame(std::string_view payload);
+
+/**
+ * @brief splits a byte stream into frames, bytes may arrive in arbitrary pieces
+ */
+class FrameDecoder
+{
+public:
+    void append(const char* data, std::size_t size);
+    /**
+     * @return next complete frame payload, empty if more bytes are needed
+     * @warning throws length_error if frame is larger than MAX_FRAME_SIZE
+     */
+    std::optional<std::string> next_frame();
+
+private:
+    std::string m_buffer;
+    std::size_t m_read_offset{0};
+};
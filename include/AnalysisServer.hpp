@@ -0,0 +1,167 @@
+#pragma once
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include "AnalysisProtocol.hpp"
+#include "MoveBatch.hpp"
+
+struct AnalysisServerConfig
+{
+    std::size_t search_thread_count{2};
+    /**
+     * @brief searches waiting for a thread, further searches are rejected with "busy"
+     */
+    std::size_t max_queued_searches{64};
+    /**
+     * @brief legal move and evaluation requests waiting for a batch, further ones get "busy"
+     */
+    std::size_t max_queued_batch_requests{4096};
+    std::size_t max_batch_size{64};
+    /**
+     * @brief threads generating legal moves of one batch, the batch thread included
+     */
+    std::size_t batch_thread_count{1};
+    /**
+     * @brief how long the first short request of a batch waits for others to join it
+     */
+    std::chrono::microseconds batch_window{200};
+};
+
+/**
+ * @brief latency from receipt of request to its reply, in microseconds
+ */
+struct LatencyPercentiles
+{
+    std::uint64_t sample_count{0};
+    std::uint64_t p50{0};
+    std::uint64_t p90{0};
+    std::uint64_t p99{0};
+    std::uint64_t max{0};
+};
+
+struct AnalysisMetrics
+{
+    std::size_t batch_queue_depth{0};
+    std::size_t search_queue_depth{0};
+    std::size_t active_searches{0};
+    std::uint64_t batches{0};
+    std::uint64_t batched_requests{0};
+    std::uint64_t rejected_requests{0};
+    std::uint64_t expired_requests{0};
+    /**
+     * @brief replies with an error, rejected and expired requests included
+     */
+    std::uint64_t failed_requests{0};
+    /**
+     * @brief indexed by AnalysisCommand, computed over the last LATENCY_WINDOW_SIZE served
+     *  replies, error replies are left out so that fast rejections don't hide slow service
+     */
+    std::array<LatencyPercentiles, ANALYSIS_COMMAND_COUNT> latencies;
+};
+constexpr std::size_t LATENCY_WINDOW_SIZE = 4096;
+
+std::string to_json(const AnalysisMetrics& metrics);
+
+/**
+ * @brief answers analysis requests of many clients, independent of the transport
+ * @note legal move and evaluation requests are collected for at most batch_window and served
+ *  together on one thread, move generation of a batch goes through a MoveBatchGenerator of
+ *  batch_thread_count threads. Searches run on a fixed pool of threads behind a bounded
+ *  queue, a search whose deadline passed while queued is answered with an error without being
+ *  searched and its move time is cut to the time left otherwise. Both queues are bounded,
+ *  requests that don't fit are answered with "busy"
+ */
+class AnalysisServer
+{
+public:
+    /**
+     * @brief receives the reply payload, called from a server thread or from submit itself
+     * @warning must not block, e.g. on a socket write, every other client would wait for it
+     */
+    using ReplyCallback = std::function<void(std::string)>;
+
+    explicit AnalysisServer(const AnalysisServerConfig& config = {});
+    /**
+     * @brief stops running searches, requests still queued are answered with an error
+     */
+    ~AnalysisServer();
+    AnalysisServer(const AnalysisServer&) = delete;
+    AnalysisServer& operator=(const AnalysisServer&) = delete;
+
+    /**
+     * @brief reply is called exactly once for every payload, malformed payloads included
+     */
+    void submit(std::string_view payload, ReplyCallback reply);
+    AnalysisMetrics get_metrics() const;
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    struct PendingRequest
+    {
+        AnalysisRequest request;
+        ReplyCallback reply;
+        Clock::time_point received;
+    };
+
+    struct LatencyWindow
+    {
+        std::array<std::uint32_t, LATENCY_WINDOW_SIZE> samples{};
+        std::size_t sample_count{0};
+        std::size_t next_index{0};
+    };
+
+    void run_batches();
+    void run_searches();
+    void serve_batch(std::vector<PendingRequest>& batch);
+    void serve_search(PendingRequest& pending);
+    /**
+     * @brief replies to a served request and records its latency
+     */
+    void finish(PendingRequest& pending, std::string reply);
+    /**
+     * @brief replies with an error, counted in failed_requests instead of the latencies
+     */
+    void fail(PendingRequest& pending, std::string_view reason);
+
+private:
+    AnalysisServerConfig m_config;
+
+    // used by the batch thread only, kept so batches reuse threads and arenas
+    MoveBatchGenerator m_move_generator;
+    std::vector<PositionState> m_move_positions;
+    std::vector<std::size_t> m_move_request_indices;
+    MoveBatch m_moves;
+
+    mutable std::mutex m_batch_mutex;
+    std::condition_variable m_batch_condition;
+    std::deque<PendingRequest> m_batch_queue;
+
+    mutable std::mutex m_search_mutex;
+    std::condition_variable m_search_condition;
+    std::deque<PendingRequest> m_search_queue;
+    std::size_t m_active_searches{0};
+
+    mutable std::mutex m_metrics_mutex;
+    std::array<LatencyWindow, ANALYSIS_COMMAND_COUNT> m_latencies;
+    std::uint64_t m_batches{0};
+    std::uint64_t m_batched_requests{0};
+    std::uint64_t m_rejected_requests{0};
+    std::uint64_t m_expired_requests{0};
+    std::uint64_t m_failed_requests{0};
+
+    std::atomic<bool> m_shutdown{false};
+    std::thread m_batch_thread;
+    std::vector<std::thread> m_search_threads;
+};
@@ -0,0 +1,75 @@
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <vector>
+
+#include "GameState.hpp"
+#include "Search.hpp"
+
+/**
+ * @brief what the worker knows about the position of one request
+ * @note legal moves are published before search starts, result is updated after every
+ *  completed depth
+ */
+struct AnalysisSnapshot
+{
+    std::uint64_t request_id{0};
+    std::vector<Move> legal_moves;
+    SearchResult result;
+    bool is_searching{false};
+};
+
+/**
+ * @brief generates moves and searches on its own thread so callers like a render loop never
+ *  wait for it
+ * @note a new request stops the running search, only the latest request is ever served. The
+ *  snapshot is copied under a mutex, it is small enough for polling once per frame
+ */
+class AnalysisWorker
+{
+public:
+    AnalysisWorker();
+    ~AnalysisWorker();
+    AnalysisWorker(const AnalysisWorker&) = delete;
+    AnalysisWorker& operator=(const AnalysisWorker&) = delete;
+
+    /**
+     * @return id the snapshot will carry once the worker picked request up
+     */
+    std::uint64_t analyse(const GameState& game, const SearchLimits& limits);
+    /**
+     * @brief stops running search, its last completed depth stays in the snapshot
+     * @note a request the worker didn't pick up yet is dropped, its snapshot has no moves and
+     *  no result
+     */
+    void stop();
+    AnalysisSnapshot get_snapshot() const;
+    /**
+     * @brief blocks until request with id is searched to the end or stopped
+     */
+    void wait_until_finished(std::uint64_t request_id) const;
+
+private:
+    struct Request
+    {
+        std::uint64_t id;
+        GameState game;
+        SearchLimits limits;
+    };
+
+    void run();
+
+private:
+    mutable std::mutex m_mutex;
+    mutable std::condition_variable m_condition;
+    std::optional<Request> m_pending_request;
+    std::uint64_t m_last_request_id{0};
+    AnalysisSnapshot m_snapshot;
+    std::atomic<bool> m_stop_search{false};
+    bool m_shutdown{false};
+    std::thread m_thread;
+};
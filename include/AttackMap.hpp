@@ -0,0 +1,62 @@
+#pragma once
+#include <array>
+#include <cstdint>
+
+#include "Board.hpp"
+#include "Move.hpp"
+#include "Square.hpp"
+
+/**
+ * @brief attacks of every piece on the board plus number of attackers per square and color,
+ *  kept up to date move by move instead of being rebuilt
+ * @note update recomputes only pieces on changed squares and sliders whose recorded attacks
+ *  reach a changed square, i.e. whose rays were opened or blocked by the move. Squares of own
+ *  pieces count as attacked, same as get_attacked_squares
+ */
+class AttackMap
+{
+public:
+    AttackMap() = default;
+    explicit AttackMap(const Board& board);
+
+    /**
+     * @brief brings map in line with board after pieces on changed squares were added, removed
+     *  or replaced
+     * @warning pieces on other squares have to be the same as when map was last updated
+     */
+    void update(const Board& board, SquareSet changed_squares);
+    /**
+     * @brief same as update with squares move changes, works after make_move and unmake_move
+     */
+    void update(const Board& board, const Move& move);
+
+    /**
+     * @brief squares attacked by the piece standing on square, empty if square is empty
+     */
+    SquareSet get_piece_attacks(Square square) const;
+    std::uint8_t get_attacker_count(Square square, PieceColor color) const;
+    bool is_attacked(Square square, PieceColor by_color) const;
+    SquareSet get_attacked_squares(PieceColor by_color) const;
+
+    friend bool operator==(const AttackMap& lhs, const AttackMap& rhs);
+
+private:
+    void add_piece_attacks(const Board& board, Square square, SquareSet occupancy);
+    void remove_piece_attacks(Square square);
+
+private:
+    std::array<SquareSet, SQUARE_COUNT> m_piece_attacks{};
+    std::array<std::array<std::uint8_t, SQUARE_COUNT>, 2> m_attacker_counts{};
+    std::array<SquareSet, 2> m_attacked_squares{};
+    /**
+     * @brief squares whose attacks are recorded, by color of the piece
+     */
+    std::array<SquareSet, 2> m_attacking_pieces{};
+    SquareSet m_sliders;
+};
+
+/**
+ * @brief squares whose piece is added, removed or replaced by move: from, to, square of pawn
+ *  taken en passant and both rook squares of castling
+ */
+SquareSet get_changed_squares(const Move& move);
@@ -0,0 +1,41 @@
+#pragma once
+#include <cstdint>
+
+#include "Board.hpp"
+#include "Square.hpp"
+
+SquareSet get_knight_attacks(Square square);
+SquareSet get_king_attacks(Square square);
+/**
+ * @brief squares attacked by pawn of color standing on square
+ */
+SquareSet get_pawn_attacks(Square square, PieceColor pawn_color);
+/**
+ * @brief squares reached by sliding from square until and including first occupied square
+ */
+SquareSet get_bishop_attacks(Square square, SquareSet occupancy);
+SquareSet get_rook_attacks(Square square, SquareSet occupancy);
+
+/**
+ * @brief pieces of both colors attacking square, sliders are blocked by occupancy
+ * @note works backwards from square: leaper masks and slider rays of square are intersected
+ *  with pieces of the matching type, no move generation and no allocation is needed.
+ *  occupancy may differ from board, e.g. with the moving piece removed
+ */
+SquareSet attackers_to(const Board& board, Square square, SquareSet occupancy);
+/**
+ * @note same squares as generate_squares_under_attack(board, by_color) contains, for squares not
+ *  occupied by pieces of by_color
+ */
+bool is_square_attacked(const Board& board, Square square, PieceColor by_color);
+/**
+ * @brief squares attacked by all pieces of color, squares of own pieces included
+ * @note computed set-wise: every slider of color is filled in all 8 directions at once with
+ *  Kogge-Stone occluded fills, AVX2 builds fill 4 directions and SSE2 builds 2 opposite
+ *  directions per instruction, other builds use scalar shifts
+ */
+SquareSet get_attacked_squares(const Board& board, PieceColor by_color);
+/**
+ * @brief scalar version of get_attacked_squares, same result on every build
+ */
+SquareSet get_attacked_squares_scalar(const Board& board, PieceColor by_color);
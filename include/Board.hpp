@@ -2,38 +2,122 @@
 #include <array>
 #include <literals.hpp>
 #include <memory>
+#include <optional>
+#include <type_traits>
 
 #include "Pieces.hpp"
+#include "Square.hpp"
 
+/**
+ * @brief 8x8 mailbox of piece codes plus occupancy masks per color and per piece type,
+ *  trivially copyable so copying a board is a memcpy
+ * @note Piece objects are only materialized on demand by the facade methods, masks are kept in
+ *  sync by add_piece and remove_piece so pieces of a color and type are found without a scan
+ */
 class Board
 {
-    using PieceContainer = std::array<std::array<std::unique_ptr<Piece>, 8_sz>, 8_sz>;
+    using PieceCodeContainer = std::array<std::array<PieceCode, 8_sz>, 8_sz>;
 
 public:
+    /**
+     * @note plain copy, kept for callers written when board was move only
+     */
     Board clone() const;
     /**
      * @brief add piece at position specified in piece
      * @return true if piece was added
+     * @note only type and color of piece are stored
      */
     bool add_piece(std::unique_ptr<Piece> piece);
+    /**
+     * @return true if piece was added
+     */
+    bool add_piece(PieceCode piece_code, const Position& position);
     /**
      * @brief remove piece at position
-     * @return true if piece was removed
+     * @return removed piece, nullptr if square was empty
+     * @note allocates the returned piece, use remove_piece_code when only code is needed
      */
-
     std::unique_ptr<Piece> remove_piece(const Position& position);
+    /**
+     * @return code of removed piece, empty code if square was empty
+     */
+    PieceCode remove_piece_code(const Position& position);
 
     bool is_square_empty(const Position& position) const;
     /**
-     * @warning throws out of range error if position is invalid or empty
+     * @warning throws logic error if position is invalid or empty
      */
-    const Piece& get_piece_at_position(const Position& position) const;
+    PieceCode get_piece_at_position(const Position& position) const;
+    /**
+     * @return empty code if position is invalid or empty
+     */
+    PieceCode get_piece_code(const Position& position) const;
+    /**
+     * @note no bounds check, square is always on the board
+     */
+    PieceCode get_piece_code(Square square) const;
+    SquareSet get_occupied_squares() const;
+    SquareSet get_pieces(PieceColor piece_color) const;
+    SquareSet get_pieces(PieceColor piece_color, PieceType piece_type) const;
+    /**
+     * @return nullopt if there is no king of color on board
+     */
+    std::optional<Position> get_king_position(PieceColor piece_color) const;
     void clear_board();
 
+    /**
+     * @note visited pieces are temporaries, changing them doesn't change the board
+     */
     void apply_piece_visitor(PieceVisitor& visitor);
+    /**
+     * @brief calls function(PieceCode, const Position&) for every piece in square index order,
+     *  no virtual dispatch
+     */
+    template <typename Function>
+    void for_each_piece(Function&& function) const;
 
     static bool is_piece_position_valid(const Position& piece_position);
 
 private:
-    PieceContainer m_board;
+    void toggle_masks(PieceCode piece_code, Square square);
+
+private:
+    PieceCodeContainer m_piece_codes;
+    std::array<std::uint64_t, 2> m_color_masks{};
+    std::array<std::uint64_t, 6> m_type_masks{};
 };
+static_assert(std::is_trivially_copyable_v<Board>);
+static_assert(sizeof(Board) <= 128);
+
+inline PieceCode Board::get_piece_code(Square square) const
+{
+    return m_piece_codes[square.get_rank()][square.get_file()];
+}
+
+inline SquareSet Board::get_occupied_squares() const
+{
+    return SquareSet{m_color_masks[0] | m_color_masks[1]};
+}
+
+inline SquareSet Board::get_pieces(PieceColor piece_color) const
+{
+    return SquareSet{m_color_masks[to_index(piece_color)]};
+}
+
+inline SquareSet Board::get_pieces(PieceColor piece_color, PieceType piece_type) const
+{
+    return SquareSet{m_color_masks[to_index(piece_color)]
+                     & m_type_masks[static_cast<std::size_t>(piece_type)]};
+}
+
+template <typename Function>
+void Board::for_each_piece(Function&& function) const
+{
+    const auto occupied_squares = get_occupied_squares();
+    for (auto it = occupied_squares.begin(); it != occupied_squares.end(); ++it)
+    {
+        const auto square = it.get_square();
+        function(get_piece_code(square), square.to_position());
+    }
+}
@@ -0,0 +1,129 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <type_traits>
+
+/**
+ * @brief fixed capacity lock-free queue for any number of producers and consumers
+ * @note every cell carries a sequence number telling whether it is ready for the next push or
+ *  the next pop, so a push or pop is one compare exchange on the shared position plus one store.
+ *  Capacity is rounded up to a power of two
+ */
+template <typename T>
+class BoundedQueue
+{
+    static_assert(std::is_trivially_copyable_v<T>);
+
+public:
+    explicit BoundedQueue(std::size_t capacity);
+    BoundedQueue(const BoundedQueue&) = delete;
+    BoundedQueue& operator=(const BoundedQueue&) = delete;
+
+    /**
+     * @return false if queue is full
+     */
+    bool try_push(const T& value);
+    /**
+     * @return false if queue is empty
+     */
+    bool try_pop(T& value);
+    std::size_t get_capacity() const;
+
+private:
+    struct Cell
+    {
+        std::atomic<std::size_t> sequence;
+        T value;
+    };
+
+private:
+    std::size_t m_mask;
+    std::unique_ptr<Cell[]> m_cells;
+    alignas(64) std::atomic<std::size_t> m_push_position{0};
+    alignas(64) std::atomic<std::size_t> m_pop_position{0};
+};
+
+template <typename T>
+BoundedQueue<T>::BoundedQueue(std::size_t capacity)
+{
+    std::size_t rounded_capacity = 2;
+    while (rounded_capacity < capacity)
+    {
+        rounded_capacity *= 2;
+    }
+    m_mask = rounded_capacity - 1;
+    m_cells = std::make_unique<Cell[]>(rounded_capacity);
+    for (std::size_t index = 0; index != rounded_capacity; ++index)
+    {
+        m_cells[index].sequence.store(index, std::memory_order_relaxed);
+    }
+}
+
+template <typename T>
+bool BoundedQueue<T>::try_push(const T& value)
+{
+    auto position = m_push_position.load(std::memory_order_relaxed);
+    while (true)
+    {
+        auto& cell = m_cells[position & m_mask];
+        const auto sequence = cell.sequence.load(std::memory_order_acquire);
+        const auto difference
+            = static_cast<std::ptrdiff_t>(sequence) - static_cast<std::ptrdiff_t>(position);
+        if (difference == 0)
+        {
+            if (m_push_position.compare_exchange_weak(position, position + 1,
+                                                      std::memory_order_relaxed))
+            {
+                cell.value = value;
+                cell.sequence.store(position + 1, std::memory_order_release);
+                return true;
+            }
+        }
+        else if (difference < 0)
+        {
+            return false;
+        }
+        else
+        {
+            position = m_push_position.load(std::memory_order_relaxed);
+        }
+    }
+}
+
+template <typename T>
+bool BoundedQueue<T>::try_pop(T& value)
+{
+    auto position = m_pop_position.load(std::memory_order_relaxed);
+    while (true)
+    {
+        auto& cell = m_cells[position & m_mask];
+        const auto sequence = cell.sequence.load(std::memory_order_acquire);
+        const auto difference
+            = static_cast<std::ptrdiff_t>(sequence) - static_cast<std::ptrdiff_t>(position + 1);
+        if (difference == 0)
+        {
+            if (m_pop_position.compare_exchange_weak(position, position + 1,
+                                                     std::memory_order_relaxed))
+            {
+                value = cell.value;
+                cell.sequence.store(position + m_mask + 1, std::memory_order_release);
+                return true;
+            }
+        }
+        else if (difference < 0)
+        {
+            return false;
+        }
+        else
+        {
+            position = m_pop_position.load(std::memory_order_relaxed);
+        }
+    }
+}
+
+template <typename T>
+std::size_t BoundedQueue<T>::get_capacity() const
+{
+    return m_mask + 1;
+}
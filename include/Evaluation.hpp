@@ -0,0 +1,22 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+
+#include "Board.hpp"
+#include "PositionState.hpp"
+
+/**
+ * @brief index into a table of EVALUATION_PIECE_SQUARE_TABLES for piece of color on square
+ * @note tables are written with rank 8 first, black reads them mirrored
+ */
+std::size_t get_piece_square_index(Square square, PieceColor color);
+/**
+ * @brief static score of board in centipawns, positive if white stands better
+ * @note material, piece square tables and bishop pair, see EvaluationParameters.hpp. Linear in
+ *  the parameters so they can be fitted to game results
+ */
+std::int32_t evaluate(const Board& board);
+/**
+ * @brief static score from the point of view of side to move, as negamax search expects it
+ */
+std::int32_t evaluate(const PositionState& position);
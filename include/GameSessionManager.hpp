@@ -0,0 +1,173 @@
+#pragma once
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <optional>
+#include <vector>
+
+#include "Move.hpp"
+#include "GameState.hpp"
+#include "Pgn.hpp"
+#include "PositionState.hpp"
+
+/**
+ * @brief handle of a session, never 0. Ids of closed sessions stay invalid after their slot is
+ *  reused
+ */
+using SessionId = std::uint64_t;
+
+enum class GameEndReason : std::uint8_t
+{
+    NONE,
+    CHECKMATE,
+    STALEMATE,
+    FIFTY_MOVE_RULE,
+    THREEFOLD_REPETITION,
+    INSUFFICIENT_MATERIAL,
+    TIME_FORFEIT,
+    /**
+     * @brief flag fell but opponent has no mating material, game is drawn
+     */
+    TIMEOUT_VS_INSUFFICIENT_MATERIAL,
+    /**
+     * @brief game was adjudicated as draw after too many plies
+     */
+    MOVE_LIMIT
+};
+const char* to_c_str(GameEndReason end_reason);
+
+enum class MoveStatus : std::uint8_t
+{
+    ACCEPTED,
+    UNKNOWN_SESSION,
+    GAME_OVER,
+    ILLEGAL_MOVE,
+    /**
+     * @brief elapsed time used up the clock of side to move, game is lost on time or drawn if
+     *  the opponent can't checkmate
+     */
+    TIME_FORFEIT
+};
+const char* to_c_str(MoveStatus status);
+
+/**
+ * @brief zero initial time means the game is not timed
+ */
+struct TimeControl
+{
+    std::chrono::milliseconds initial_time{0};
+    std::chrono::milliseconds increment{0};
+};
+
+struct SessionClocks
+{
+    std::array<std::chrono::milliseconds, 2> remaining_time{};
+    std::chrono::milliseconds increment{0};
+    bool is_timed{false};
+};
+
+/**
+ * @note result is UNKNOWN while the game is going on
+ */
+struct SessionSnapshot
+{
+    PositionState position;
+    std::uint32_t halfmove_clock{0};
+    std::uint32_t ply_count{0};
+    SessionClocks clocks;
+    GameResult result{GameResult::UNKNOWN};
+    GameEndReason end_reason{GameEndReason::NONE};
+};
+
+constexpr std::size_t DEFAULT_SESSION_SHARD_COUNT = 64;
+
+/**
+ * @brief owns the state of many concurrent games, sessions are addressed by id
+ * @note sessions are spread over shards, each with its own mutex, so games on different shards
+ *  never wait for each other. A shard stores its sessions in slots of parallel arrays: position
+ *  and result, clocks and zobrist keys. Keys are kept only since the last capture or pawn move,
+ *  which is all repetition detection needs and bounded by the fifty move rule, so a session
+ *  never allocates after its slot exists and closed slots are reused
+ */
+class GameSessionManager
+{
+public:
+    explicit GameSessionManager(std::size_t shard_count = DEFAULT_SESSION_SHARD_COUNT);
+    GameSessionManager(const GameSessionManager&) = delete;
+    GameSessionManager& operator=(const GameSessionManager&) = delete;
+
+    /**
+     * @note a game that is already over in position is created with its result set
+     * @warning kings of both colors have to be on board
+     */
+    SessionId create_session(const PositionState& position,
+                             const TimeControl& time_control = {},
+                             std::uint32_t halfmove_clock = 0);
+    /**
+     * @return false if session is unknown
+     */
+    bool close_session(SessionId id);
+
+    /**
+     * @brief validates and plays move of side to move, detects end of game after it
+     * @param elapsed time side to move spent on move, charged to its clock before the increment
+     * @note an illegal move leaves session and clocks untouched
+     */
+    MoveStatus make_move(SessionId id,
+                         const Position& from,
+                         const Position& to,
+                         std::optional<PromotablePieceType> promotion = std::nullopt,
+                         std::chrono::milliseconds elapsed = std::chrono::milliseconds{0});
+    std::optional<SessionSnapshot> get_snapshot(SessionId id) const;
+    /**
+     * @return false if session is unknown, moves are cleared then
+     */
+    bool generate_legal_moves(SessionId id, std::vector<Move>& moves) const;
+    std::size_t get_session_count() const;
+
+private:
+    static constexpr std::uint32_t FIFTY_MOVE_RULE_PLIES = 100;
+
+    struct SessionState
+    {
+        PositionState position;
+        std::uint64_t key{0};
+        std::uint32_t halfmove_clock{0};
+        std::uint32_t ply_count{0};
+        std::uint32_t generation{0};
+        GameResult result{GameResult::UNKNOWN};
+        GameEndReason end_reason{GameEndReason::NONE};
+        bool is_open{false};
+    };
+    /**
+     * @brief keys of positions since last capture or pawn move, current position last
+     */
+    struct KeyHistory
+    {
+        std::array<std::uint64_t, FIFTY_MOVE_RULE_PLIES + 1> keys;
+        std::uint32_t size{0};
+    };
+    struct alignas(64) Shard
+    {
+        mutable std::mutex mutex;
+        std::vector<SessionState> states;
+        std::vector<SessionClocks> clocks;
+        std::vector<KeyHistory> key_histories;
+        std::vector<std::uint32_t> free_slots;
+        std::size_t open_count{0};
+    };
+
+    std::size_t get_shard_index(SessionId id) const;
+    /**
+     * @return empty if id doesn't name an open session of shard, shard mutex has to be held
+     */
+    std::optional<std::size_t> find_slot(const Shard& shard, SessionId id) const;
+    static void update_game_end(SessionState& state, const KeyHistory& key_history);
+
+private:
+    std::vector<Shard> m_shards;
+    std::atomic<std::size_t> m_next_shard{0};
+};
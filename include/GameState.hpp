@@ -0,0 +1,93 @@
+#pragma once
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+#include "Move.hpp"
+#include "PositionState.hpp"
+
+enum class DrawReason : std::uint8_t
+{
+    NONE,
+    FIFTY_MOVE_RULE,
+    THREEFOLD_REPETITION,
+    INSUFFICIENT_MATERIAL
+};
+const char* to_c_str(DrawReason draw_reason);
+
+/**
+ * @brief color could mate by some sequence of legal moves, even with help of the opponent
+ * @note only king, a lone knight against king and queens, or bishops all on one square color
+ *  against no pawns and knights can't mate
+ */
+bool can_checkmate(const Board& board, PieceColor color);
+/**
+ * @brief neither side can mate: bare kings, a single minor piece or same colored bishops only
+ */
+bool is_insufficient_material(const Board& board);
+
+/**
+ * @brief position plus the history needed by draw rules: halfmove clock and stack of zobrist keys
+ * @note key is updated incrementally on every move, board is never rescanned
+ */
+class GameState
+{
+public:
+    explicit GameState(PositionState position, std::uint32_t halfmove_clock = 0);
+    static GameState get_starting_position();
+    /**
+     * @brief reads halfmove clock as well, history before fen position is unknown
+     * @warning throws invalid_argument if fen can not be parsed
+     */
+    static GameState from_fen(std::string_view fen);
+
+    PositionState& get_position();
+    const PositionState& get_position() const;
+    std::uint64_t get_key() const;
+    std::uint32_t get_halfmove_clock() const;
+    std::size_t get_ply_count() const;
+
+    /**
+     * @warning move is presumed to be legal
+     */
+    void make_move(const Move& move);
+    /**
+     * @warning throws logic_error if there is no move to undo
+     */
+    void unmake_move();
+
+    /**
+     * @brief number of earlier occurrences of current position
+     * @note scans back only to the last capture or pawn move, every second ply
+     */
+    std::size_t count_repetitions() const;
+    /**
+     * @brief position occurred at least once before, enough for search to score it as draw
+     */
+    bool is_repetition() const;
+    bool is_threefold_repetition() const;
+    bool is_fifty_move_rule_draw() const;
+    /**
+     * @brief same as is_insufficient_material of the board
+     */
+    bool is_insufficient_material() const;
+    /**
+     * @warning checkmate takes precedence over fifty move rule, check for it before calling this
+     */
+    DrawReason get_draw_reason() const;
+
+private:
+    struct HistoryEntry
+    {
+        Move move;
+        UndoInfo undo_info;
+        std::uint64_t key;
+        std::uint32_t halfmove_clock;
+    };
+
+private:
+    PositionState m_position;
+    std::uint64_t m_key;
+    std::uint32_t m_halfmove_clock;
+    std::vector<HistoryEntry> m_history;
+};
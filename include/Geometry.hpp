@@ -0,0 +1,164 @@
+#pragma once
+#include <array>
+#include <cstdint>
+
+#include "Square.hpp"
+
+/**
+ * @brief ray directions, the first four increase square index
+ */
+enum class Direction : std::uint8_t
+{
+    NORTH,
+    EAST,
+    NORTH_EAST,
+    NORTH_WEST,
+    SOUTH,
+    WEST,
+    SOUTH_WEST,
+    SOUTH_EAST
+};
+constexpr std::size_t DIRECTION_COUNT = 8;
+
+constexpr bool is_increasing(Direction direction)
+{
+    return static_cast<std::uint8_t>(direction) < 4;
+}
+
+using SquareMasks = std::array<std::uint64_t, SQUARE_COUNT>;
+using SquarePairMasks = std::array<SquareMasks, SQUARE_COUNT>;
+
+namespace detail
+{
+struct Step
+{
+    std::int32_t file_step;
+    std::int32_t rank_step;
+};
+
+// same order as Direction
+constexpr std::array<Step, DIRECTION_COUNT> DIRECTION_STEPS = {Step{0, 1},   Step{1, 0},
+                                                               Step{1, 1},   Step{-1, 1},
+                                                               Step{0, -1},  Step{-1, 0},
+                                                               Step{-1, -1}, Step{1, -1}};
+constexpr std::array<Step, 8> KNIGHT_STEPS = {Step{1, 2},   Step{2, 1},   Step{2, -1},
+                                              Step{1, -2},  Step{-1, -2}, Step{-2, -1},
+                                              Step{-2, 1},  Step{-1, 2}};
+constexpr std::array<Step, 2> WHITE_PAWN_STEPS = {Step{-1, 1}, Step{1, 1}};
+constexpr std::array<Step, 2> BLACK_PAWN_STEPS = {Step{-1, -1}, Step{1, -1}};
+
+constexpr bool is_on_board(std::int32_t file, std::int32_t rank)
+{
+    return file >= 0 && file < 8 && rank >= 0 && rank < 8;
+}
+
+constexpr std::uint64_t get_mask(std::int32_t file, std::int32_t rank)
+{
+    return std::uint64_t{1} << (rank * 8 + file);
+}
+
+template <std::size_t step_count>
+constexpr SquareMasks build_step_masks(const std::array<Step, step_count>& steps)
+{
+    SquareMasks masks{};
+    for (std::size_t square = 0; square != SQUARE_COUNT; ++square)
+    {
+        for (const auto& step : steps)
+        {
+            const auto file = static_cast<std::int32_t>(square % 8) + step.file_step;
+            const auto rank = static_cast<std::int32_t>(square / 8) + step.rank_step;
+            if (is_on_board(file, rank))
+            {
+                masks[square] |= get_mask(file, rank);
+            }
+        }
+    }
+    return masks;
+}
+
+constexpr std::array<SquareMasks, DIRECTION_COUNT> build_ray_masks()
+{
+    std::array<SquareMasks, DIRECTION_COUNT> masks{};
+    for (std::size_t direction = 0; direction != DIRECTION_COUNT; ++direction)
+    {
+        const auto& step = DIRECTION_STEPS[direction];
+        for (std::size_t square = 0; square != SQUARE_COUNT; ++square)
+        {
+            auto file = static_cast<std::int32_t>(square % 8) + step.file_step;
+            auto rank = static_cast<std::int32_t>(square / 8) + step.rank_step;
+            for (; is_on_board(file, rank); file += step.file_step, rank += step.rank_step)
+            {
+                masks[direction][square] |= get_mask(file, rank);
+            }
+        }
+    }
+    return masks;
+}
+
+/**
+ * @param include_line false gives squares strictly between, true gives whole line through
+ *  both squares, squares not on a common rank, file or diagonal give empty mask
+ */
+constexpr SquarePairMasks build_square_pair_masks(bool include_line)
+{
+    const auto ray_masks = build_ray_masks();
+    SquarePairMasks masks{};
+    for (std::size_t from = 0; from != SQUARE_COUNT; ++from)
+    {
+        for (std::size_t direction = 0; direction != DIRECTION_COUNT; ++direction)
+        {
+            const auto opposite_direction = (direction + 4) % DIRECTION_COUNT;
+            const auto ray = ray_masks[direction][from];
+            for (std::size_t to = 0; to != SQUARE_COUNT; ++to)
+            {
+                if ((ray & (std::uint64_t{1} << to)) == 0)
+                {
+                    continue;
+                }
+                masks[from][to] = include_line ? ray | ray_masks[opposite_direction][from]
+                                                       | (std::uint64_t{1} << from)
+                                               : ray & ray_masks[opposite_direction][to];
+            }
+        }
+    }
+    return masks;
+}
+}  // namespace detail
+
+/**
+ * @brief attack masks and square relations built at compile time
+ */
+inline constexpr SquareMasks KNIGHT_ATTACK_MASKS = detail::build_step_masks(detail::KNIGHT_STEPS);
+inline constexpr SquareMasks KING_ATTACK_MASKS = detail::build_step_masks(detail::DIRECTION_STEPS);
+inline constexpr std::array<SquareMasks, 2> PAWN_ATTACK_MASKS
+    = {detail::build_step_masks(detail::WHITE_PAWN_STEPS),
+       detail::build_step_masks(detail::BLACK_PAWN_STEPS)};
+/**
+ * @brief squares from square to the edge in direction, square itself excluded
+ */
+inline constexpr std::array<SquareMasks, DIRECTION_COUNT> RAY_MASKS = detail::build_ray_masks();
+inline constexpr SquarePairMasks BETWEEN_MASKS = detail::build_square_pair_masks(false);
+inline constexpr SquarePairMasks LINE_MASKS = detail::build_square_pair_masks(true);
+
+static_assert(KNIGHT_ATTACK_MASKS[0] == ((std::uint64_t{1} << 10) | (std::uint64_t{1} << 17)));
+static_assert(BETWEEN_MASKS[4][7] == ((std::uint64_t{1} << 5) | (std::uint64_t{1} << 6)));
+static_assert(LINE_MASKS[0][9] == 0x8040201008040201);
+
+constexpr SquareSet get_ray(Direction direction, Square square)
+{
+    return SquareSet{RAY_MASKS[static_cast<std::size_t>(direction)][square.get_index()]};
+}
+/**
+ * @brief squares strictly between two squares on a common line, empty otherwise
+ */
+constexpr SquareSet get_between_squares(Square from, Square to)
+{
+    return SquareSet{BETWEEN_MASKS[from.get_index()][to.get_index()]};
+}
+/**
+ * @brief whole rank, file or diagonal through both squares, empty if they don't share one
+ */
+constexpr SquareSet get_line(Square from, Square to)
+{
+    return SquareSet{LINE_MASKS[from.get_index()][to.get_index()]};
+}
@@ -0,0 +1,137 @@
+#pragma once
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#else
+#include <chrono>
+#endif
+
+/**
+ * @brief events counted on the move generation hot path
+ */
+enum class Counter : std::uint8_t
+{
+    RAW_MOVES,
+    LEGALITY_CHECKS,
+    BOARD_COPIES,
+    ATTACK_SET_BUILDS
+};
+constexpr std::size_t COUNTER_COUNT = 4;
+const char* to_c_str(Counter counter);
+
+/**
+ * @brief timed sections, phases nest: NORMAL_MOVES and SPECIAL_MOVES are part of GENERATE_MOVES
+ */
+enum class Phase : std::uint8_t
+{
+    GENERATE_MOVES,
+    NORMAL_MOVES,
+    SPECIAL_MOVES,
+    ATTACK_SETS
+};
+constexpr std::size_t PHASE_COUNT = 4;
+const char* to_c_str(Phase phase);
+
+/**
+ * @brief statistics of the calling thread since start or last reset
+ * @note cycles are time stamp counter ticks on x86, nanoseconds elsewhere. Allocations are counted
+ *  by the replaced global operator new, over-aligned ones included, phase allocations are the
+ *  ones made while phase ran
+ */
+struct InstrumentationStats
+{
+    std::array<std::uint64_t, COUNTER_COUNT> counters{};
+    std::array<std::uint64_t, PHASE_COUNT> phase_calls{};
+    std::array<std::uint64_t, PHASE_COUNT> phase_cycles{};
+    std::array<std::uint64_t, PHASE_COUNT> phase_allocations{};
+    std::uint64_t allocations{0};
+    std::uint64_t allocated_bytes{0};
+};
+
+/**
+ * @brief true if built with CHESS_ENABLE_INSTRUMENTATION, otherwise all stats stay zero
+ */
+constexpr bool is_instrumentation_enabled()
+{
+#ifdef CHESS_ENABLE_INSTRUMENTATION
+    return true;
+#else
+    return false;
+#endif
+}
+
+const InstrumentationStats& get_thread_instrumentation_stats();
+void reset_thread_instrumentation_stats();
+/**
+ * @brief counters, phases with per call averages and allocations as one JSON object
+ */
+std::string to_json(const InstrumentationStats& stats);
+
+namespace detail
+{
+extern thread_local InstrumentationStats thread_instrumentation_stats;
+
+inline std::uint64_t read_cycle_counter()
+{
+#if defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#else
+    return static_cast<std::uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch())
+            .count());
+#endif
+}
+}  // namespace detail
+
+inline void add_to_counter(Counter counter, std::uint64_t value = 1)
+{
+    detail::thread_instrumentation_stats.counters[static_cast<std::size_t>(counter)] += value;
+}
+
+/**
+ * @brief adds cycles and allocations between construction and destruction to phase
+ */
+class ScopedPhaseTimer
+{
+public:
+    explicit ScopedPhaseTimer(Phase phase)
+        : m_phase{static_cast<std::size_t>(phase)}
+        , m_start_allocations{detail::thread_instrumentation_stats.allocations}
+        , m_start_cycles{detail::read_cycle_counter()}
+    {
+    }
+    ~ScopedPhaseTimer()
+    {
+        auto& stats = detail::thread_instrumentation_stats;
+        stats.phase_cycles[m_phase] += detail::read_cycle_counter() - m_start_cycles;
+        stats.phase_allocations[m_phase] += stats.allocations - m_start_allocations;
+        ++stats.phase_calls[m_phase];
+    }
+    ScopedPhaseTimer(const ScopedPhaseTimer&) = delete;
+    ScopedPhaseTimer& operator=(const ScopedPhaseTimer&) = delete;
+
+private:
+    std::size_t m_phase;
+    std::uint64_t m_start_allocations;
+    std::uint64_t m_start_cycles;
+};
+
+/**
+ * @note both macros expand to nothing without CHESS_ENABLE_INSTRUMENTATION, arguments are not
+ *  evaluated then
+ */
+#ifdef CHESS_ENABLE_INSTRUMENTATION
+#define CHESS_CONCAT_IMPL(lhs, rhs) lhs##rhs
+#define CHESS_CONCAT(lhs, rhs) CHESS_CONCAT_IMPL(lhs, rhs)
+#define CHESS_COUNT(counter, value) add_to_counter(Counter::counter, value)
+#define CHESS_TIME_PHASE(phase) \
+    const ScopedPhaseTimer CHESS_CONCAT(phase_timer_, __LINE__) { Phase::phase }
+#else
+#define CHESS_COUNT(counter, value) static_cast<void>(0)
+#define CHESS_TIME_PHASE(phase) static_cast<void>(0)
+#endif
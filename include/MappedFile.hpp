@@ -0,0 +1,32 @@
+#pragma once
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+/**
+ * @brief read only memory mapping of a whole file, pages are loaded lazily by the os
+ */
+class MappedFile
+{
+public:
+    /**
+     * @warning throws runtime_error if file can not be opened or mapped
+     */
+    explicit MappedFile(const std::string& path);
+    MappedFile(MappedFile&& other) noexcept;
+    MappedFile& operator=(MappedFile&& other) noexcept;
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+    ~MappedFile();
+
+    const std::byte* get_data() const;
+    std::size_t get_size() const;
+    std::string_view get_view() const;
+
+private:
+    void unmap();
+
+private:
+    void* m_data{nullptr};
+    std::size_t m_size{0};
+};
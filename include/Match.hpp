@@ -0,0 +1,160 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <istream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "GameSessionManager.hpp"
+#include "Search.hpp"
+
+/**
+ * @brief engines of a match are the in-process search run with different limits
+ */
+struct EngineConfig
+{
+    std::string name;
+    SearchLimits limits;
+};
+
+struct PlayedGame
+{
+    GameResult result{GameResult::UNKNOWN};
+    GameEndReason end_reason{GameEndReason::NONE};
+    std::uint32_t ply_count{0};
+};
+
+/**
+ * @brief called with game before the searched move is played on it
+ */
+using SearchedMoveCallback = std::function<void(const GameState& game, const SearchResult& result)>;
+
+/**
+ * @brief plays game to its end, every move is searched from scratch with limits of side to move
+ * @note game is drawn by MOVE_LIMIT after max_plies, result is UNKNOWN if stop was requested
+ */
+PlayedGame play_game(GameState game,
+                     const SearchLimits& white_limits,
+                     const SearchLimits& black_limits,
+                     std::uint32_t max_plies,
+                     const std::atomic<bool>& stop_requested,
+                     const SearchedMoveCallback& on_move_searched = {});
+
+/**
+ * @brief plays ply_count uniformly random legal moves so games starting from game differ
+ * @return false if game ended during the random plies
+ */
+bool play_random_plies(GameState& game, std::uint32_t ply_count, std::mt19937& random);
+
+/**
+ * @brief results of the first engine of a match
+ */
+struct MatchScore
+{
+    std::uint64_t wins{0};
+    std::uint64_t draws{0};
+    std::uint64_t losses{0};
+
+    std::uint64_t get_game_count() const;
+    /**
+     * @brief points per game, 0.5 if no game was played
+     */
+    double get_score() const;
+};
+
+/**
+ * @brief elo difference of first engine with 95% confidence margin, infinite for a perfect score
+ */
+struct EloEstimate
+{
+    double elo{0.0};
+    double error_margin{0.0};
+};
+EloEstimate estimate_elo(const MatchScore& score);
+
+enum class SprtDecision : std::uint8_t
+{
+    CONTINUE,
+    /**
+     * @brief first engine is not better than elo0
+     */
+    ACCEPT_H0,
+    /**
+     * @brief first engine is at least elo1 better
+     */
+    ACCEPT_H1
+};
+const char* to_c_str(SprtDecision decision);
+
+struct SprtParameters
+{
+    double elo0{0.0};
+    double elo1{5.0};
+    double alpha{0.05};
+    double beta{0.05};
+};
+
+/**
+ * @brief log likelihood ratio of elo1 against elo0
+ * @note normal approximation of the trinomial game results, as used by fishtest
+ */
+double get_sprt_llr(const MatchScore& score, const SprtParameters& parameters);
+double get_sprt_lower_bound(const SprtParameters& parameters);
+double get_sprt_upper_bound(const SprtParameters& parameters);
+SprtDecision get_sprt_decision(const MatchScore& score, const SprtParameters& parameters);
+
+struct MatchConfig
+{
+    EngineConfig first;
+    EngineConfig second;
+    std::size_t game_count{2};
+    std::size_t thread_count{1};
+    std::uint32_t max_plies{400};
+    /**
+     * @brief plies played at random after the opening, both games of a pair get the same ones
+     * @note the random line of a pair depends only on seed and pair index so matches are
+     *  reproducible, a line in which the game ends is replaced by another one
+     */
+    std::uint32_t random_plies{0};
+    std::uint32_t seed{0};
+};
+
+struct MatchGame
+{
+    std::size_t game_index{0};
+    std::size_t opening_index{0};
+    bool first_plays_white{true};
+    /**
+     * @brief key of the position the game started from, after the random plies
+     */
+    std::uint64_t start_key{0};
+    PlayedGame game;
+};
+/**
+ * @return false to stop the match, games still running are abandoned and not reported
+ */
+using MatchGameCallback = std::function<bool(const MatchGame& game, const MatchScore& score)>;
+
+/**
+ * @brief plays game_count games on thread_count threads, one game per thread at a time
+ * @note game 2i and 2i + 1 start from the same opening with colors swapped, openings are reused
+ *  from the start when there are not enough of them. on_game_finished is called with the score
+ *  including the finished game, calls are serialized
+ * @warning the search is deterministic, pairs starting from the same position repeat the same
+ *  games unless random_plies makes their start positions differ
+ * @warning throws invalid_argument if there is no opening or an opening can not be parsed
+ */
+MatchScore run_match(const std::vector<std::string>& opening_fens,
+                     const MatchConfig& config,
+                     const MatchGameCallback& on_game_finished = {});
+
+/**
+ * @brief one opening per line as FEN or EPD, EPD operations are dropped
+ * @note empty lines and lines starting with # are skipped, counters missing in EPD are set to
+ *  "0 1"
+ * @warning throws invalid_argument if a line has fewer than 4 fields
+ */
+std::vector<std::string> read_openings(std::istream& input);
@@ -0,0 +1,35 @@
+#pragma once
+#include <optional>
+
+#include "Pieces.hpp"
+
+enum class MoveType : std::uint8_t
+{
+    NORMAL,
+    EN_PASSANT,
+    KING_SIDE_CASTLE,
+    QUEEN_SIDE_CASTLE
+};
+
+/**
+ * @note castling moves are stored as king moves: from is the king position, to is the square
+ *  the king lands on
+ */
+struct Move
+{
+    Position from;
+    Position to;
+    MoveType type{MoveType::NORMAL};
+    std::optional<PromotablePieceType> promotion;
+};
+
+inline bool operator==(const Move& lhs, const Move& rhs)
+{
+    return lhs.from == rhs.from && lhs.to == rhs.to && lhs.type == rhs.type
+           && lhs.promotion == rhs.promotion;
+}
+
+inline bool operator!=(const Move& lhs, const Move& rhs)
+{
+    return !(lhs == rhs);
+}
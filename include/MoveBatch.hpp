@@ -0,0 +1,100 @@
+#pragma once
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "Move.hpp"
+#include "PositionState.hpp"
+
+/**
+ * @brief legal moves of many positions stored back to back in one arena
+ * @note moves of position i are get_moves()[get_offset(i)] .. get_moves()[get_offset(i + 1)],
+ *  clear keeps the capacity so a batch reused for the next request doesn't allocate
+ */
+class MoveBatch
+{
+public:
+    MoveBatch();
+
+    void clear();
+    void reserve(std::size_t position_count, std::size_t move_count);
+    void add_position(const std::vector<Move>& moves);
+    /**
+     * @brief appends positions of other batch after positions of this batch
+     */
+    void append(const MoveBatch& other);
+
+    std::size_t get_position_count() const;
+    std::size_t get_offset(std::size_t position_index) const;
+    std::size_t get_move_count(std::size_t position_index) const;
+    const Move* get_moves_begin(std::size_t position_index) const;
+    const Move* get_moves_end(std::size_t position_index) const;
+    const std::vector<Move>& get_moves() const;
+
+private:
+    std::vector<Move> m_moves;
+    std::vector<std::size_t> m_offsets;
+};
+
+/**
+ * @brief generates legal moves of every position into batch on the calling thread, batch is
+ *  cleared first
+ * @note moves are in the order generate_legal_moves gives them, positions are copied into one
+ *  scratch position
+ */
+void generate_available_moves_batch(const PositionState* positions,
+                                    std::size_t position_count,
+                                    MoveBatch& batch);
+constexpr std::size_t MIN_BATCH_POSITIONS_PER_THREAD = 64;
+
+/**
+ * @brief generates batches split into chunks on a pool of threads kept for its whole lifetime
+ * @note the calling thread generates the first chunk straight into the output batch, the
+ *  thread_count - 1 workers generate the others into arenas of their own that are appended
+ *  afterwards. Threads, arenas and scratch positions and move lists are reused by every call, so
+ *  once arenas grew to the largest chunk nothing is created or allocated per call. Batches with
+ *  fewer than MIN_BATCH_POSITIONS_PER_THREAD positions per thread are split into fewer chunks
+ */
+class MoveBatchGenerator
+{
+public:
+    explicit MoveBatchGenerator(std::size_t thread_count);
+    ~MoveBatchGenerator();
+    MoveBatchGenerator(const MoveBatchGenerator&) = delete;
+    MoveBatchGenerator& operator=(const MoveBatchGenerator&) = delete;
+
+    std::size_t get_thread_count() const;
+    /**
+     * @brief same result as generate_available_moves_batch, batch is cleared first
+     * @warning not reentrant, one call at a time
+     */
+    void generate(const PositionState* positions, std::size_t position_count, MoveBatch& batch);
+
+private:
+    struct ChunkScratch
+    {
+        MoveBatch batch;
+        PositionState position;
+        std::vector<Move> moves;
+    };
+
+    void run_worker(std::size_t chunk_index);
+    void generate_chunk(std::size_t chunk_index, MoveBatch& batch);
+
+private:
+    std::vector<ChunkScratch> m_scratches;
+    std::mutex m_mutex;
+    std::condition_variable m_start_condition;
+    std::condition_variable m_done_condition;
+    std::uint64_t m_generation{0};
+    std::size_t m_pending_chunk_count{0};
+    bool m_shutdown{false};
+    const PositionState* m_positions{nullptr};
+    std::size_t m_position_count{0};
+    std::size_t m_chunk_count{0};
+    std::size_t m_chunk_size{0};
+    std::vector<std::thread> m_workers;
+};
@@ -1,26 +1,126 @@
 #pragma once
 
+#include <array>
+#include <cstddef>
+#include <cstdint>
 #include <optional>
-#include <unordered_map>
-#include <unordered_set>
+#include <utility>
 
 #include "Pieces.hpp"
+#include "Square.hpp"
 
 class Board;
 
+/**
+ * @brief first inconsistency found between special moves data and board
+ */
+enum class SpecialMovesError : std::uint8_t
+{
+    NONE,
+    KING_MISSING,
+    /**
+     * @brief king that didn't move is not on its starting square
+     */
+    KING_MISPLACED,
+    EN_PASSANT_SQUARE_INVALID,
+    /**
+     * @brief no opposite pawn behind en passant square
+     */
+    EN_PASSANT_PAWN_MISSING,
+    /**
+     * @brief no own rook on castling rook square
+     */
+    ROOK_MISSING,
+    ROOK_MISPLACED
+};
+const char* to_c_str(SpecialMovesError error);
+
+/**
+ * @note king position is taken from the board
+ */
 struct SpecialMovesData
 {
-    Position king_position;
     bool king_moved{false};
     std::optional<Position> en_passant_takable;
     std::optional<Position> queen_side_rook;
     std::optional<Position> king_side_rook;
 
 public:
+    /**
+     * @brief checks king, en passant and castling rooks against board in that order
+     * @note reads only the piece masks of the board, doesn't throw, allocate or print, so it is
+     *  cheap enough to run on every move generation, also for data sent by clients
+     */
+    SpecialMovesError validate(const Board& board,
+                               PieceColor side_to_move,
+                               bool fisher_random = false) const noexcept;
     bool is_ok(const Board& board, PieceColor side_to_move, bool fisher_random = false) const;
 };
-using SquaresUnderAttack = std::unordered_set<Position>;
-using NormalMoves = std::unordered_map<Position, std::unordered_set<Position>>;
+using SquaresUnderAttack = SquareSet;
+
+/**
+ * @brief destination squares of every piece stored in dense array indexed by origin square
+ * @note pieces without moves are skipped by iteration, iteration yields (origin, destinations)
+ *  pairs in square index order like unordered_map<Position, unordered_set<Position>> did in
+ *  unspecified order
+ */
+class NormalMoves
+{
+public:
+    using value_type = std::pair<Position, SquareSet>;
+    class const_iterator
+    {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = NormalMoves::value_type;
+        using difference_type = std::ptrdiff_t;
+        using pointer = void;
+        using reference = value_type;
+
+        const_iterator(const NormalMoves& moves, std::size_t index);
+        value_type operator*() const;
+        const_iterator& operator++();
+        bool operator==(const const_iterator& other) const;
+        bool operator!=(const const_iterator& other) const;
+
+    private:
+        void skip_empty();
+
+    private:
+        const NormalMoves* m_moves;
+        std::size_t m_index;
+    };
+    using iterator = const_iterator;
+
+public:
+    NormalMoves() = default;
+    /**
+     * @warning positions have to be valid
+     */
+    NormalMoves(std::initializer_list<value_type> moves);
+
+    /**
+     * @warning position has to be valid
+     */
+    SquareSet& operator[](const Position& origin);
+    /**
+     * @warning throws out_of_range if piece at origin has no moves
+     */
+    const SquareSet& at(const Position& origin) const;
+    std::size_t count(const Position& origin) const;
+    std::size_t size() const;
+    bool empty() const;
+
+    const_iterator begin() const;
+    const_iterator end() const;
+
+    bool operator==(const NormalMoves& other) const;
+    bool operator!=(const NormalMoves& other) const;
+
+private:
+    std::array<SquareSet, SQUARE_COUNT> m_destinations{};
+};
+
 struct AvailableMoves
 {
     NormalMoves normal_moves;
@@ -40,4 +140,31 @@ NormalMoves generate_normal_raw_moves(Board& board,
 
 AvailableMoves generate_available_moves(Board& board,
                                         const SpecialMovesData& special_move_data,
-                                        PieceColor side_to_move);
\ No newline at end of file
+                                        PieceColor side_to_move);
+
+/**
+ * @brief checks one move without generating the others, agrees with generate_available_moves
+ * @note castling is given as king move to its target square, promotion has to be given exactly
+ *  when pawn reaches last rank
+ */
+bool is_move_legal(const Board& board,
+                   const SpecialMovesData& special_move_data,
+                   PieceColor side_to_move,
+                   const Position& from,
+                   const Position& to,
+                   std::optional<PromotablePieceType> promotion = std::nullopt);
+
+/**
+ * @brief number of moves generate_legal_moves of PositionState gives, promotions counted apart
+ * @note targets of every piece are masked with check and pin masks and popcounted, no move is
+ *  materialized
+ */
+std::size_t count_legal_moves(const Board& board,
+                              const SpecialMovesData& special_move_data,
+                              PieceColor side_to_move);
+/**
+ * @brief stops at the first piece with a legal target, enough for checkmate and stalemate
+ */
+bool has_any_legal_move(const Board& board,
+                        const SpecialMovesData& special_move_data,
+                        PieceColor side_to_move);
\ No newline at end of file
@@ -0,0 +1,57 @@
+#pragma once
+#include <array>
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+#include "Move.hpp"
+#include "PositionState.hpp"
+
+enum class CheckState : std::uint8_t
+{
+    NONE,
+    CHECK,
+    CHECKMATE
+};
+
+/**
+ * @brief fixed capacity text of a single move, never allocates
+ */
+class MoveNotation
+{
+public:
+    static constexpr std::size_t MAX_SIZE = 16;
+
+    void append(char notation_char);
+    void append(const Position& position);
+    void append(CheckState check_state);
+    std::string_view get_view() const;
+
+private:
+    std::array<char, MAX_SIZE> m_chars;
+    std::uint8_t m_size{0};
+};
+
+/**
+ * @param legal_moves legal moves of position, used for disambiguation
+ * @note check_state describes position after move, it is known to callers which generate legal
+ *  moves for that position anyway
+ */
+MoveNotation to_san(const PositionState& position,
+                    const std::vector<Move>& legal_moves,
+                    const Move& move,
+                    CheckState check_state = CheckState::NONE);
+/**
+ * @brief long algebraic notation: Ng1-f3, e7xd8=Q, O-O
+ */
+MoveNotation to_lan(const PositionState& position,
+                    const Move& move,
+                    CheckState check_state = CheckState::NONE);
+/**
+ * @brief coordinate notation of engine protocols: e2e4, e7e8q, castling as king move e1g1
+ */
+MoveNotation to_uci(const Move& move);
+/**
+ * @param legal_moves legal moves of position
+ */
+CheckState get_check_state(PositionState& position, const std::vector<Move>& legal_moves);
@@ -0,0 +1,187 @@
+#pragma once
+#include <cstdint>
+#include <optional>
+#include <ostream>
+#include <string_view>
+#include <vector>
+
+#include "Move.hpp"
+#include "PositionState.hpp"
+
+enum class GameResult : std::uint8_t
+{
+    WHITE_WON,
+    BLACK_WON,
+    DRAW,
+    UNKNOWN
+};
+const char* to_c_str(GameResult result);
+
+enum class PgnTokenType : std::uint8_t
+{
+    SYMBOL,
+    STRING,
+    PERIOD,
+    ASTERISK,
+    LEFT_BRACKET,
+    RIGHT_BRACKET,
+    LEFT_PARENTHESIS,
+    RIGHT_PARENTHESIS,
+    NAG,
+    COMMENT,
+    END_OF_INPUT
+};
+
+struct PgnToken
+{
+    PgnTokenType type;
+    /**
+     * @note points into tokenized input, strings and comments are stored without delimiters
+     */
+    std::string_view text;
+};
+
+/**
+ * @brief incremental tokenizer over in memory (usually memory mapped) pgn text
+ * @note does not allocate, tokens are views into the input
+ */
+class PgnTokenizer
+{
+public:
+    explicit PgnTokenizer(std::string_view input);
+    PgnToken next_token();
+    PgnToken peek_token();
+    std::size_t get_offset() const;
+
+private:
+    void skip_whitespace_and_escapes();
+    std::string_view read_until(char delimiter);
+
+private:
+    std::string_view m_input;
+    std::size_t m_offset{0};
+};
+
+class PgnVisitor
+{
+public:
+    virtual void begin_game()
+    {
+    }
+    virtual void visit_tag(std::string_view name, std::string_view value)
+    {
+    }
+    /**
+     * @param position position before move is played
+     */
+    virtual void visit_move(const PositionState& position, const Move& move)
+    {
+    }
+    virtual void end_game(GameResult result)
+    {
+    }
+    /**
+     * @brief called instead of end_game when game can't be replayed
+     */
+    virtual void invalid_game(std::string_view reason)
+    {
+    }
+    virtual ~PgnVisitor() = default;
+};
+
+struct PgnParseStats
+{
+    std::size_t games{0};
+    std::size_t invalid_games{0};
+    std::size_t moves{0};
+};
+PgnParseStats& operator+=(PgnParseStats& lhs, const PgnParseStats& rhs);
+
+/**
+ * @brief replays every game of pgn input reporting tags and moves to visitor
+ * @note one position is reused for all games, moves are undone with unmake_move after each game
+ */
+class PgnReader
+{
+public:
+    explicit PgnReader(PgnVisitor& visitor);
+    PgnParseStats parse(std::string_view pgn);
+
+private:
+    void parse_game(PgnTokenizer& tokenizer);
+    void parse_tag(PgnTokenizer& tokenizer, std::string_view& invalid_reason);
+    bool play_san_move(std::string_view san);
+    void reset_position();
+
+private:
+    PgnVisitor& m_visitor;
+    PositionState m_position;
+    bool m_position_is_starting{true};
+    std::vector<std::pair<Move, UndoInfo>> m_played_moves;
+    PgnParseStats m_stats;
+};
+
+struct PgnTag
+{
+    std::string_view name;
+    std::string_view value;
+};
+
+/**
+ * @brief formats whole games into an internal buffer which is written to output when full
+ * @note legal moves are generated once per position: list of the position after a move gives
+ *  both disambiguation of the next move and check/mate suffix of the current one
+ */
+class PgnWriter
+{
+public:
+    explicit PgnWriter(std::ostream& output, std::size_t buffer_size = 1 << 16);
+    PgnWriter(const PgnWriter&) = delete;
+    PgnWriter& operator=(const PgnWriter&) = delete;
+    ~PgnWriter();
+
+    /**
+     * @param position position moves are played from, it is restored before returning
+     * @note move numbers start at the fullmove number of the FEN tag, so a game from a set-up
+     *  position should pass the FEN of position as tag
+     */
+    void write_game(const std::vector<PgnTag>& tags,
+                    PositionState& position,
+                    const std::vector<Move>& moves,
+                    GameResult result);
+    void flush();
+
+private:
+    void append(std::string_view text);
+    void append_movetext_token(std::string_view token);
+    void append_move(std::size_t move_number,
+                     bool with_move_number,
+                     bool black_to_move,
+                     std::string_view san);
+
+private:
+    std::ostream& m_output;
+    std::vector<char> m_buffer;
+    std::size_t m_line_length{0};
+    std::vector<Move> m_legal_moves;
+    std::vector<Move> m_next_legal_moves;
+    std::vector<UndoInfo> m_undo_infos;
+};
+
+/**
+ * @brief finds move described by san among available moves of position
+ * @return nullopt if san is malformed, illegal or ambiguous
+ */
+std::optional<Move> resolve_san_move(const PositionState& position,
+                                     const AvailableMoves& available_moves,
+                                     std::string_view san);
+
+/**
+ * @brief splits pgn into at most chunk_count parts, every part starts at the beginning of a game
+ */
+std::vector<std::string_view> split_pgn_games(std::string_view pgn, std::size_t chunk_count);
+
+/**
+ * @brief parses pgn on visitors.size() threads, every thread reports only to its own visitor
+ */
+PgnParseStats parse_pgn_parallel(std::string_view pgn, const std::vector<PgnVisitor*>& visitors);
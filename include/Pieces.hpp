@@ -3,6 +3,9 @@
 #include <functional>
 #include <iostream>
 #include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
 
 class PieceVisitor;
 class Piece;
@@ -23,6 +26,11 @@ enum class PieceType : std::uint8_t
     PAWN
 };
 const char* to_c_str(PieceType piece_type);
+/**
+ * @brief maps upper case piece letter used by FEN and SAN (K, Q, B, N, R, P) to piece type
+ */
+std::optional<PieceType> piece_type_from_char(char piece_char);
+char to_char(PieceType piece_type);
 
 enum class PromotablePieceType : std::uint8_t
 {
@@ -40,6 +48,60 @@ enum class PieceColor : std::uint8_t
 };
 const char* to_c_str(PieceColor color);
 PieceColor get_opposite_color(PieceColor color);
+inline std::size_t to_index(PieceColor color)
+{
+    return static_cast<std::size_t>(color);
+}
+
+/**
+ * @brief piece type and color packed into one byte, value 0 is an empty square
+ * @note bits 0-2 hold type + 1, bit 3 holds color
+ */
+class PieceCode
+{
+public:
+    constexpr PieceCode() = default;
+    constexpr PieceCode(PieceType piece_type, PieceColor piece_color)
+        : m_value{static_cast<std::uint8_t>((static_cast<std::uint8_t>(piece_color) << 3)
+                                            | (static_cast<std::uint8_t>(piece_type) + 1))}
+    {
+    }
+
+    constexpr bool is_empty() const
+    {
+        return m_value == 0;
+    }
+    /**
+     * @warning meaningless for empty code
+     */
+    constexpr PieceType get_type() const
+    {
+        return static_cast<PieceType>((m_value & 7) - 1);
+    }
+    /**
+     * @warning meaningless for empty code
+     */
+    constexpr PieceColor get_color() const
+    {
+        return static_cast<PieceColor>(m_value >> 3);
+    }
+    constexpr std::uint8_t get_value() const
+    {
+        return m_value;
+    }
+
+    friend constexpr bool operator==(PieceCode lhs, PieceCode rhs)
+    {
+        return lhs.m_value == rhs.m_value;
+    }
+    friend constexpr bool operator!=(PieceCode lhs, PieceCode rhs)
+    {
+        return lhs.m_value != rhs.m_value;
+    }
+
+private:
+    std::uint8_t m_value{0};
+};
 
 struct Position
 {
@@ -48,6 +110,12 @@ struct Position
     Position(std::int32_t x, std::int32_t y);
 };
 
+/**
+ * @brief converts algebraic square name ("e4") to position
+ */
+std::optional<Position> position_from_string(std::string_view square_name);
+std::string to_string(const Position& position);
+
 inline std::ostream& operator<<(std::ostream& os, const Position& position)
 {
     os << "{" << position.x << "," << position.y << "}";
@@ -77,6 +145,7 @@ public:
     PieceColor get_color() const;
     const Position& get_position() const;
     void set_position(const Position& new_position);
+    PieceCode get_code() const;
 
     virtual PieceType get_type() const = 0;
     virtual void visit(PieceVisitor& visitor) = 0;
@@ -206,6 +275,11 @@ inline const Position& Piece::get_position() const
     return m_position;
 }
 
+inline PieceCode Piece::get_code() const
+{
+    return {get_type(), m_piece_color};
+}
+
 
 inline void Piece::set_position(const Position& new_position)
 {
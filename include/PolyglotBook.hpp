@@ -0,0 +1,54 @@
+#pragma once
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "MappedFile.hpp"
+#include "Move.hpp"
+#include "PositionState.hpp"
+
+struct BookMove
+{
+    Move move;
+    std::uint16_t weight;
+};
+
+/**
+ * @brief Polyglot .bin opening book, the file is memory mapped and never loaded into memory
+ * @note entries are 16 byte big endian records sorted by key, lookup is a binary search over
+ *  the mapping so only touched pages are read from disk
+ */
+class PolyglotBook
+{
+public:
+    /**
+     * @warning throws runtime_error if file can't be mapped or is not a polyglot book
+     */
+    explicit PolyglotBook(const std::string& path);
+    /**
+     * @brief returns book opened by another caller of this process if it is still in use
+     * @note book is immutable so one instance is safely shared by all threads
+     */
+    static std::shared_ptr<const PolyglotBook> open_shared(const std::string& path);
+
+    /**
+     * @warning moves are decoded as stored, they are not checked for legality
+     */
+    void get_moves(const PositionState& position, std::vector<BookMove>& moves) const;
+    /**
+     * @brief picks book move with probability proportional to its weight
+     */
+    std::optional<Move> choose_move(const PositionState& position,
+                                    std::mt19937_64& random_generator) const;
+    std::size_t get_entry_count() const;
+
+private:
+    std::uint64_t get_entry_key(std::size_t index) const;
+    BookMove get_entry_move(std::size_t index, const PositionState& position) const;
+
+private:
+    MappedFile m_file;
+};
@@ -0,0 +1,102 @@
+#pragma once
+#include <array>
+#include <optional>
+#include <string_view>
+#include <vector>
+
+#include "Board.hpp"
+#include "Move.hpp"
+#include "MoveGenerator.hpp"
+
+struct CastlingRights
+{
+    std::optional<Position> queen_side_rook;
+    std::optional<Position> king_side_rook;
+};
+
+/**
+ * @brief everything make_move destroys and unmake_move needs to restore
+ */
+struct UndoInfo
+{
+    std::optional<PieceType> captured_piece;
+    std::optional<Position> en_passant_takable;
+    std::array<CastlingRights, 2> castling_rights;
+};
+
+/**
+ * @brief board plus the state of both sides needed to keep playing moves on it
+ */
+class PositionState
+{
+public:
+    /**
+     * @brief empty board, white to move, no castling rights
+     */
+    PositionState();
+    static PositionState get_starting_position();
+    /**
+     * @warning throws invalid_argument if fen can not be parsed
+     */
+    static PositionState from_fen(std::string_view fen);
+    PositionState clone() const;
+
+    Board& get_board();
+    const Board& get_board() const;
+    PieceColor get_side_to_move() const;
+    /**
+     * @warning king of color has to be on board
+     */
+    Position get_king_position(PieceColor color) const;
+    const CastlingRights& get_castling_rights(PieceColor color) const;
+    const std::optional<Position>& get_en_passant_takable() const;
+
+    /**
+     * @brief data for side to move in the form expected by the move generator
+     */
+    SpecialMovesData get_special_moves_data() const;
+    bool is_in_check() const;
+    AvailableMoves generate_available_moves();
+    /**
+     * @brief flattens available moves into a list of moves, promotions are expanded
+     */
+    void generate_legal_moves(std::vector<Move>& moves);
+    /**
+     * @brief checks single move given by coordinates without generating all moves
+     * @note castling is given as king move to its target square
+     */
+    bool is_move_legal(const Position& from,
+                       const Position& to,
+                       std::optional<PromotablePieceType> promotion = std::nullopt) const;
+    /**
+     * @brief same as size of generate_legal_moves, computed without listing moves
+     */
+    std::size_t count_legal_moves() const;
+    /**
+     * @note together with is_in_check tells checkmate and stalemate apart
+     */
+    bool has_any_legal_move() const;
+    /**
+     * @brief builds move with correct type from coordinates
+     * @warning presumes there is a piece of side to move at from
+     */
+    Move create_move(const Position& from,
+                     const Position& to,
+                     std::optional<PromotablePieceType> promotion = std::nullopt) const;
+
+    /**
+     * @warning move is presumed to be legal
+     */
+    UndoInfo make_move(const Move& move);
+    void unmake_move(const Move& move, const UndoInfo& undo_info);
+
+private:
+    void move_piece(const Position& from, const Position& to);
+    void update_castling_rights(const Position& square);
+
+private:
+    Board m_board;
+    PieceColor m_side_to_move{PieceColor::WHITE};
+    std::array<CastlingRights, 2> m_castling_rights;
+    std::optional<Position> m_en_passant_takable;
+};
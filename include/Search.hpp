@@ -0,0 +1,55 @@
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <optional>
+#include <vector>
+
+#include "GameState.hpp"
+#include "Move.hpp"
+
+constexpr std::int32_t MATE_SCORE = 32000;
+constexpr std::uint32_t MAX_SEARCH_DEPTH = 64;
+
+/**
+ * @brief search ends at whichever limit is reached first, zero nodes means no node limit
+ */
+struct SearchLimits
+{
+    std::uint32_t max_depth{MAX_SEARCH_DEPTH};
+    std::optional<std::chrono::milliseconds> move_time;
+    std::uint64_t max_nodes{0};
+};
+
+/**
+ * @brief result of last fully searched depth, score is from the point of view of side to move
+ * @note best move is empty only if side to move has no legal move
+ */
+struct SearchResult
+{
+    std::optional<Move> best_move;
+    std::int32_t score{0};
+    std::uint32_t depth{0};
+    std::uint64_t nodes{0};
+    std::vector<Move> principal_variation;
+};
+
+/**
+ * @brief called after every completed iteration of iterative deepening
+ */
+using SearchProgressCallback = std::function<void(const SearchResult&)>;
+
+/**
+ * @brief iterative deepening alpha-beta search with quiescence search on captures
+ * @note game history is used to score repetitions as draws. stop_requested is polled during
+ *  search, after it is set the result of the last completed depth is returned
+ */
+SearchResult search(GameState game,
+                    const SearchLimits& limits,
+                    const std::atomic<bool>& stop_requested,
+                    const SearchProgressCallback& on_depth_completed = {});
+/**
+ * @brief score of a forced mate, distance to mate is MATE_SCORE - abs(score) plies
+ */
+bool is_mate_score(std::int32_t score);
@@ -0,0 +1,52 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#include "Search.hpp"
+
+struct SelfPlayConfig
+{
+    std::size_t thread_count{1};
+    /**
+     * @brief zero plays until stop is requested
+     */
+    std::size_t game_count{0};
+    SearchLimits limits{4};
+    /**
+     * @brief plies played at random from the starting position so games differ
+     * @note an opening in which the game ends is replaced by another one
+     */
+    std::uint32_t random_plies{8};
+    /**
+     * @brief positions before this ply are never sampled
+     */
+    std::uint32_t min_sample_ply{16};
+    std::uint32_t max_plies{400};
+    std::string output_prefix{"selfplay"};
+    std::size_t max_file_size{std::size_t{64} << 20};
+    std::size_t queue_capacity{std::size_t{1} << 16};
+    std::uint32_t seed{0};
+};
+
+struct SelfPlayStatistics
+{
+    std::uint64_t games{0};
+    std::uint64_t sampled_positions{0};
+    std::uint64_t written_positions{0};
+    std::uint64_t duplicate_positions{0};
+    std::size_t file_count{0};
+};
+
+/**
+ * @brief plays shallow search games on thread_count threads and writes their quiet positions as
+ *  TrainingRecord files
+ * @note a position is quiet when side to move is not in check and the searched move is neither
+ *  a capture nor a promotion, mate scores are skipped. Samples of a game are queued once its
+ *  result is known, a single writer thread drops positions whose zobrist key it has seen
+ *  already. Games still running when stop is requested are discarded
+ * @warning throws runtime_error if output can not be written
+ */
+SelfPlayStatistics run_self_play(const SelfPlayConfig& config,
+                                 const std::atomic<bool>& stop_requested);
@@ -0,0 +1,240 @@
+#pragma once
+#include <cstdint>
+#include <initializer_list>
+#include <iterator>
+
+#include "Pieces.hpp"
+
+constexpr std::size_t SQUARE_COUNT = 64;
+
+/**
+ * @brief board square as one byte index, index = 8 * rank + file, a1 is 0 and h8 is 63
+ * @note 0x88 index = 16 * rank + file keeps a gap column right of every rank so a step off the
+ *  board always sets bit 3 or bit 7, see is_0x88_on_board
+ */
+class Square
+{
+public:
+    constexpr Square() = default;
+    constexpr explicit Square(std::uint8_t index)
+        : m_index{index}
+    {
+    }
+    /**
+     * @warning position has to be valid
+     */
+    explicit Square(const Position& position)
+        : m_index{static_cast<std::uint8_t>(position.y * 8 + position.x)}
+    {
+    }
+    static constexpr Square from_0x88(std::int32_t index_0x88)
+    {
+        return Square{static_cast<std::uint8_t>((index_0x88 + (index_0x88 & 7)) >> 1)};
+    }
+
+    constexpr std::uint8_t get_index() const
+    {
+        return m_index;
+    }
+    constexpr std::int32_t get_file() const
+    {
+        return m_index & 7;
+    }
+    constexpr std::int32_t get_rank() const
+    {
+        return m_index >> 3;
+    }
+    constexpr std::int32_t to_0x88() const
+    {
+        return m_index + (m_index & ~7);
+    }
+    Position to_position() const
+    {
+        return {get_file(), get_rank()};
+    }
+
+    friend constexpr bool operator==(Square lhs, Square rhs)
+    {
+        return lhs.m_index == rhs.m_index;
+    }
+    friend constexpr bool operator!=(Square lhs, Square rhs)
+    {
+        return lhs.m_index != rhs.m_index;
+    }
+
+private:
+    std::uint8_t m_index{0};
+};
+
+constexpr bool is_0x88_on_board(std::int32_t index_0x88)
+{
+    return (index_0x88 & 0x88) == 0;
+}
+
+/**
+ * @brief set of squares stored as 64 bit mask, replaces unordered_set<Position> on hot paths
+ * @note iterates positions in square index order
+ */
+class SquareSet
+{
+public:
+    class const_iterator
+    {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = Position;
+        using difference_type = std::ptrdiff_t;
+        using pointer = void;
+        using reference = Position;
+
+        constexpr explicit const_iterator(std::uint64_t bits)
+            : m_bits{bits}
+        {
+        }
+        Square get_square() const
+        {
+            return Square{static_cast<std::uint8_t>(__builtin_ctzll(m_bits))};
+        }
+        Position operator*() const
+        {
+            return get_square().to_position();
+        }
+        const_iterator& operator++()
+        {
+            m_bits &= m_bits - 1;
+            return *this;
+        }
+        const_iterator operator++(int)
+        {
+            auto previous = *this;
+            ++*this;
+            return previous;
+        }
+        friend bool operator==(const const_iterator& lhs, const const_iterator& rhs)
+        {
+            return lhs.m_bits == rhs.m_bits;
+        }
+        friend bool operator!=(const const_iterator& lhs, const const_iterator& rhs)
+        {
+            return lhs.m_bits != rhs.m_bits;
+        }
+
+    private:
+        std::uint64_t m_bits;
+    };
+    using iterator = const_iterator;
+    using value_type = Position;
+
+public:
+    constexpr SquareSet() = default;
+    constexpr explicit SquareSet(std::uint64_t bits)
+        : m_bits{bits}
+    {
+    }
+    /**
+     * @warning positions have to be valid
+     */
+    SquareSet(std::initializer_list<Position> positions)
+    {
+        for (const auto& position : positions)
+        {
+            insert(position);
+        }
+    }
+
+    void insert(Square square)
+    {
+        m_bits |= get_mask(square);
+    }
+    /**
+     * @warning position has to be valid
+     */
+    void insert(const Position& position)
+    {
+        insert(Square{position});
+    }
+    void erase(Square square)
+    {
+        m_bits &= ~get_mask(square);
+    }
+    constexpr bool contains(Square square) const
+    {
+        return (m_bits & get_mask(square)) != 0;
+    }
+    /**
+     * @return 1 if valid position is in set, 0 otherwise, same as unordered_set::count
+     */
+    std::size_t count(const Position& position) const
+    {
+        if (position.x < 0 || position.x > 7 || position.y < 0 || position.y > 7)
+        {
+            return 0;
+        }
+        return contains(Square{position}) ? 1 : 0;
+    }
+    std::size_t size() const
+    {
+        return static_cast<std::size_t>(__builtin_popcountll(m_bits));
+    }
+    constexpr bool empty() const
+    {
+        return m_bits == 0;
+    }
+    void clear()
+    {
+        m_bits = 0;
+    }
+    constexpr std::uint64_t get_bits() const
+    {
+        return m_bits;
+    }
+
+    const_iterator begin() const
+    {
+        return const_iterator{m_bits};
+    }
+    const_iterator end() const
+    {
+        return const_iterator{0};
+    }
+
+    SquareSet& operator|=(SquareSet other)
+    {
+        m_bits |= other.m_bits;
+        return *this;
+    }
+    SquareSet& operator&=(SquareSet other)
+    {
+        m_bits &= other.m_bits;
+        return *this;
+    }
+    constexpr SquareSet operator~() const
+    {
+        return SquareSet{~m_bits};
+    }
+    friend constexpr SquareSet operator|(SquareSet lhs, SquareSet rhs)
+    {
+        return SquareSet{lhs.m_bits | rhs.m_bits};
+    }
+    friend constexpr SquareSet operator&(SquareSet lhs, SquareSet rhs)
+    {
+        return SquareSet{lhs.m_bits & rhs.m_bits};
+    }
+    friend constexpr bool operator==(const SquareSet& lhs, const SquareSet& rhs)
+    {
+        return lhs.m_bits == rhs.m_bits;
+    }
+    friend constexpr bool operator!=(const SquareSet& lhs, const SquareSet& rhs)
+    {
+        return lhs.m_bits != rhs.m_bits;
+    }
+
+private:
+    static constexpr std::uint64_t get_mask(Square square)
+    {
+        return std::uint64_t{1} << square.get_index();
+    }
+
+private:
+    std::uint64_t m_bits{0};
+};
@@ -0,0 +1,153 @@
+#pragma once
+#include <array>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "MappedFile.hpp"
+#include "PositionState.hpp"
+
+constexpr std::size_t MAX_TABLEBASE_PIECE_COUNT = 4;
+
+/**
+ * @brief tables store one byte per position: 0 draw, 1..127 side to move mates in that many
+ *  plies, 128 + n side to move is mated in n plies, 255 position that can not occur
+ */
+constexpr std::uint8_t TABLEBASE_DRAW = 0;
+constexpr std::uint8_t TABLEBASE_LOSS_OFFSET = 128;
+constexpr std::uint8_t TABLEBASE_MAX_WIN_PLIES = 127;
+constexpr std::uint8_t TABLEBASE_MAX_LOSS_PLIES = 125;
+constexpr std::uint8_t TABLEBASE_INVALID = 255;
+
+enum class TablebaseResult : std::uint8_t
+{
+    WIN,
+    DRAW,
+    LOSS
+};
+const char* to_c_str(TablebaseResult result);
+
+/**
+ * @brief result for side to move, plies_to_mate is 0 for draws
+ */
+struct TablebaseProbe
+{
+    TablebaseResult result;
+    std::uint8_t plies_to_mate;
+};
+std::uint8_t encode_tablebase_probe(const TablebaseProbe& probe);
+std::optional<TablebaseProbe> decode_tablebase_value(std::uint8_t value);
+
+struct TablebasePiece
+{
+    PieceType type;
+    PieceColor color;
+    /**
+     * @note 8 * y + x
+     */
+    std::int32_t square;
+};
+
+/**
+ * @brief piece list of a position without castling rights
+ * @note pieces are ordered as in the material name: white king, black king, other white
+ *  pieces, other black pieces, both by type in order Q, R, B, N, P
+ */
+struct TablebasePosition
+{
+    std::array<TablebasePiece, MAX_TABLEBASE_PIECE_COUNT> pieces;
+    std::size_t piece_count{0};
+    PieceColor side_to_move{PieceColor::WHITE};
+    /**
+     * @brief file of the pawn that has just moved two squares if side to move has a pawn
+     *  next to it which may take it en passant, -1 otherwise
+     */
+    std::int32_t en_passant_file{-1};
+};
+
+/**
+ * @brief pieces of material name like "KQKR" on square a1
+ * @return nullopt if name is not two kings and at most MAX_TABLEBASE_PIECE_COUNT pieces
+ */
+std::optional<TablebasePosition> parse_material_name(std::string_view material_name);
+std::string get_material_name(const TablebasePosition& position);
+void sort_tablebase_pieces(TablebasePosition& position);
+/**
+ * @brief swaps colors and mirrors ranks, result for side to move doesn't change
+ */
+TablebasePosition flip_colors(const TablebasePosition& position);
+/**
+ * @brief sorts pieces and flips colors when needed so that the stronger side is white, tables
+ *  are generated and stored only for this orientation
+ */
+TablebasePosition canonicalize(TablebasePosition position);
+std::optional<TablebasePosition> get_tablebase_position(const PositionState& position);
+
+/**
+ * @brief number of indices of material, positions are folded by board symmetry
+ * @note index is side to move, pair of king squares and squares of the other pieces in order.
+ *  Only king pairs with the white king on files a-d are stored, without pawns also on or below
+ *  the a1-h8 diagonal, which leaves 1806 and 462 pairs of the 4096. Materials with pawns of
+ *  both colors have a second section for positions with en passant, in which the en passant
+ *  file replaces the square of the pawn that can be taken.
+ */
+std::size_t get_tablebase_size(const TablebasePosition& material);
+/**
+ * @brief smallest index of the positions symmetric to position, the same for all of them
+ */
+std::size_t get_tablebase_index(const TablebasePosition& position);
+/**
+ * @brief sets squares, side to move and en passant file from index, piece types and colors
+ *  are kept
+ * @note position may be invalid or not be the one get_tablebase_index maps to index
+ */
+void set_tablebase_index(TablebasePosition& position, std::size_t index);
+
+/**
+ * @warning throws runtime_error if file can't be written
+ */
+void write_tablebase_file(const std::string& path,
+                          std::string_view material_name,
+                          const std::vector<std::uint8_t>& values);
+
+/**
+ * @brief one memory mapped table, probing is a single byte read
+ */
+class Tablebase
+{
+public:
+    /**
+     * @warning throws runtime_error if file can't be mapped or is not a tablebase
+     */
+    explicit Tablebase(const std::string& path);
+    const std::string& get_material_name() const;
+    std::uint8_t get_value(std::size_t index) const;
+
+private:
+    MappedFile m_file;
+    std::string m_material_name;
+};
+
+class TablebaseSet
+{
+public:
+    /**
+     * @brief maps every .tb file of directory
+     * @warning throws runtime_error if one of the files can't be mapped
+     */
+    void load_directory(const std::string& path);
+    std::size_t get_table_count() const;
+
+    /**
+     * @return nullopt if position has castling rights or no table for its material
+     */
+    std::optional<TablebaseProbe> probe(const PositionState& position) const;
+    std::optional<TablebaseProbe> probe(const TablebasePosition& position) const;
+
+private:
+    std::map<std::string, Tablebase, std::less<>> m_tablebases;
+};
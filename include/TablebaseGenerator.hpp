@@ -0,0 +1,69 @@
+#pragma once
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "Tablebase.hpp"
+
+/**
+ * @brief pieces are on different squares, no pawn on its first or last rank, the side which
+ *  is not to move is not in check and an en passant file has a pawn which could have just moved
+ *  two squares with a pawn of side to move beside it
+ */
+bool is_tablebase_position_valid(const TablebasePosition& position);
+bool is_tablebase_side_to_move_in_check(const TablebasePosition& position);
+/**
+ * @brief legal moves of side to move as positions after the move
+ * @note children keep piece order of position, captured piece is removed and promoted pawn
+ *  changes its type in place so children of captures and promotions have to be sorted
+ */
+void generate_tablebase_moves(const TablebasePosition& position,
+                              std::vector<TablebasePosition>& children);
+/**
+ * @brief valid positions from which the side that has just moved reached position
+ * @note only moves keeping the material are undone, captures and promotions lead here from
+ *  tables with different material which are probed instead. Parents are generated with and
+ *  without the en passant rights they may have had.
+ */
+void generate_tablebase_unmoves(const TablebasePosition& position,
+                                std::vector<TablebasePosition>& parents);
+
+/**
+ * @brief builds distance to mate tables by retrograde analysis
+ * @note every table is solved layer by layer: positions mated in n plies give wins in n + 1
+ *  plies to their parents found with unmoves, a position becomes lost in n + 2 plies once all
+ *  its moves lead to positions won in at most n + 1 plies
+ */
+class TablebaseGenerator
+{
+public:
+    explicit TablebaseGenerator(std::size_t thread_count);
+
+    /**
+     * @brief generates table with all tables its captures and promotions convert to
+     * @warning throws invalid_argument for unknown material and runtime_error if distance to
+     *  mate doesn't fit into the table encoding
+     */
+    const std::vector<std::uint8_t>& generate(std::string_view material_name);
+    /**
+     * @brief writes every generated table to directory as <material name>.tb
+     */
+    void write(const std::string& directory) const;
+    std::vector<std::string> get_material_names() const;
+    /**
+     * @warning material of position has to be generated already
+     */
+    std::uint8_t probe(const TablebasePosition& position) const;
+
+private:
+    std::vector<std::uint8_t> solve(const TablebasePosition& material) const;
+    void run_parallel(std::size_t count,
+                      const std::function<void(std::size_t, std::size_t)>& function) const;
+
+private:
+    std::size_t m_thread_count;
+    std::map<std::string, std::vector<std::uint8_t>, std::less<>> m_tables;
+};
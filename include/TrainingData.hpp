@@ -0,0 +1,91 @@
+#pragma once
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "Board.hpp"
+#include "Pgn.hpp"
+#include "PositionState.hpp"
+
+/**
+ * @brief one labelled position in 32 bytes, written to disk as is in host byte order
+ * @note pieces holds the piece codes of the occupied squares in square order, two per byte with
+ *  the lower square in the low nibble. flags bit 0 is set if black is to move, bits 1-4 are
+ *  castling rights white king side, white queen side, black king side, black queen side
+ */
+struct TrainingRecord
+{
+    std::uint64_t occupancy{0};
+    std::array<std::uint8_t, 16> pieces{};
+    /**
+     * @brief search score in centipawns from the point of view of side to move
+     */
+    std::int16_t score{0};
+    std::uint8_t flags{0};
+    std::uint8_t en_passant_file{NO_EN_PASSANT_FILE};
+    /**
+     * @brief 1 if white won, -1 if black won, 0 for a draw
+     */
+    std::int8_t result{0};
+    std::uint8_t halfmove_clock{0};
+    std::uint16_t ply{0};
+
+    static constexpr std::uint8_t NO_EN_PASSANT_FILE = 0xFF;
+};
+static_assert(sizeof(TrainingRecord) == 32);
+static_assert(std::is_trivially_copyable_v<TrainingRecord>);
+
+/**
+ * @return value of TrainingRecord::result, unknown result is stored as draw
+ */
+std::int8_t to_record_result(GameResult result);
+TrainingRecord encode_training_record(const PositionState& position,
+                                      std::int16_t score,
+                                      GameResult result,
+                                      std::uint32_t halfmove_clock,
+                                      std::uint32_t ply);
+Board decode_board(const TrainingRecord& record);
+PieceColor get_side_to_move(const TrainingRecord& record);
+GameResult get_result(const TrainingRecord& record);
+
+/**
+ * @brief appends records to files path_prefix-000.bin, path_prefix-001.bin, ...
+ * @note a new file is started before a record would make the current one larger than
+ *  max_file_size, every file starts with an 8 byte magic
+ */
+class TrainingDataWriter
+{
+public:
+    /**
+     * @warning throws runtime_error if first file can not be created
+     */
+    TrainingDataWriter(std::string path_prefix, std::size_t max_file_size);
+
+    /**
+     * @warning throws runtime_error if record can not be written
+     */
+    void write(const TrainingRecord& record);
+    void flush();
+    std::size_t get_file_count() const;
+    std::uint64_t get_record_count() const;
+
+private:
+    void open_next_file();
+
+private:
+    std::string m_path_prefix;
+    std::size_t m_max_file_size;
+    std::ofstream m_file;
+    std::size_t m_file_size{0};
+    std::size_t m_file_count{0};
+    std::uint64_t m_record_count{0};
+};
+
+/**
+ * @warning throws runtime_error if file is not training data written by TrainingDataWriter
+ */
+std::vector<TrainingRecord> read_training_records(const std::string& path);
@@ -0,0 +1,130 @@
+#pragma once
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "Board.hpp"
+#include "TrainingData.hpp"
+
+/**
+ * @brief values of the constants in EvaluationParameters.hpp
+ */
+struct EvaluationParameters
+{
+    std::array<std::int32_t, 6> piece_values{};
+    std::int32_t bishop_pair_bonus{0};
+    std::array<std::array<std::int32_t, 64>, 6> piece_square_tables{};
+
+    /**
+     * @brief parameters evaluate is compiled with
+     */
+    static EvaluationParameters get_compiled();
+};
+
+/**
+ * @brief contents of EvaluationParameters.hpp holding parameters, same layout as the checked in
+ *  header
+ */
+std::string format_evaluation_parameters(const EvaluationParameters& parameters);
+
+/**
+ * @brief positions reduced to the features of the linear evaluation, stored as parallel arrays
+ * @note a feature is one piece on one square: bits 0-8 hold piece type * 64 + piece square
+ *  index and bit 15 is set for black pieces. Material is the sum of the features of a type, so
+ *  it is not stored. Features of a position are features[offsets[i]] .. features[offsets[i + 1]]
+ */
+class TunerDataset
+{
+public:
+    TunerDataset();
+
+    void reserve(std::size_t position_count);
+    /**
+     * @param result 1 if white won, 0.5 for a draw, 0 if black won
+     * @param score search score in centipawns from the point of view of white
+     */
+    void add_position(const Board& board, float result, std::int16_t score);
+    void add_records(const std::vector<TrainingRecord>& records);
+
+    std::size_t get_position_count() const;
+    const std::uint16_t* get_features_begin(std::size_t position_index) const;
+    const std::uint16_t* get_features_end(std::size_t position_index) const;
+    std::int8_t get_bishop_pair(std::size_t position_index) const;
+    float get_result(std::size_t position_index) const;
+    std::int16_t get_score(std::size_t position_index) const;
+
+private:
+    std::vector<std::uint32_t> m_offsets;
+    std::vector<std::uint16_t> m_features;
+    std::vector<std::int8_t> m_bishop_pairs;
+    std::vector<float> m_results;
+    std::vector<std::int16_t> m_scores;
+};
+
+struct TunerConfig
+{
+    std::size_t thread_count{1};
+    double learning_rate{1.0};
+    double beta1{0.9};
+    double beta2{0.999};
+    /**
+     * @brief target is result_weight * result + (1 - result_weight) * win probability of score
+     */
+    double result_weight{1.0};
+};
+
+/**
+ * @brief Texel tuning: fits the win probability sigmoid(k * evaluation) to game results
+ * @note mean squared error and its gradient are computed over the whole dataset in every epoch,
+ *  split into contiguous ranges over thread_count threads, parameters then take one Adam step
+ */
+class EvaluationTuner
+{
+public:
+    EvaluationTuner(const TunerDataset& dataset,
+                    const EvaluationParameters& initial_parameters,
+                    const TunerConfig& config);
+
+    /**
+     * @brief sets k to the value minimizing the error of the initial parameters
+     * @return k
+     */
+    double fit_scaling_constant();
+    void set_scaling_constant(double scaling_constant);
+    double get_scaling_constant() const;
+
+    double get_error() const;
+    /**
+     * @return error before the step
+     */
+    double run_epoch();
+    /**
+     * @brief linear evaluation of position with current parameters, from the point of view of white
+     */
+    double evaluate(std::size_t position_index) const;
+    /**
+     * @brief current parameters rounded to centipawns
+     */
+    EvaluationParameters get_parameters() const;
+
+private:
+    /**
+     * @param gradient accumulates the gradient if not empty
+     * @return sum of squared errors in range
+     */
+    double accumulate_error(std::size_t begin,
+                            std::size_t end,
+                            std::vector<double>& gradient) const;
+    double compute_error(std::vector<double>* gradient) const;
+
+private:
+    const TunerDataset& m_dataset;
+    TunerConfig m_config;
+    double m_scaling_constant;
+    std::vector<double> m_parameters;
+    std::vector<double> m_first_moments;
+    std::vector<double> m_second_moments;
+    std::uint64_t m_step_count{0};
+};
@@ -0,0 +1,52 @@
+#pragma once
+#include <cstddef>
+#include <string>
+
+/**
+ * @brief stream socket in the unix domain, closed on destruction
+ */
+class UnixSocket
+{
+public:
+    /**
+     * @brief binds and listens on path, a stale socket file left at path is removed first
+     * @warning throws runtime_error if socket can not be created, bound or listened on
+     */
+    static UnixSocket listen(const std::string& path);
+    /**
+     * @warning throws runtime_error if there is no server listening on path
+     */
+    static UnixSocket connect(const std::string& path);
+
+    UnixSocket() = default;
+    UnixSocket(UnixSocket&& other) noexcept;
+    UnixSocket& operator=(UnixSocket&& other) noexcept;
+    UnixSocket(const UnixSocket&) = delete;
+    UnixSocket& operator=(const UnixSocket&) = delete;
+    ~UnixSocket();
+
+    bool is_open() const;
+    /**
+     * @brief waits at most timeout_ms for a connection, socket that is not open if none arrived
+     */
+    UnixSocket accept(int timeout_ms) const;
+    /**
+     * @return number of bytes read, 0 if peer closed connection or on error
+     */
+    std::size_t read_some(char* data, std::size_t size) const;
+    /**
+     * @return false if connection is broken, never raises SIGPIPE
+     */
+    bool write_all(const char* data, std::size_t size) const;
+    /**
+     * @brief stops reads and writes, a thread blocked in read_some returns 0
+     */
+    void shutdown() const;
+
+private:
+    explicit UnixSocket(int file_descriptor);
+    void close();
+
+private:
+    int m_file_descriptor{-1};
+};
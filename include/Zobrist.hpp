@@ -0,0 +1,27 @@
+#pragma once
+#include <cstdint>
+
+#include "PositionState.hpp"
+
+/**
+ * @brief Zobrist keys compatible with Polyglot opening books
+ * @note en passant is hashed only when side to move has a pawn able to capture, as Polyglot does
+ */
+std::uint64_t get_zobrist_key(const PositionState& position);
+/**
+ * @brief castling rights, en passant and side to move part of the key, doesn't scan the board
+ */
+std::uint64_t get_zobrist_state_key(const PositionState& position);
+/**
+ * @brief change of piece placement part of the key after move is played on position
+ * @note key after move = key ^ state key before ^ pieces delta ^ state key after
+ */
+std::uint64_t get_zobrist_pieces_delta(const PositionState& position, const Move& move);
+
+std::uint64_t get_piece_key(PieceType piece_type, PieceColor piece_color, const Position& position);
+std::uint64_t get_castling_key(PieceColor color, bool king_side);
+std::uint64_t get_en_passant_key(std::int32_t file);
+/**
+ * @note included in the key when white is to move
+ */
+std::uint64_t get_white_to_move_key();
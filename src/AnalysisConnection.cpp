@@ -0,0 +1,128 @@
+#include <AnalysisConnection.hpp>
+#include <AnalysisProtocol.hpp>
+#include <array>
+#include <cstdio>
+#include <stdexcept>
+
+namespace
+{
+constexpr std::size_t READ_BUFFER_SIZE = 4096;
+}  // namespace
+
+void AnalysisConnection::Outbound::push(std::string payload)
+{
+    auto frame = encode_frame(payload);
+    {
+        std::lock_guard lock{mutex};
+        if (is_closed)
+        {
+            return;
+        }
+        if (byte_count + frame.size() > max_byte_count)
+        {
+            is_slow_consumer = true;
+            is_closed = true;
+            frames.clear();
+            // wakes the writer blocked in send and the reader blocked in recv
+            socket.shutdown();
+        }
+        else
+        {
+            byte_count += frame.size();
+            frames.push_back(std::move(frame));
+        }
+    }
+    condition.notify_one();
+}
+
+void AnalysisConnection::Outbound::close()
+{
+    {
+        std::lock_guard lock{mutex};
+        is_closed = true;
+        frames.clear();
+        socket.shutdown();
+    }
+    condition.notify_one();
+}
+
+AnalysisConnection::AnalysisConnection(UnixSocket socket,
+                                       AnalysisServer& server,
+                                       std::size_t max_outbound_bytes)
+    : m_outbound{std::make_shared<Outbound>()}
+{
+    m_outbound->socket = std::move(socket);
+    m_outbound->max_byte_count = max_outbound_bytes;
+    m_writer = std::thread([this] { write_replies(); });
+    m_reader = std::thread([this, &server] { read_requests(server); });
+}
+
+AnalysisConnection::~AnalysisConnection()
+{
+    m_outbound->close();
+    m_reader.join();
+    m_writer.join();
+}
+
+bool AnalysisConnection::is_closed() const
+{
+    return m_is_closed;
+}
+
+bool AnalysisConnection::is_slow_consumer() const
+{
+    return m_outbound->is_slow_consumer;
+}
+
+void AnalysisConnection::read_requests(AnalysisServer& server)
+{
+    FrameDecoder decoder;
+    std::array<char, READ_BUFFER_SIZE> buffer;
+    // callbacks keep the queue alive, replies after the connection closed are dropped
+    const auto reply = [outbound = m_outbound](std::string payload) {
+        outbound->push(std::move(payload));
+    };
+    try
+    {
+        while (const auto size = m_outbound->socket.read_some(buffer.data(), buffer.size()))
+        {
+            decoder.append(buffer.data(), size);
+            while (const auto payload = decoder.next_frame())
+            {
+                server.submit(*payload, reply);
+            }
+        }
+    }
+    catch (const std::length_error& error)
+    {
+        std::fprintf(stderr, "closing connection: %s\n", error.what());
+    }
+    m_outbound->close();
+    m_is_closed = true;
+}
+
+void AnalysisConnection::write_replies()
+{
+    auto& outbound = *m_outbound;
+    while (true)
+    {
+        std::string frame;
+        {
+            std::unique_lock lock{outbound.mutex};
+            outbound.condition.wait(lock,
+                                    [&] { return outbound.is_closed || !outbound.frames.empty(); });
+            if (outbound.is_closed)
+            {
+                return;
+            }
+            frame = std::move(outbound.frames.front());
+            outbound.frames.pop_front();
+            outbound.byte_count -= frame.size();
+        }
+        if (!outbound.socket.write_all(frame.data(), frame.size()))
+        {
+            outbound.close();
+            return;
+        }
+    }
+}
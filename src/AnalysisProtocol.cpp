@@ -0,0 +1,245 @@
+#include <AnalysisProtocol.hpp>
+#include <Notation.hpp>
+#include <charconv>
+#include <stdexcept>
+
+namespace
+{
+std::string_view next_word(std::string_view& text)
+{
+    const auto word_start = std::min(text.find_first_not_of(' '), text.size());
+    text.remove_prefix(word_start);
+    const auto word_end = std::min(text.find(' '), text.size());
+    const auto word = text.substr(0, word_end);
+    text.remove_prefix(word_end);
+    return word;
+}
+
+std::uint64_t parse_number(std::string_view word)
+{
+    std::uint64_t value = 0;
+    const auto [end, error] = std::from_chars(word.data(), word.data() + word.size(), value);
+    if (word.empty() || error != std::errc{} || end != word.data() + word.size())
+    {
+        throw std::invalid_argument("Invalid number in request");
+    }
+    return value;
+}
+
+std::string_view get_fen(std::string_view text)
+{
+    const auto fen_start = std::min(text.find_first_not_of(' '), text.size());
+    if (fen_start == text.size())
+    {
+        throw std::invalid_argument("Missing FEN in request");
+    }
+    return text.substr(fen_start);
+}
+
+std::string format_reply_start(std::uint64_t id, std::string_view status)
+{
+    auto reply = std::to_string(id);
+    reply.append(" ").append(status);
+    return reply;
+}
+
+void append_moves(std::string& reply, const Move* moves_begin, const Move* moves_end)
+{
+    for (auto move = moves_begin; move != moves_end; ++move)
+    {
+        reply.append(" ").append(to_uci(*move).get_view());
+    }
+}
+}  // namespace
+
+const char* to_c_str(AnalysisCommand command)
+{
+    switch (command)
+    {
+    case AnalysisCommand::LEGAL_MOVES:
+        return "moves";
+    case AnalysisCommand::EVALUATE:
+        return "eval";
+    case AnalysisCommand::SEARCH:
+        return "search";
+    case AnalysisCommand::METRICS:
+        return "metrics";
+    default:
+        return "unknown";
+    }
+}
+
+AnalysisRequest parse_analysis_request(std::string_view payload)
+{
+    AnalysisRequest request;
+    request.id = parse_number(next_word(payload));
+    const auto command = next_word(payload);
+    if (command == to_c_str(AnalysisCommand::METRICS))
+    {
+        request.command = AnalysisCommand::METRICS;
+        return request;
+    }
+    if (command == to_c_str(AnalysisCommand::LEGAL_MOVES))
+    {
+        request.command = AnalysisCommand::LEGAL_MOVES;
+    }
+    else if (command == to_c_str(AnalysisCommand::EVALUATE))
+    {
+        request.command = AnalysisCommand::EVALUATE;
+    }
+    else if (command == to_c_str(AnalysisCommand::SEARCH))
+    {
+        request.command = AnalysisCommand::SEARCH;
+        if (const auto max_depth = parse_number(next_word(payload)); max_depth != 0)
+        {
+            request.limits.max_depth = static_cast<std::uint32_t>(
+                std::min<std::uint64_t>(max_depth, MAX_SEARCH_DEPTH));
+        }
+        if (const auto move_time = parse_number(next_word(payload)); move_time != 0)
+        {
+            request.limits.move_time = std::chrono::milliseconds{move_time};
+        }
+        if (const auto deadline = parse_number(next_word(payload)); deadline != 0)
+        {
+            request.deadline = std::chrono::milliseconds{deadline};
+        }
+    }
+    else
+    {
+        throw std::invalid_argument("Unknown command in request");
+    }
+    request.fen = get_fen(payload);
+    return request;
+}
+
+std::string format_analysis_request(const AnalysisRequest& request)
+{
+    auto payload = std::to_string(request.id);
+    payload.append(" ").append(to_c_str(request.command));
+    if (request.command == AnalysisCommand::METRICS)
+    {
+        return payload;
+    }
+    if (request.command == AnalysisCommand::SEARCH)
+    {
+        const auto max_depth = request.limits.max_depth == MAX_SEARCH_DEPTH
+                                   ? 0
+                                   : request.limits.max_depth;
+        const auto move_time = request.limits.move_time ? request.limits.move_time->count() : 0;
+        const auto deadline = request.deadline ? request.deadline->count() : 0;
+        payload.append(" ").append(std::to_string(max_depth));
+        payload.append(" ").append(std::to_string(move_time));
+        payload.append(" ").append(std::to_string(deadline));
+    }
+    payload.append(" ").append(request.fen);
+    return payload;
+}
+
+std::uint64_t get_payload_id(std::string_view payload)
+{
+    try
+    {
+        return parse_number(next_word(payload));
+    }
+    catch (const std::invalid_argument&)
+    {
+        return 0;
+    }
+}
+
+std::string format_error_reply(std::uint64_t id, std::string_view reason)
+{
+    auto reply = format_reply_start(id, "error");
+    reply.append(" ").append(reason);
+    return reply;
+}
+
+std::string format_legal_moves_reply(std::uint64_t id,
+                                     const Move* moves_begin,
+                                     const Move* moves_end)
+{
+    auto reply = format_reply_start(id, "ok");
+    append_moves(reply, moves_begin, moves_end);
+    return reply;
+}
+
+std::string format_evaluation_reply(std::uint64_t id, std::int32_t score)
+{
+    auto reply = format_reply_start(id, "ok");
+    reply.append(" ").append(std::to_string(score));
+    return reply;
+}
+
+std::string format_search_reply(std::uint64_t id, const SearchResult& result)
+{
+    auto reply = format_reply_start(id, "ok");
+    reply.append(" bestmove ");
+    reply.append(result.best_move ? to_uci(*result.best_move).get_view() : "none");
+    reply.append(" score ").append(std::to_string(result.score));
+    reply.append(" depth ").append(std::to_string(result.depth));
+    reply.append(" nodes ").append(std::to_string(result.nodes));
+    reply.append(" pv");
+    append_moves(reply, result.principal_variation.data(),
+                 result.principal_variation.data() + result.principal_variation.size());
+    return reply;
+}
+
+std::string format_metrics_reply(std::uint64_t id, std::string_view metrics_json)
+{
+    auto reply = format_reply_start(id, "ok");
+    reply.append(" ").append(metrics_json);
+    return reply;
+}
+
+std::string encode_frame(std::string_view payload)
+{
+    std::string frame(FRAME_HEADER_SIZE, '\0');
+    for (std::size_t byte_index = 0; byte_index != FRAME_HEADER_SIZE; ++byte_index)
+    {
+        frame[byte_index] = static_cast<char>((payload.size() >> (8 * byte_index)) & 0xFF);
+    }
+    frame.append(payload);
+    return frame;
+}
+
+void FrameDecoder::append(const char* data, std::size_t size)
+{
+    // consumed bytes are dropped lazily so a burst of small frames is not moved for every frame
+    if (m_read_offset == m_buffer.size())
+    {
+        m_buffer.clear();
+        m_read_offset = 0;
+    }
+    m_buffer.append(data, size);
+}
+
+std::optional<std::string> FrameDecoder::next_frame()
+{
+    if (m_buffer.size() - m_read_offset < FRAME_HEADER_SIZE)
+    {
+        return std::nullopt;
+    }
+    std::size_t payload_size = 0;
+    for (std::size_t byte_index = 0; byte_index != FRAME_HEADER_SIZE; ++byte_index)
+    {
+        payload_size |= static_cast<std::size_t>(
+                            static_cast<unsigned char>(m_buffer[m_read_offset + byte_index]))
+                        << (8 * byte_index);
+    }
+    if (payload_size > MAX_FRAME_SIZE)
+    {
+        throw std::length_error("Frame too large");
+    }
+    if (m_buffer.size() - m_read_offset - FRAME_HEADER_SIZE < payload_size)
+    {
+        return std::nullopt;
+    }
+    auto payload = m_buffer.substr(m_read_offset + FRAME_HEADER_SIZE, payload_size);
+    m_read_offset += FRAME_HEADER_SIZE + payload_size;
+    if (m_read_offset > m_buffer.size() / 2)
+    {
+        m_buffer.erase(0, m_read_offset);
+        m_read_offset = 0;
+    }
+    return payload;
+}
@@ -0,0 +1,371 @@
+#include <AnalysisServer.hpp>
+#include <Evaluation.hpp>
+#include <algorithm>
+#include <iterator>
+#include <optional>
+#include <stdexcept>
+
+namespace
+{
+LatencyPercentiles get_percentiles(std::vector<std::uint32_t> samples)
+{
+    LatencyPercentiles percentiles;
+    percentiles.sample_count = samples.size();
+    if (samples.empty())
+    {
+        return percentiles;
+    }
+    const auto get_percentile = [&samples](std::size_t percent) {
+        const auto nth = samples.begin() + (samples.size() - 1) * percent / 100;
+        std::nth_element(samples.begin(), nth, samples.end());
+        return static_cast<std::uint64_t>(*nth);
+    };
+    percentiles.p50 = get_percentile(50);
+    percentiles.p90 = get_percentile(90);
+    percentiles.p99 = get_percentile(99);
+    percentiles.max = *std::max_element(samples.begin(), samples.end());
+    return percentiles;
+}
+
+void append_json_field(std::string& json, const char* name, std::uint64_t value)
+{
+    json.append("\"").append(name).append("\":").append(std::to_string(value));
+}
+}  // namespace
+
+std::string to_json(const AnalysisMetrics& metrics)
+{
+    std::string json = "{";
+    append_json_field(json, "batch_queue_depth", metrics.batch_queue_depth);
+    json.append(",");
+    append_json_field(json, "search_queue_depth", metrics.search_queue_depth);
+    json.append(",");
+    append_json_field(json, "active_searches", metrics.active_searches);
+    json.append(",");
+    append_json_field(json, "batches", metrics.batches);
+    json.append(",");
+    append_json_field(json, "batched_requests", metrics.batched_requests);
+    json.append(",");
+    append_json_field(json, "rejected_requests", metrics.rejected_requests);
+    json.append(",");
+    append_json_field(json, "expired_requests", metrics.expired_requests);
+    json.append(",");
+    append_json_field(json, "failed_requests", metrics.failed_requests);
+    json.append(",\"latency_us\":{");
+    for (std::size_t command_index = 0; command_index != ANALYSIS_COMMAND_COUNT; ++command_index)
+    {
+        const auto& latency = metrics.latencies[command_index];
+        json.append(command_index == 0 ? "\"" : ",\"");
+        json.append(to_c_str(static_cast<AnalysisCommand>(command_index))).append("\":{");
+        append_json_field(json, "count", latency.sample_count);
+        json.append(",");
+        append_json_field(json, "p50", latency.p50);
+        json.append(",");
+        append_json_field(json, "p90", latency.p90);
+        json.append(",");
+        append_json_field(json, "p99", latency.p99);
+        json.append(",");
+        append_json_field(json, "max", latency.max);
+        json.append("}");
+    }
+    json.append("}}");
+    return json;
+}
+
+AnalysisServer::AnalysisServer(const AnalysisServerConfig& config)
+    : m_config{config}
+    , m_move_generator{config.batch_thread_count}
+{
+    m_config.search_thread_count = std::max<std::size_t>(1, m_config.search_thread_count);
+    m_config.max_batch_size = std::max<std::size_t>(1, m_config.max_batch_size);
+    m_batch_thread = std::thread([this] { run_batches(); });
+    for (std::size_t thread_index = 0; thread_index != m_config.search_thread_count;
+         ++thread_index)
+    {
+        m_search_threads.emplace_back([this] { run_searches(); });
+    }
+}
+
+AnalysisServer::~AnalysisServer()
+{
+    {
+        std::scoped_lock lock{m_batch_mutex, m_search_mutex};
+        m_shutdown = true;
+    }
+    m_batch_condition.notify_all();
+    m_search_condition.notify_all();
+    m_batch_thread.join();
+    for (auto& search_thread : m_search_threads)
+    {
+        search_thread.join();
+    }
+    for (auto* queue : {&m_batch_queue, &m_search_queue})
+    {
+        for (auto& pending : *queue)
+        {
+            fail(pending, "shutting down");
+        }
+    }
+}
+
+void AnalysisServer::submit(std::string_view payload, ReplyCallback reply)
+{
+    PendingRequest pending{{}, std::move(reply), Clock::now()};
+    try
+    {
+        pending.request = parse_analysis_request(payload);
+    }
+    catch (const std::invalid_argument& error)
+    {
+        pending.request.id = get_payload_id(payload);
+        fail(pending, error.what());
+        return;
+    }
+
+    switch (pending.request.command)
+    {
+    case AnalysisCommand::METRICS:
+    {
+        finish(pending, format_metrics_reply(pending.request.id, to_json(get_metrics())));
+        return;
+    }
+    case AnalysisCommand::SEARCH:
+    {
+        std::unique_lock lock{m_search_mutex};
+        if (m_shutdown || m_search_queue.size() >= m_config.max_queued_searches)
+        {
+            lock.unlock();
+            {
+                std::lock_guard metrics_lock{m_metrics_mutex};
+                ++m_rejected_requests;
+            }
+            fail(pending, "busy");
+            return;
+        }
+        m_search_queue.push_back(std::move(pending));
+        lock.unlock();
+        m_search_condition.notify_one();
+        return;
+    }
+    default:
+    {
+        std::unique_lock lock{m_batch_mutex};
+        if (m_shutdown)
+        {
+            lock.unlock();
+            fail(pending, "shutting down");
+            return;
+        }
+        if (m_batch_queue.size() >= m_config.max_queued_batch_requests)
+        {
+            lock.unlock();
+            {
+                std::lock_guard metrics_lock{m_metrics_mutex};
+                ++m_rejected_requests;
+            }
+            fail(pending, "busy");
+            return;
+        }
+        m_batch_queue.push_back(std::move(pending));
+        // the batch thread sleeps through the window unless a full batch can go right away
+        const auto should_notify = m_batch_queue.size() == 1 ||
+                                   m_batch_queue.size() >= m_config.max_batch_size;
+        lock.unlock();
+        if (should_notify)
+        {
+            m_batch_condition.notify_one();
+        }
+        return;
+    }
+    }
+}
+
+AnalysisMetrics AnalysisServer::get_metrics() const
+{
+    AnalysisMetrics metrics;
+    {
+        std::lock_guard lock{m_batch_mutex};
+        metrics.batch_queue_depth = m_batch_queue.size();
+    }
+    {
+        std::lock_guard lock{m_search_mutex};
+        metrics.search_queue_depth = m_search_queue.size();
+        metrics.active_searches = m_active_searches;
+    }
+    std::array<std::vector<std::uint32_t>, ANALYSIS_COMMAND_COUNT> samples;
+    {
+        std::lock_guard lock{m_metrics_mutex};
+        metrics.batches = m_batches;
+        metrics.batched_requests = m_batched_requests;
+        metrics.rejected_requests = m_rejected_requests;
+        metrics.expired_requests = m_expired_requests;
+        metrics.failed_requests = m_failed_requests;
+        for (std::size_t command_index = 0; command_index != ANALYSIS_COMMAND_COUNT;
+             ++command_index)
+        {
+            const auto& window = m_latencies[command_index];
+            samples[command_index].assign(window.samples.begin(),
+                                          window.samples.begin() + window.sample_count);
+        }
+    }
+    // sorting happens outside of the lock, replies only wait for the copy
+    for (std::size_t command_index = 0; command_index != ANALYSIS_COMMAND_COUNT; ++command_index)
+    {
+        metrics.latencies[command_index] = get_percentiles(std::move(samples[command_index]));
+    }
+    return metrics;
+}
+
+void AnalysisServer::run_batches()
+{
+    std::vector<PendingRequest> batch;
+    while (true)
+    {
+        {
+            std::unique_lock lock{m_batch_mutex};
+            m_batch_condition.wait(lock, [this] { return m_shutdown || !m_batch_queue.empty(); });
+            if (m_shutdown)
+            {
+                return;
+            }
+            const auto window_end = m_batch_queue.front().received + m_config.batch_window;
+            m_batch_condition.wait_until(lock, window_end, [this] {
+                return m_shutdown || m_batch_queue.size() >= m_config.max_batch_size;
+            });
+            if (m_shutdown)
+            {
+                return;
+            }
+            const auto batch_size = std::min(m_batch_queue.size(), m_config.max_batch_size);
+            std::move(m_batch_queue.begin(), m_batch_queue.begin() + batch_size,
+                      std::back_inserter(batch));
+            m_batch_queue.erase(m_batch_queue.begin(), m_batch_queue.begin() + batch_size);
+        }
+        serve_batch(batch);
+        batch.clear();
+    }
+}
+
+void AnalysisServer::serve_batch(std::vector<PendingRequest>& batch)
+{
+    {
+        std::lock_guard lock{m_metrics_mutex};
+        ++m_batches;
+        m_batched_requests += batch.size();
+    }
+
+    m_move_positions.clear();
+    m_move_request_indices.clear();
+    for (std::size_t request_index = 0; request_index != batch.size(); ++request_index)
+    {
+        auto& pending = batch[request_index];
+        PositionState position;
+        try
+        {
+            position = PositionState::from_fen(pending.request.fen);
+        }
+        catch (const std::exception& error)
+        {
+            fail(pending, error.what());
+            continue;
+        }
+        if (pending.request.command == AnalysisCommand::EVALUATE)
+        {
+            finish(pending, format_evaluation_reply(pending.request.id, evaluate(position)));
+            continue;
+        }
+        m_move_positions.push_back(std::move(position));
+        m_move_request_indices.push_back(request_index);
+    }
+
+    m_move_generator.generate(m_move_positions.data(), m_move_positions.size(), m_moves);
+    for (std::size_t position_index = 0; position_index != m_move_positions.size();
+         ++position_index)
+    {
+        auto& pending = batch[m_move_request_indices[position_index]];
+        finish(pending, format_legal_moves_reply(pending.request.id,
+                                                 m_moves.get_moves_begin(position_index),
+                                                 m_moves.get_moves_end(position_index)));
+    }
+}
+
+void AnalysisServer::run_searches()
+{
+    while (true)
+    {
+        PendingRequest pending;
+        {
+            std::unique_lock lock{m_search_mutex};
+            m_search_condition.wait(lock,
+                                    [this] { return m_shutdown || !m_search_queue.empty(); });
+            if (m_shutdown)
+            {
+                return;
+            }
+            pending = std::move(m_search_queue.front());
+            m_search_queue.pop_front();
+            ++m_active_searches;
+        }
+        serve_search(pending);
+        std::lock_guard lock{m_search_mutex};
+        --m_active_searches;
+    }
+}
+
+void AnalysisServer::serve_search(PendingRequest& pending)
+{
+    auto limits = pending.request.limits;
+    if (pending.request.deadline)
+    {
+        const auto time_left = std::chrono::duration_cast<std::chrono::milliseconds>(
+            pending.received + *pending.request.deadline - Clock::now());
+        if (time_left.count() <= 0)
+        {
+            {
+                std::lock_guard lock{m_metrics_mutex};
+                ++m_expired_requests;
+            }
+            fail(pending, "deadline expired");
+            return;
+        }
+        limits.move_time = limits.move_time ? std::min(*limits.move_time, time_left) : time_left;
+    }
+
+    std::optional<GameState> game;
+    try
+    {
+        game = GameState::from_fen(pending.request.fen);
+    }
+    catch (const std::exception& error)
+    {
+        fail(pending, error.what());
+        return;
+    }
+    // shutdown doubles as stop flag, a running search returns its last completed depth
+    const auto result = search(std::move(*game), limits, m_shutdown);
+    finish(pending, format_search_reply(pending.request.id, result));
+}
+
+void AnalysisServer::finish(PendingRequest& pending, std::string reply)
+{
+    const auto latency = std::chrono::duration_cast<std::chrono::microseconds>(
+        Clock::now() - pending.received);
+    {
+        std::lock_guard lock{m_metrics_mutex};
+        auto& window = m_latencies[static_cast<std::size_t>(pending.request.command)];
+        window.samples[window.next_index] = static_cast<std::uint32_t>(
+            std::min<std::int64_t>(latency.count(), UINT32_MAX));
+        window.next_index = (window.next_index + 1) % LATENCY_WINDOW_SIZE;
+        window.sample_count = std::min(window.sample_count + 1, LATENCY_WINDOW_SIZE);
+    }
+    pending.reply(std::move(reply));
+}
+
+void AnalysisServer::fail(PendingRequest& pending, std::string_view reason)
+{
+    {
+        std::lock_guard lock{m_metrics_mutex};
+        ++m_failed_requests;
+    }
+    pending.reply(format_error_reply(pending.request.id, reason));
+}
@@ -0,0 +1,94 @@
+#include <AnalysisWorker.hpp>
+
+AnalysisWorker::AnalysisWorker()
+    : m_thread{&AnalysisWorker::run, this}
+{
+}
+
+AnalysisWorker::~AnalysisWorker()
+{
+    {
+        std::lock_guard lock{m_mutex};
+        m_shutdown = true;
+        m_stop_search = true;
+    }
+    m_condition.notify_all();
+    m_thread.join();
+}
+
+std::uint64_t AnalysisWorker::analyse(const GameState& game, const SearchLimits& limits)
+{
+    std::uint64_t request_id = 0;
+    {
+        std::lock_guard lock{m_mutex};
+        request_id = ++m_last_request_id;
+        m_pending_request = Request{request_id, game, limits};
+        m_stop_search = true;
+    }
+    m_condition.notify_all();
+    return request_id;
+}
+
+void AnalysisWorker::stop()
+{
+    {
+        std::lock_guard lock{m_mutex};
+        if (m_pending_request)
+        {
+            // request never picked up is finished without result, so its waiters return
+            m_snapshot = {m_pending_request->id, {}, {}, false};
+            m_pending_request.reset();
+        }
+        m_stop_search = true;
+    }
+    m_condition.notify_all();
+}
+
+AnalysisSnapshot AnalysisWorker::get_snapshot() const
+{
+    std::lock_guard lock{m_mutex};
+    return m_snapshot;
+}
+
+void AnalysisWorker::wait_until_finished(std::uint64_t request_id) const
+{
+    std::unique_lock lock{m_mutex};
+    m_condition.wait(lock, [this, request_id] {
+        return m_shutdown || m_last_request_id != request_id
+               || (m_snapshot.request_id == request_id && !m_snapshot.is_searching);
+    });
+}
+
+void AnalysisWorker::run()
+{
+    while (true)
+    {
+        std::unique_lock lock{m_mutex};
+        m_condition.wait(lock, [this] { return m_shutdown || m_pending_request; });
+        if (m_shutdown)
+        {
+            return;
+        }
+        auto request = std::move(*m_pending_request);
+        m_pending_request.reset();
+        m_stop_search = false;
+        lock.unlock();
+
+        std::vector<Move> legal_moves;
+        request.game.get_position().generate_legal_moves(legal_moves);
+        lock.lock();
+        m_snapshot = {request.id, std::move(legal_moves), {}, true};
+        lock.unlock();
+
+        const auto result = search(request.game, request.limits, m_stop_search,
+                                   [this](const SearchResult& depth_result) {
+                                       std::lock_guard progress_lock{m_mutex};
+                                       m_snapshot.result = depth_result;
+                                   });
+        lock.lock();
+        m_snapshot.result = result;
+        m_snapshot.is_searching = false;
+        lock.unlock();
+        m_condition.notify_all();
+    }
+}
@@ -0,0 +1,159 @@
+#include <AttackMap.hpp>
+#include <Attacks.hpp>
+
+namespace
+{
+SquareSet compute_piece_attacks(PieceCode piece_code, Square square, SquareSet occupancy)
+{
+    switch (piece_code.get_type())
+    {
+    case PieceType::KING:
+        return get_king_attacks(square);
+    case PieceType::QUEEN:
+        return get_bishop_attacks(square, occupancy) | get_rook_attacks(square, occupancy);
+    case PieceType::BISHOP:
+        return get_bishop_attacks(square, occupancy);
+    case PieceType::KNIGHT:
+        return get_knight_attacks(square);
+    case PieceType::ROOK:
+        return get_rook_attacks(square, occupancy);
+    case PieceType::PAWN:
+        return get_pawn_attacks(square, piece_code.get_color());
+    }
+    return {};
+}
+
+bool is_slider(PieceType piece_type)
+{
+    return piece_type == PieceType::QUEEN || piece_type == PieceType::BISHOP
+           || piece_type == PieceType::ROOK;
+}
+}  // namespace
+
+AttackMap::AttackMap(const Board& board)
+{
+    const auto occupancy = board.get_occupied_squares();
+    for (auto it = occupancy.begin(); it != occupancy.end(); ++it)
+    {
+        add_piece_attacks(board, it.get_square(), occupancy);
+    }
+}
+
+void AttackMap::update(const Board& board, SquareSet changed_squares)
+{
+    // sliders not on changed squares need new attacks only if a ray reached a changed square
+    auto recomputed_squares = changed_squares;
+    const auto unchanged_sliders = m_sliders & ~changed_squares;
+    for (auto it = unchanged_sliders.begin(); it != unchanged_sliders.end(); ++it)
+    {
+        if (!(m_piece_attacks[it.get_square().get_index()] & changed_squares).empty())
+        {
+            recomputed_squares.insert(it.get_square());
+        }
+    }
+
+    const auto occupancy = board.get_occupied_squares();
+    for (auto it = recomputed_squares.begin(); it != recomputed_squares.end(); ++it)
+    {
+        remove_piece_attacks(it.get_square());
+        add_piece_attacks(board, it.get_square(), occupancy);
+    }
+}
+
+void AttackMap::update(const Board& board, const Move& move)
+{
+    update(board, get_changed_squares(move));
+}
+
+SquareSet AttackMap::get_piece_attacks(Square square) const
+{
+    return m_piece_attacks[square.get_index()];
+}
+
+std::uint8_t AttackMap::get_attacker_count(Square square, PieceColor color) const
+{
+    return m_attacker_counts[to_index(color)][square.get_index()];
+}
+
+bool AttackMap::is_attacked(Square square, PieceColor by_color) const
+{
+    return m_attacked_squares[to_index(by_color)].contains(square);
+}
+
+SquareSet AttackMap::get_attacked_squares(PieceColor by_color) const
+{
+    return m_attacked_squares[to_index(by_color)];
+}
+
+void AttackMap::add_piece_attacks(const Board& board, Square square, SquareSet occupancy)
+{
+    const auto piece_code = board.get_piece_code(square);
+    if (piece_code.is_empty())
+    {
+        return;
+    }
+    const auto color_index = to_index(piece_code.get_color());
+    const auto attacks = compute_piece_attacks(piece_code, square, occupancy);
+    for (auto it = attacks.begin(); it != attacks.end(); ++it)
+    {
+        if (m_attacker_counts[color_index][it.get_square().get_index()]++ == 0)
+        {
+            m_attacked_squares[color_index].insert(it.get_square());
+        }
+    }
+    m_piece_attacks[square.get_index()] = attacks;
+    m_attacking_pieces[color_index].insert(square);
+    if (is_slider(piece_code.get_type()))
+    {
+        m_sliders.insert(square);
+    }
+}
+
+void AttackMap::remove_piece_attacks(Square square)
+{
+    if (!m_attacking_pieces[0].contains(square) && !m_attacking_pieces[1].contains(square))
+    {
+        return;
+    }
+    const std::size_t color_index = m_attacking_pieces[0].contains(square) ? 0 : 1;
+    auto& attacks = m_piece_attacks[square.get_index()];
+    for (auto it = attacks.begin(); it != attacks.end(); ++it)
+    {
+        if (--m_attacker_counts[color_index][it.get_square().get_index()] == 0)
+        {
+            m_attacked_squares[color_index].erase(it.get_square());
+        }
+    }
+    attacks.clear();
+    m_attacking_pieces[color_index].erase(square);
+    m_sliders.erase(square);
+}
+
+bool operator==(const AttackMap& lhs, const AttackMap& rhs)
+{
+    return lhs.m_piece_attacks == rhs.m_piece_attacks
+           && lhs.m_attacker_counts == rhs.m_attacker_counts
+           && lhs.m_attacked_squares == rhs.m_attacked_squares
+           && lhs.m_attacking_pieces == rhs.m_attacking_pieces && lhs.m_sliders == rhs.m_sliders;
+}
+
+SquareSet get_changed_squares(const Move& move)
+{
+    SquareSet changed_squares{move.from, move.to};
+    const auto back_rank = move.from.y;
+    switch (move.type)
+    {
+    case MoveType::EN_PASSANT:
+        changed_squares.insert(Position{move.to.x, move.from.y});
+        break;
+    case MoveType::KING_SIDE_CASTLE:
+        changed_squares |= SquareSet{Position{7, back_rank}, Position{5, back_rank}};
+        break;
+    case MoveType::QUEEN_SIDE_CASTLE:
+        changed_squares |= SquareSet{Position{0, back_rank}, Position{3, back_rank}};
+        break;
+    case MoveType::NORMAL:
+        break;
+    }
+    return changed_squares;
+}
@@ -0,0 +1,298 @@
+#include <Attacks.hpp>
+#include <Geometry.hpp>
+#include <Instrumentation.hpp>
+#include <array>
+
+#if defined(__AVX2__) || defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+namespace
+{
+constexpr std::array<Direction, 4> ROOK_DIRECTIONS = {Direction::NORTH, Direction::EAST,
+                                                      Direction::SOUTH, Direction::WEST};
+constexpr std::array<Direction, 4> BISHOP_DIRECTIONS
+    = {Direction::NORTH_EAST, Direction::NORTH_WEST, Direction::SOUTH_WEST, Direction::SOUTH_EAST};
+
+std::uint64_t get_ray_attacks(Direction direction, Square square, std::uint64_t occupancy)
+{
+    const auto& ray_masks = RAY_MASKS[static_cast<std::size_t>(direction)];
+    const auto ray = ray_masks[square.get_index()];
+    const auto blockers = ray & occupancy;
+    if (blockers == 0)
+    {
+        return ray;
+    }
+    const auto blocker
+        = is_increasing(direction) ? __builtin_ctzll(blockers) : 63 - __builtin_clzll(blockers);
+    return ray ^ ray_masks[blocker];
+}
+
+template <std::size_t direction_count>
+SquareSet get_slider_attacks(const std::array<Direction, direction_count>& directions,
+                             Square square,
+                             SquareSet occupancy)
+{
+    std::uint64_t attacks = 0;
+    for (const auto direction : directions)
+    {
+        attacks |= get_ray_attacks(direction, square, occupancy.get_bits());
+    }
+    return SquareSet{attacks};
+}
+
+SquareSet get_pieces(const Board& board, PieceType piece_type)
+{
+    return board.get_pieces(PieceColor::WHITE, piece_type)
+           | board.get_pieces(PieceColor::BLACK, piece_type);
+}
+
+constexpr std::uint64_t ALL_SQUARES = ~std::uint64_t{0};
+constexpr std::uint64_t NOT_A_FILE = 0xfefefefefefefefe;
+constexpr std::uint64_t NOT_AB_FILES = 0xfcfcfcfcfcfcfcfc;
+constexpr std::uint64_t NOT_H_FILE = 0x7f7f7f7f7f7f7f7f;
+constexpr std::uint64_t NOT_GH_FILES = 0x3f3f3f3f3f3f3f3f;
+
+// fill directions north, east, north east and north west shift left, their opposites shift
+// right by the same amount, masks remove squares wrapped around to the other side of the board
+constexpr std::array<std::int32_t, 4> FILL_SHIFTS = {8, 1, 9, 7};
+constexpr std::array<std::uint64_t, 4> LEFT_FILL_MASKS
+    = {ALL_SQUARES, NOT_A_FILE, NOT_A_FILE, NOT_H_FILE};
+constexpr std::array<std::uint64_t, 4> RIGHT_FILL_MASKS
+    = {ALL_SQUARES, NOT_H_FILE, NOT_H_FILE, NOT_A_FILE};
+
+/**
+ * @brief sliders of every piece type grouped the way fill directions are
+ */
+struct Sliders
+{
+    std::uint64_t orthogonal;
+    std::uint64_t diagonal;
+    std::uint64_t empty;
+};
+
+template <bool left>
+std::uint64_t shift(std::uint64_t bits, std::int32_t count)
+{
+    return left ? bits << count : bits >> count;
+}
+
+template <bool left>
+std::uint64_t get_fill_attacks(std::uint64_t sliders,
+                               std::uint64_t empty,
+                               std::int32_t count,
+                               std::uint64_t mask)
+{
+    auto propagators = empty & mask;
+    sliders |= propagators & shift<left>(sliders, count);
+    propagators &= shift<left>(propagators, count);
+    sliders |= propagators & shift<left>(sliders, 2 * count);
+    propagators &= shift<left>(propagators, 2 * count);
+    sliders |= propagators & shift<left>(sliders, 4 * count);
+    return shift<left>(sliders, count) & mask;
+}
+
+std::uint64_t get_slider_attacks_scalar(const Sliders& sliders)
+{
+    std::uint64_t attacks = 0;
+    for (std::size_t index = 0; index != FILL_SHIFTS.size(); ++index)
+    {
+        const auto pieces = index < 2 ? sliders.orthogonal : sliders.diagonal;
+        attacks |= get_fill_attacks<true>(pieces, sliders.empty, FILL_SHIFTS[index],
+                                          LEFT_FILL_MASKS[index])
+                   | get_fill_attacks<false>(pieces, sliders.empty, FILL_SHIFTS[index],
+                                             RIGHT_FILL_MASKS[index]);
+    }
+    return attacks;
+}
+
+#if defined(__AVX2__)
+/**
+ * @note one vector holds the four left shifting directions, another the four right shifting
+ */
+std::uint64_t get_slider_attacks_vector(const Sliders& sliders)
+{
+    const auto pieces = _mm256_setr_epi64x(sliders.orthogonal, sliders.orthogonal,
+                                           sliders.diagonal, sliders.diagonal);
+    const auto empty = _mm256_set1_epi64x(sliders.empty);
+    const auto shift_1 = _mm256_setr_epi64x(FILL_SHIFTS[0], FILL_SHIFTS[1], FILL_SHIFTS[2],
+                                            FILL_SHIFTS[3]);
+    const auto shift_2 = _mm256_add_epi64(shift_1, shift_1);
+    const auto shift_4 = _mm256_add_epi64(shift_2, shift_2);
+    const auto fill = [&](const auto& step, __m256i mask)
+    {
+        auto generators = pieces;
+        auto propagators = _mm256_and_si256(empty, mask);
+        generators = _mm256_or_si256(
+            generators, _mm256_and_si256(propagators, step(generators, shift_1)));
+        propagators = _mm256_and_si256(propagators, step(propagators, shift_1));
+        generators = _mm256_or_si256(
+            generators, _mm256_and_si256(propagators, step(generators, shift_2)));
+        propagators = _mm256_and_si256(propagators, step(propagators, shift_2));
+        generators = _mm256_or_si256(
+            generators, _mm256_and_si256(propagators, step(generators, shift_4)));
+        return _mm256_and_si256(step(generators, shift_1), mask);
+    };
+    const auto left_attacks
+        = fill([](__m256i bits, __m256i count) { return _mm256_sllv_epi64(bits, count); },
+               _mm256_setr_epi64x(LEFT_FILL_MASKS[0], LEFT_FILL_MASKS[1], LEFT_FILL_MASKS[2],
+                                  LEFT_FILL_MASKS[3]));
+    const auto right_attacks
+        = fill([](__m256i bits, __m256i count) { return _mm256_srlv_epi64(bits, count); },
+               _mm256_setr_epi64x(RIGHT_FILL_MASKS[0], RIGHT_FILL_MASKS[1], RIGHT_FILL_MASKS[2],
+                                  RIGHT_FILL_MASKS[3]));
+    const auto attacks = _mm256_or_si256(left_attacks, right_attacks);
+    const auto halves = _mm_or_si128(_mm256_castsi256_si128(attacks),
+                                     _mm256_extracti128_si256(attacks, 1));
+    return static_cast<std::uint64_t>(_mm_cvtsi128_si64(halves))
+           | static_cast<std::uint64_t>(_mm_cvtsi128_si64(_mm_unpackhi_epi64(halves, halves)));
+}
+#elif defined(__SSE2__)
+/**
+ * @brief shifts low lane left and high lane right, SSE2 has no per lane shift counts so
+ *  every vector holds a direction and its opposite
+ */
+__m128i shift_opposite(__m128i bits, std::int32_t count)
+{
+    const auto shift_count = _mm_cvtsi32_si128(count);
+    return _mm_castpd_si128(_mm_move_sd(_mm_castsi128_pd(_mm_srl_epi64(bits, shift_count)),
+                                        _mm_castsi128_pd(_mm_sll_epi64(bits, shift_count))));
+}
+
+std::uint64_t get_slider_attacks_vector(const Sliders& sliders)
+{
+    const auto empty = _mm_set1_epi64x(static_cast<long long>(sliders.empty));
+    auto attacks = _mm_setzero_si128();
+    for (std::size_t index = 0; index != FILL_SHIFTS.size(); ++index)
+    {
+        const auto count = FILL_SHIFTS[index];
+        const auto mask = _mm_set_epi64x(static_cast<long long>(RIGHT_FILL_MASKS[index]),
+                                         static_cast<long long>(LEFT_FILL_MASKS[index]));
+        auto generators = _mm_set1_epi64x(
+            static_cast<long long>(index < 2 ? sliders.orthogonal : sliders.diagonal));
+        auto propagators = _mm_and_si128(empty, mask);
+        generators = _mm_or_si128(generators,
+                                  _mm_and_si128(propagators, shift_opposite(generators, count)));
+        propagators = _mm_and_si128(propagators, shift_opposite(propagators, count));
+        generators = _mm_or_si128(
+            generators, _mm_and_si128(propagators, shift_opposite(generators, 2 * count)));
+        propagators = _mm_and_si128(propagators, shift_opposite(propagators, 2 * count));
+        generators = _mm_or_si128(
+            generators, _mm_and_si128(propagators, shift_opposite(generators, 4 * count)));
+        attacks = _mm_or_si128(attacks,
+                               _mm_and_si128(shift_opposite(generators, count), mask));
+    }
+    return static_cast<std::uint64_t>(_mm_cvtsi128_si64(attacks))
+           | static_cast<std::uint64_t>(_mm_cvtsi128_si64(_mm_unpackhi_epi64(attacks, attacks)));
+}
+#else
+std::uint64_t get_slider_attacks_vector(const Sliders& sliders)
+{
+    return get_slider_attacks_scalar(sliders);
+}
+#endif
+
+std::uint64_t get_knight_attacks_setwise(std::uint64_t knights)
+{
+    const auto one_file = ((knights >> 1) & NOT_H_FILE) | ((knights << 1) & NOT_A_FILE);
+    const auto two_files = ((knights >> 2) & NOT_GH_FILES) | ((knights << 2) & NOT_AB_FILES);
+    return (one_file << 16) | (one_file >> 16) | (two_files << 8) | (two_files >> 8);
+}
+
+std::uint64_t get_pawn_attacks_setwise(std::uint64_t pawns, PieceColor pawn_color)
+{
+    if (pawn_color == PieceColor::WHITE)
+    {
+        return ((pawns << 7) & NOT_H_FILE) | ((pawns << 9) & NOT_A_FILE);
+    }
+    return ((pawns >> 9) & NOT_H_FILE) | ((pawns >> 7) & NOT_A_FILE);
+}
+
+template <typename SliderAttacks>
+SquareSet get_attacked_squares_with(const Board& board,
+                                    PieceColor by_color,
+                                    SliderAttacks&& get_slider_attacks)
+{
+    const auto pieces = [&board, by_color](PieceType piece_type)
+    { return board.get_pieces(by_color, piece_type).get_bits(); };
+    const auto queens = pieces(PieceType::QUEEN);
+    const Sliders sliders{pieces(PieceType::ROOK) | queens, pieces(PieceType::BISHOP) | queens,
+                          ~board.get_occupied_squares().get_bits()};
+    auto attacks = get_slider_attacks(sliders)
+                   | get_knight_attacks_setwise(pieces(PieceType::KNIGHT))
+                   | get_pawn_attacks_setwise(pieces(PieceType::PAWN), by_color);
+    if (const auto king_position = board.get_king_position(by_color))
+    {
+        attacks |= KING_ATTACK_MASKS[Square{*king_position}.get_index()];
+    }
+    return SquareSet{attacks};
+}
+}  // namespace
+
+SquareSet get_knight_attacks(Square square)
+{
+    return SquareSet{KNIGHT_ATTACK_MASKS[square.get_index()]};
+}
+
+SquareSet get_king_attacks(Square square)
+{
+    return SquareSet{KING_ATTACK_MASKS[square.get_index()]};
+}
+
+SquareSet get_pawn_attacks(Square square, PieceColor pawn_color)
+{
+    return SquareSet{PAWN_ATTACK_MASKS[to_index(pawn_color)][square.get_index()]};
+}
+
+SquareSet get_bishop_attacks(Square square, SquareSet occupancy)
+{
+    return get_slider_attacks(BISHOP_DIRECTIONS, square, occupancy);
+}
+
+SquareSet get_rook_attacks(Square square, SquareSet occupancy)
+{
+    return get_slider_attacks(ROOK_DIRECTIONS, square, occupancy);
+}
+
+SquareSet attackers_to(const Board& board, Square square, SquareSet occupancy)
+{
+    const auto queens = get_pieces(board, PieceType::QUEEN);
+    // a pawn attacks square if a pawn of the other color standing on square would attack it
+    return (get_pawn_attacks(square, PieceColor::BLACK)
+            & board.get_pieces(PieceColor::WHITE, PieceType::PAWN))
+           | (get_pawn_attacks(square, PieceColor::WHITE)
+              & board.get_pieces(PieceColor::BLACK, PieceType::PAWN))
+           | (get_knight_attacks(square) & get_pieces(board, PieceType::KNIGHT))
+           | (get_king_attacks(square) & get_pieces(board, PieceType::KING))
+           | (get_bishop_attacks(square, occupancy)
+              & (get_pieces(board, PieceType::BISHOP) | queens))
+           | (get_rook_attacks(square, occupancy) & (get_pieces(board, PieceType::ROOK) | queens));
+}
+
+bool is_square_attacked(const Board& board, Square square, PieceColor by_color)
+{
+    const auto pieces = [&board, by_color](PieceType piece_type)
+    { return board.get_pieces(by_color, piece_type); };
+    const auto queens = pieces(PieceType::QUEEN);
+    if (!(get_pawn_attacks(square, get_opposite_color(by_color)) & pieces(PieceType::PAWN)).empty()
+        || !(get_knight_attacks(square) & pieces(PieceType::KNIGHT)).empty()
+        || !(get_king_attacks(square) & pieces(PieceType::KING)).empty())
+    {
+        return true;
+    }
+    const auto occupancy = board.get_occupied_squares();
+    return !(get_bishop_attacks(square, occupancy) & (pieces(PieceType::BISHOP) | queens)).empty()
+           || !(get_rook_attacks(square, occupancy) & (pieces(PieceType::ROOK) | queens)).empty();
+}
+
+SquareSet get_attacked_squares(const Board& board, PieceColor by_color)
+{
+    CHESS_TIME_PHASE(ATTACK_SETS);
+    CHESS_COUNT(ATTACK_SET_BUILDS, 1);
+    return get_attacked_squares_with(board, by_color, get_slider_attacks_vector);
+}
+
+SquareSet get_attacked_squares_scalar(const Board& board, PieceColor by_color)
+{
+    return get_attacked_squares_with(board, by_color, get_slider_attacks_scalar);
+}
@@ -1,8 +1,19 @@
 #include <Board.hpp>
+#include <Instrumentation.hpp>
 #include <stdexcept>
 
 static constexpr std::int32_t BOARD_SIZE = 7;
 
+namespace
+{
+template <typename T>
+void visit_temporary_piece(PieceVisitor& visitor, PieceColor piece_color, const Position& position)
+{
+    T piece{piece_color, position};
+    visitor.visit(piece);
+}
+}  // namespace
+
 bool Board::is_piece_position_valid(const Position& piece_position)
 {
     return piece_position.x <= BOARD_SIZE && piece_position.x >= 0 && piece_position.y <= BOARD_SIZE
@@ -11,77 +22,121 @@ bool Board::is_piece_position_valid(const Position& piece_position)
 
 bool Board::add_piece(std::unique_ptr<Piece> piece)
 {
-    const auto& piece_position = piece->get_position();
-    if (!is_square_empty(piece_position))
+    return add_piece(piece->get_code(), piece->get_position());
+}
+
+bool Board::add_piece(PieceCode piece_code, const Position& position)
+{
+    if (!is_piece_position_valid(position) || !is_square_empty(position))
     {
         return false;
     }
-    m_board[piece_position.y][piece_position.x] = std::move(piece);
+    m_piece_codes[position.y][position.x] = piece_code;
+    toggle_masks(piece_code, Square{position});
     return true;
 }
 
 std::unique_ptr<Piece> Board::remove_piece(const Position& position)
 {
-    if (is_square_empty(position))
+    const auto piece_code = remove_piece_code(position);
+    if (piece_code.is_empty())
     {
         return nullptr;
     }
-    return std::move(m_board[position.y][position.x]);
+    return Piece::get_piece_from_type(piece_code.get_type(), piece_code.get_color(), position);
+}
+
+PieceCode Board::remove_piece_code(const Position& position)
+{
+    if (is_square_empty(position))
+    {
+        return {};
+    }
+    const auto piece_code = m_piece_codes[position.y][position.x];
+    m_piece_codes[position.y][position.x] = PieceCode{};
+    toggle_masks(piece_code, Square{position});
+    return piece_code;
 }
 
 bool Board::is_square_empty(const Position& position) const
 {
-    return !is_piece_position_valid(position) || !m_board[position.y][position.x];
+    return get_piece_code(position).is_empty();
 }
 
 void Board::clear_board()
 {
-    for (auto& row : m_board)
+    m_piece_codes = PieceCodeContainer{};
+    m_color_masks = {};
+    m_type_masks = {};
+}
+
+std::optional<Position> Board::get_king_position(PieceColor piece_color) const
+{
+    const auto kings = get_pieces(piece_color, PieceType::KING);
+    if (kings.empty())
     {
-        for (auto& piece_ptr : row)
-        {
-            piece_ptr.reset();
-        }
+        return std::nullopt;
     }
+    return *kings.begin();
+}
+
+void Board::toggle_masks(PieceCode piece_code, Square square)
+{
+    const auto mask = std::uint64_t{1} << square.get_index();
+    m_color_masks[to_index(piece_code.get_color())] ^= mask;
+    m_type_masks[static_cast<std::size_t>(piece_code.get_type())] ^= mask;
 }
 
 void Board::apply_piece_visitor(PieceVisitor& visitor)
 {
-    for (auto& row : m_board)
-    {
-        for (auto& piece_ptr : row)
+    for_each_piece(
+        [&visitor](PieceCode piece_code, const Position& position)
         {
-            if (piece_ptr)
+            const auto piece_color = piece_code.get_color();
+            switch (piece_code.get_type())
             {
-                piece_ptr->visit(visitor);
+            case PieceType::KING:
+                visit_temporary_piece<King>(visitor, piece_color, position);
+                break;
+            case PieceType::QUEEN:
+                visit_temporary_piece<Queen>(visitor, piece_color, position);
+                break;
+            case PieceType::BISHOP:
+                visit_temporary_piece<Bishop>(visitor, piece_color, position);
+                break;
+            case PieceType::KNIGHT:
+                visit_temporary_piece<Knight>(visitor, piece_color, position);
+                break;
+            case PieceType::ROOK:
+                visit_temporary_piece<Rook>(visitor, piece_color, position);
+                break;
+            case PieceType::PAWN:
+                visit_temporary_piece<Pawn>(visitor, piece_color, position);
+                break;
             }
-        }
-    }
+        });
 }
 
-const Piece& Board::get_piece_at_position(const Position& position) const
+PieceCode Board::get_piece_at_position(const Position& position) const
 {
     if (is_square_empty(position))
     {
         throw std::logic_error("No piece at given position");
     }
-    return *m_board[position.y][position.x];
+    return m_piece_codes[position.y][position.x];
 }
 
-Board Board::clone() const
+PieceCode Board::get_piece_code(const Position& position) const
 {
-    Board cloned_board;
-    for (auto& row : m_board)
+    if (!is_piece_position_valid(position))
     {
-        for (auto& piece_ptr : row)
-        {
-            if (piece_ptr)
-            {
-                cloned_board.m_board[piece_ptr->get_position().y][piece_ptr->get_position().x]
-                    = Piece::get_piece_from_type(piece_ptr->get_type(), piece_ptr->get_color(),
-                                                 piece_ptr->get_position());
-            }
-        }
+        return {};
     }
-    return cloned_board;
-}
\ No newline at end of file
+    return m_piece_codes[position.y][position.x];
+}
+
+Board Board::clone() const
+{
+    CHESS_COUNT(BOARD_COPIES, 1);
+    return *this;
+}
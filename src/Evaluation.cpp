@@ -0,0 +1,44 @@
+#include <Evaluation.hpp>
+#include <EvaluationParameters.hpp>
+
+namespace
+{
+std::int32_t evaluate_color(const Board& board, PieceColor color)
+{
+    std::int32_t score = 0;
+    for (const auto piece_type : {PieceType::KING, PieceType::QUEEN, PieceType::BISHOP,
+                                  PieceType::KNIGHT, PieceType::ROOK, PieceType::PAWN})
+    {
+        const auto type_index = static_cast<std::size_t>(piece_type);
+        const auto pieces = board.get_pieces(color, piece_type);
+        score += EVALUATION_PIECE_VALUES[type_index] * static_cast<std::int32_t>(pieces.size());
+        for (auto it = pieces.begin(); it != pieces.end(); ++it)
+        {
+            const auto square_index = get_piece_square_index(it.get_square(), color);
+            score += EVALUATION_PIECE_SQUARE_TABLES[type_index][square_index];
+        }
+    }
+    if (board.get_pieces(color, PieceType::BISHOP).size() >= 2)
+    {
+        score += EVALUATION_BISHOP_PAIR_BONUS;
+    }
+    return score;
+}
+}  // namespace
+
+std::size_t get_piece_square_index(Square square, PieceColor color)
+{
+    const auto index = square.get_index();
+    return color == PieceColor::WHITE ? index ^ 56u : index;
+}
+
+std::int32_t evaluate(const Board& board)
+{
+    return evaluate_color(board, PieceColor::WHITE) - evaluate_color(board, PieceColor::BLACK);
+}
+
+std::int32_t evaluate(const PositionState& position)
+{
+    const auto score = evaluate(position.get_board());
+    return position.get_side_to_move() == PieceColor::WHITE ? score : -score;
+}
@@ -0,0 +1,290 @@
+#include <GameSessionManager.hpp>
+#include <Zobrist.hpp>
+#include <algorithm>
+
+namespace
+{
+constexpr std::uint32_t SLOT_BITS = 32;
+
+GameResult get_win_for(PieceColor color)
+{
+    return color == PieceColor::WHITE ? GameResult::WHITE_WON : GameResult::BLACK_WON;
+}
+}  // namespace
+
+const char* to_c_str(GameEndReason end_reason)
+{
+    switch (end_reason)
+    {
+    case GameEndReason::NONE:
+        return "none";
+    case GameEndReason::CHECKMATE:
+        return "checkmate";
+    case GameEndReason::STALEMATE:
+        return "stalemate";
+    case GameEndReason::FIFTY_MOVE_RULE:
+        return "fifty move rule";
+    case GameEndReason::THREEFOLD_REPETITION:
+        return "threefold repetition";
+    case GameEndReason::INSUFFICIENT_MATERIAL:
+        return "insufficient material";
+    case GameEndReason::TIME_FORFEIT:
+        return "time forfeit";
+    case GameEndReason::TIMEOUT_VS_INSUFFICIENT_MATERIAL:
+        return "timeout vs insufficient material";
+    case GameEndReason::MOVE_LIMIT:
+        return "move limit";
+    default:
+        return "error";
+    };
+}
+
+const char* to_c_str(MoveStatus status)
+{
+    switch (status)
+    {
+    case MoveStatus::ACCEPTED:
+        return "accepted";
+    case MoveStatus::UNKNOWN_SESSION:
+        return "unknown session";
+    case MoveStatus::GAME_OVER:
+        return "game over";
+    case MoveStatus::ILLEGAL_MOVE:
+        return "illegal move";
+    case MoveStatus::TIME_FORFEIT:
+        return "time forfeit";
+    default:
+        return "error";
+    };
+}
+
+GameSessionManager::GameSessionManager(std::size_t shard_count)
+    : m_shards(std::max<std::size_t>(1, shard_count))
+{
+}
+
+SessionId GameSessionManager::create_session(const PositionState& position,
+                                             const TimeControl& time_control,
+                                             std::uint32_t halfmove_clock)
+{
+    const auto shard_index = m_next_shard++ % m_shards.size();
+    auto& shard = m_shards[shard_index];
+    std::lock_guard lock{shard.mutex};
+    std::size_t slot;
+    if (shard.free_slots.empty())
+    {
+        slot = shard.states.size();
+        shard.states.emplace_back();
+        shard.clocks.emplace_back();
+        shard.key_histories.emplace_back();
+    }
+    else
+    {
+        slot = shard.free_slots.back();
+        shard.free_slots.pop_back();
+    }
+
+    auto& state = shard.states[slot];
+    state.position = position;
+    state.key = get_zobrist_key(position);
+    state.halfmove_clock = std::min(halfmove_clock, FIFTY_MOVE_RULE_PLIES);
+    state.ply_count = 0;
+    ++state.generation;
+    state.result = GameResult::UNKNOWN;
+    state.end_reason = GameEndReason::NONE;
+    state.is_open = true;
+
+    auto& clocks = shard.clocks[slot];
+    clocks.remaining_time = {time_control.initial_time, time_control.initial_time};
+    clocks.increment = time_control.increment;
+    clocks.is_timed = time_control.initial_time.count() > 0;
+
+    auto& key_history = shard.key_histories[slot];
+    key_history.keys[0] = state.key;
+    key_history.size = 1;
+
+    update_game_end(state, key_history);
+    ++shard.open_count;
+    return (static_cast<SessionId>(state.generation) << SLOT_BITS)
+           | (slot * m_shards.size() + shard_index);
+}
+
+bool GameSessionManager::close_session(SessionId id)
+{
+    auto& shard = m_shards[get_shard_index(id)];
+    std::lock_guard lock{shard.mutex};
+    const auto slot = find_slot(shard, id);
+    if (!slot)
+    {
+        return false;
+    }
+    shard.states[*slot].is_open = false;
+    shard.free_slots.push_back(static_cast<std::uint32_t>(*slot));
+    --shard.open_count;
+    return true;
+}
+
+MoveStatus GameSessionManager::make_move(SessionId id,
+                                         const Position& from,
+                                         const Position& to,
+                                         std::optional<PromotablePieceType> promotion,
+                                         std::chrono::milliseconds elapsed)
+{
+    auto& shard = m_shards[get_shard_index(id)];
+    std::lock_guard lock{shard.mutex};
+    const auto slot = find_slot(shard, id);
+    if (!slot)
+    {
+        return MoveStatus::UNKNOWN_SESSION;
+    }
+    auto& state = shard.states[*slot];
+    auto& clocks = shard.clocks[*slot];
+    auto& key_history = shard.key_histories[*slot];
+    if (state.result != GameResult::UNKNOWN)
+    {
+        return MoveStatus::GAME_OVER;
+    }
+
+    auto& position = state.position;
+    const auto color = position.get_side_to_move();
+    auto& remaining_time = clocks.remaining_time[to_index(color)];
+    if (clocks.is_timed && elapsed >= remaining_time)
+    {
+        remaining_time = std::chrono::milliseconds{0};
+        const auto opposite_color = get_opposite_color(color);
+        if (can_checkmate(position.get_board(), opposite_color))
+        {
+            state.result = get_win_for(opposite_color);
+            state.end_reason = GameEndReason::TIME_FORFEIT;
+        }
+        else
+        {
+            state.result = GameResult::DRAW;
+            state.end_reason = GameEndReason::TIMEOUT_VS_INSUFFICIENT_MATERIAL;
+        }
+        return MoveStatus::TIME_FORFEIT;
+    }
+    if (!position.is_move_legal(from, to, promotion))
+    {
+        return MoveStatus::ILLEGAL_MOVE;
+    }
+    if (clocks.is_timed)
+    {
+        remaining_time += clocks.increment - elapsed;
+    }
+
+    const auto move = position.create_move(from, to, promotion);
+    const auto& board = position.get_board();
+    const auto is_irreversible = move.type == MoveType::EN_PASSANT || !board.is_square_empty(to)
+                                 || board.get_piece_code(from).get_type() == PieceType::PAWN;
+    const auto key_delta = get_zobrist_state_key(position)
+                           ^ get_zobrist_pieces_delta(position, move);
+    position.make_move(move);
+    state.key ^= key_delta ^ get_zobrist_state_key(position);
+    ++state.ply_count;
+    state.halfmove_clock = is_irreversible ? 0 : state.halfmove_clock + 1;
+    // halfmove clock never passes the fifty move rule, so neither does the history
+    key_history.size = is_irreversible ? 0 : key_history.size;
+    key_history.keys[key_history.size++] = state.key;
+
+    update_game_end(state, key_history);
+    return MoveStatus::ACCEPTED;
+}
+
+std::optional<SessionSnapshot> GameSessionManager::get_snapshot(SessionId id) const
+{
+    const auto& shard = m_shards[get_shard_index(id)];
+    std::lock_guard lock{shard.mutex};
+    const auto slot = find_slot(shard, id);
+    if (!slot)
+    {
+        return std::nullopt;
+    }
+    const auto& state = shard.states[*slot];
+    return SessionSnapshot{state.position,   state.halfmove_clock, state.ply_count,
+                           shard.clocks[*slot], state.result,        state.end_reason};
+}
+
+bool GameSessionManager::generate_legal_moves(SessionId id, std::vector<Move>& moves) const
+{
+    moves.clear();
+    // copied out of the shard so move generation doesn't hold the lock
+    auto snapshot = get_snapshot(id);
+    if (!snapshot)
+    {
+        return false;
+    }
+    if (snapshot->result == GameResult::UNKNOWN)
+    {
+        snapshot->position.generate_legal_moves(moves);
+    }
+    return true;
+}
+
+std::size_t GameSessionManager::get_session_count() const
+{
+    std::size_t session_count = 0;
+    for (const auto& shard : m_shards)
+    {
+        std::lock_guard lock{shard.mutex};
+        session_count += shard.open_count;
+    }
+    return session_count;
+}
+
+std::size_t GameSessionManager::get_shard_index(SessionId id) const
+{
+    return (id & ((SessionId{1} << SLOT_BITS) - 1)) % m_shards.size();
+}
+
+std::optional<std::size_t> GameSessionManager::find_slot(const Shard& shard, SessionId id) const
+{
+    const auto slot = (id & ((SessionId{1} << SLOT_BITS) - 1)) / m_shards.size();
+    if (slot >= shard.states.size())
+    {
+        return std::nullopt;
+    }
+    const auto& state = shard.states[slot];
+    if (!state.is_open || state.generation != (id >> SLOT_BITS))
+    {
+        return std::nullopt;
+    }
+    return slot;
+}
+
+void GameSessionManager::update_game_end(SessionState& state, const KeyHistory& key_history)
+{
+    auto& position = state.position;
+    if (!position.has_any_legal_move())
+    {
+        const auto is_checkmate = position.is_in_check();
+        state.result = is_checkmate ? get_win_for(get_opposite_color(position.get_side_to_move()))
+                                    : GameResult::DRAW;
+        state.end_reason = is_checkmate ? GameEndReason::CHECKMATE : GameEndReason::STALEMATE;
+        return;
+    }
+
+    // the same side is to move only every second ply and no position can repeat in two plies
+    std::size_t occurrences = 1;
+    for (std::size_t plies_back = 4; plies_back < key_history.size; plies_back += 2)
+    {
+        if (key_history.keys[key_history.size - 1 - plies_back] == state.key)
+        {
+            ++occurrences;
+        }
+    }
+    if (state.halfmove_clock >= FIFTY_MOVE_RULE_PLIES)
+    {
+        state.end_reason = GameEndReason::FIFTY_MOVE_RULE;
+    }
+    else if (occurrences >= 3)
+    {
+        state.end_reason = GameEndReason::THREEFOLD_REPETITION;
+    }
+    else if (is_insufficient_material(position.get_board()))
+    {
+        state.end_reason = GameEndReason::INSUFFICIENT_MATERIAL;
+    }
+    state.result = state.end_reason == GameEndReason::NONE ? GameResult::UNKNOWN
+                                                           : GameResult::DRAW;
+}
@@ -0,0 +1,216 @@
+#include <GameState.hpp>
+#include <Zobrist.hpp>
+#include <algorithm>
+#include <charconv>
+#include <stdexcept>
+
+namespace
+{
+constexpr std::uint32_t FIFTY_MOVE_RULE_PLIES = 100;
+constexpr std::uint64_t DARK_SQUARES = 0xAA55AA55AA55AA55;
+
+std::uint32_t parse_halfmove_clock(std::string_view fen)
+{
+    for (std::size_t field_index = 0; field_index != 4; ++field_index)
+    {
+        const auto field_start = fen.find_first_not_of(' ');
+        const auto field_end = fen.find(' ', field_start);
+        fen.remove_prefix(std::min(field_end, fen.size()));
+    }
+    const auto field_start = fen.find_first_not_of(' ');
+    if (field_start == std::string_view::npos)
+    {
+        return 0;
+    }
+    fen.remove_prefix(field_start);
+    const auto field = fen.substr(0, std::min(fen.find(' '), fen.size()));
+    std::uint32_t halfmove_clock = 0;
+    const auto [end, error] = std::from_chars(field.data(), field.data() + field.size(),
+                                              halfmove_clock);
+    if (error != std::errc{} || end != field.data() + field.size())
+    {
+        throw std::invalid_argument("FEN halfmove clock is not a number");
+    }
+    return halfmove_clock;
+}
+}  // namespace
+
+const char* to_c_str(DrawReason draw_reason)
+{
+    switch (draw_reason)
+    {
+    case DrawReason::NONE:
+        return "none";
+    case DrawReason::FIFTY_MOVE_RULE:
+        return "fifty move rule";
+    case DrawReason::THREEFOLD_REPETITION:
+        return "threefold repetition";
+    case DrawReason::INSUFFICIENT_MATERIAL:
+        return "insufficient material";
+    default:
+        return "error";
+    };
+}
+
+GameState::GameState(PositionState position, std::uint32_t halfmove_clock)
+    : m_position{std::move(position)}
+    , m_key{get_zobrist_key(m_position)}
+    , m_halfmove_clock{halfmove_clock}
+{
+}
+
+GameState GameState::get_starting_position()
+{
+    return GameState{PositionState::get_starting_position()};
+}
+
+GameState GameState::from_fen(std::string_view fen)
+{
+    return GameState{PositionState::from_fen(fen), parse_halfmove_clock(fen)};
+}
+
+PositionState& GameState::get_position()
+{
+    return m_position;
+}
+
+const PositionState& GameState::get_position() const
+{
+    return m_position;
+}
+
+std::uint64_t GameState::get_key() const
+{
+    return m_key;
+}
+
+std::uint32_t GameState::get_halfmove_clock() const
+{
+    return m_halfmove_clock;
+}
+
+std::size_t GameState::get_ply_count() const
+{
+    return m_history.size();
+}
+
+void GameState::make_move(const Move& move)
+{
+    const auto& board = m_position.get_board();
+    const auto piece_type = board.get_piece_at_position(move.from).get_type();
+    const auto is_capture = move.type == MoveType::EN_PASSANT || !board.is_square_empty(move.to);
+
+    const auto key_delta = get_zobrist_state_key(m_position)
+                           ^ get_zobrist_pieces_delta(m_position, move);
+    auto undo_info = m_position.make_move(move);
+    m_history.push_back({move, std::move(undo_info), m_key, m_halfmove_clock});
+    m_key ^= key_delta ^ get_zobrist_state_key(m_position);
+    m_halfmove_clock = (is_capture || piece_type == PieceType::PAWN) ? 0 : m_halfmove_clock + 1;
+}
+
+void GameState::unmake_move()
+{
+    if (m_history.empty())
+    {
+        throw std::logic_error("there is no move to undo");
+    }
+    const auto& entry = m_history.back();
+    m_position.unmake_move(entry.move, entry.undo_info);
+    m_key = entry.key;
+    m_halfmove_clock = entry.halfmove_clock;
+    m_history.pop_back();
+}
+
+std::size_t GameState::count_repetitions() const
+{
+    // the same side is to move only every second ply and no position can repeat in two plies
+    const auto history_size = m_history.size();
+    const auto scan_limit = std::min<std::size_t>(m_halfmove_clock, history_size);
+    std::size_t repetitions = 0;
+    for (std::size_t plies_back = 4; plies_back <= scan_limit; plies_back += 2)
+    {
+        if (m_history[history_size - plies_back].key == m_key)
+        {
+            ++repetitions;
+        }
+    }
+    return repetitions;
+}
+
+bool GameState::is_repetition() const
+{
+    return count_repetitions() >= 1;
+}
+
+bool GameState::is_threefold_repetition() const
+{
+    return count_repetitions() >= 2;
+}
+
+bool GameState::is_fifty_move_rule_draw() const
+{
+    return m_halfmove_clock >= FIFTY_MOVE_RULE_PLIES;
+}
+
+bool GameState::is_insufficient_material() const
+{
+    return ::is_insufficient_material(m_position.get_board());
+}
+
+DrawReason GameState::get_draw_reason() const
+{
+    if (is_fifty_move_rule_draw())
+    {
+        return DrawReason::FIFTY_MOVE_RULE;
+    }
+    if (is_threefold_repetition())
+    {
+        return DrawReason::THREEFOLD_REPETITION;
+    }
+    if (is_insufficient_material())
+    {
+        return DrawReason::INSUFFICIENT_MATERIAL;
+    }
+    return DrawReason::NONE;
+}
+
+bool can_checkmate(const Board& board, PieceColor color)
+{
+    const auto opposite_color = get_opposite_color(color);
+    const auto get_bits = [&board](PieceColor piece_color, PieceType piece_type) {
+        return board.get_pieces(piece_color, piece_type).get_bits();
+    };
+    if ((get_bits(color, PieceType::PAWN) | get_bits(color, PieceType::ROOK)
+         | get_bits(color, PieceType::QUEEN))
+        != 0)
+    {
+        return true;
+    }
+    const auto knights = SquareSet{get_bits(color, PieceType::KNIGHT)}.size();
+    const auto bishops = get_bits(PieceColor::WHITE, PieceType::BISHOP)
+                         | get_bits(PieceColor::BLACK, PieceType::BISHOP);
+    if (knights != 0)
+    {
+        // a lone knight mates only with help of a piece blocking the king, queens never can
+        const auto blockers = get_bits(opposite_color, PieceType::PAWN)
+                              | get_bits(opposite_color, PieceType::KNIGHT)
+                              | get_bits(opposite_color, PieceType::BISHOP)
+                              | get_bits(opposite_color, PieceType::ROOK);
+        return knights > 1 || get_bits(color, PieceType::BISHOP) != 0 || blockers != 0;
+    }
+    if (get_bits(color, PieceType::BISHOP) == 0)
+    {
+        return false;
+    }
+    // bishops all on one square color never attack the other one, a mate then needs a blocker
+    // that isn't a bishop of the same square color
+    const auto is_same_square_color
+        = (bishops & DARK_SQUARES) == 0 || (bishops & ~DARK_SQUARES) == 0;
+    return !is_same_square_color || get_bits(opposite_color, PieceType::PAWN) != 0
+           || get_bits(opposite_color, PieceType::KNIGHT) != 0;
+}
+
+bool is_insufficient_material(const Board& board)
+{
+    return !can_checkmate(board, PieceColor::WHITE) && !can_checkmate(board, PieceColor::BLACK);
+}
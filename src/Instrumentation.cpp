@@ -0,0 +1,195 @@
+#include <Instrumentation.hpp>
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+
+namespace detail
+{
+thread_local InstrumentationStats thread_instrumentation_stats;
+}  // namespace detail
+
+#ifdef CHESS_ENABLE_INSTRUMENTATION
+namespace
+{
+void count_allocation(std::size_t size)
+{
+    auto& stats = detail::thread_instrumentation_stats;
+    ++stats.allocations;
+    stats.allocated_bytes += size;
+}
+}  // namespace
+
+// libstdc++ forwards the nothrow forms to these, the aligned forms for over-aligned types such as
+// the shards of GameSessionManager call aligned_alloc on their own and are replaced as well
+void* operator new(std::size_t size)
+{
+    count_allocation(size);
+    if (auto* memory = std::malloc(size == 0 ? 1 : size))
+    {
+        return memory;
+    }
+    throw std::bad_alloc{};
+}
+
+void* operator new[](std::size_t size)
+{
+    return operator new(size);
+}
+
+void* operator new(std::size_t size, std::align_val_t alignment)
+{
+    count_allocation(size);
+    const auto alignment_size = static_cast<std::size_t>(alignment);
+    // aligned_alloc wants size to be a multiple of alignment
+    const auto aligned_size = (std::max<std::size_t>(size, 1) + alignment_size - 1)
+                              / alignment_size * alignment_size;
+    if (auto* memory = std::aligned_alloc(alignment_size, aligned_size))
+    {
+        return memory;
+    }
+    throw std::bad_alloc{};
+}
+
+void* operator new[](std::size_t size, std::align_val_t alignment)
+{
+    return operator new(size, alignment);
+}
+
+void operator delete(void* memory) noexcept
+{
+    std::free(memory);
+}
+
+void operator delete[](void* memory) noexcept
+{
+    std::free(memory);
+}
+
+void operator delete(void* memory, std::size_t) noexcept
+{
+    std::free(memory);
+}
+
+void operator delete[](void* memory, std::size_t) noexcept
+{
+    std::free(memory);
+}
+
+void operator delete(void* memory, std::align_val_t) noexcept
+{
+    std::free(memory);
+}
+
+void operator delete[](void* memory, std::align_val_t) noexcept
+{
+    std::free(memory);
+}
+
+void operator delete(void* memory, std::size_t, std::align_val_t) noexcept
+{
+    std::free(memory);
+}
+
+void operator delete[](void* memory, std::size_t, std::align_val_t) noexcept
+{
+    std::free(memory);
+}
+#endif
+
+namespace
+{
+void append_number(std::string& json, std::uint64_t value)
+{
+    json.append(std::to_string(value));
+}
+
+void append_average(std::string& json, std::uint64_t total, std::uint64_t calls)
+{
+    std::array<char, 32> buffer;
+    const auto average = calls == 0 ? 0.0 : static_cast<double>(total) / calls;
+    std::snprintf(buffer.data(), buffer.size(), "%.2f", average);
+    json.append(buffer.data());
+}
+}  // namespace
+
+const char* to_c_str(Counter counter)
+{
+    switch (counter)
+    {
+    case Counter::RAW_MOVES:
+        return "raw_moves";
+    case Counter::LEGALITY_CHECKS:
+        return "legality_checks";
+    case Counter::BOARD_COPIES:
+        return "board_copies";
+    case Counter::ATTACK_SET_BUILDS:
+        return "attack_set_builds";
+    default:
+        return "unknown";
+    }
+}
+
+const char* to_c_str(Phase phase)
+{
+    switch (phase)
+    {
+    case Phase::GENERATE_MOVES:
+        return "generate_moves";
+    case Phase::NORMAL_MOVES:
+        return "normal_moves";
+    case Phase::SPECIAL_MOVES:
+        return "special_moves";
+    case Phase::ATTACK_SETS:
+        return "attack_sets";
+    default:
+        return "unknown";
+    }
+}
+
+const InstrumentationStats& get_thread_instrumentation_stats()
+{
+    return detail::thread_instrumentation_stats;
+}
+
+void reset_thread_instrumentation_stats()
+{
+    detail::thread_instrumentation_stats = {};
+}
+
+std::string to_json(const InstrumentationStats& stats)
+{
+    std::string json = "{\"enabled\":";
+    json.append(is_instrumentation_enabled() ? "true" : "false");
+    json.append(",\"counters\":{");
+    for (std::size_t counter = 0; counter != COUNTER_COUNT; ++counter)
+    {
+        json.append(counter == 0 ? "\"" : ",\"");
+        json.append(to_c_str(static_cast<Counter>(counter)));
+        json.append("\":");
+        append_number(json, stats.counters[counter]);
+    }
+    json.append("},\"phases\":{");
+    for (std::size_t phase = 0; phase != PHASE_COUNT; ++phase)
+    {
+        json.append(phase == 0 ? "\"" : ",\"");
+        json.append(to_c_str(static_cast<Phase>(phase)));
+        json.append("\":{\"calls\":");
+        append_number(json, stats.phase_calls[phase]);
+        json.append(",\"cycles\":");
+        append_number(json, stats.phase_cycles[phase]);
+        json.append(",\"allocations\":");
+        append_number(json, stats.phase_allocations[phase]);
+        json.append(",\"cycles_per_call\":");
+        append_average(json, stats.phase_cycles[phase], stats.phase_calls[phase]);
+        json.append(",\"allocations_per_call\":");
+        append_average(json, stats.phase_allocations[phase], stats.phase_calls[phase]);
+        json.append("}");
+    }
+    json.append("},\"allocations\":");
+    append_number(json, stats.allocations);
+    json.append(",\"allocated_bytes\":");
+    append_number(json, stats.allocated_bytes);
+    json.append("}");
+    return json;
+}
@@ -0,0 +1,81 @@
+#include <MappedFile.hpp>
+#include <fcntl.h>
+#include <stdexcept>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <utility>
+
+MappedFile::MappedFile(const std::string& path)
+{
+    const auto file_descriptor = ::open(path.c_str(), O_RDONLY);
+    if (file_descriptor < 0)
+    {
+        throw std::runtime_error("Can't open file " + path);
+    }
+    struct stat file_stat;
+    if (::fstat(file_descriptor, &file_stat) != 0)
+    {
+        ::close(file_descriptor);
+        throw std::runtime_error("Can't stat file " + path);
+    }
+    m_size = static_cast<std::size_t>(file_stat.st_size);
+    if (m_size != 0)
+    {
+        m_data = ::mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, file_descriptor, 0);
+    }
+    ::close(file_descriptor);
+    if (m_data == MAP_FAILED)
+    {
+        m_data = nullptr;
+        m_size = 0;
+        throw std::runtime_error("Can't map file " + path);
+    }
+}
+
+MappedFile::MappedFile(MappedFile&& other) noexcept
+    : m_data(std::exchange(other.m_data, nullptr))
+    , m_size(std::exchange(other.m_size, 0))
+{
+}
+
+MappedFile& MappedFile::operator=(MappedFile&& other) noexcept
+{
+    if (this != &other)
+    {
+        unmap();
+        m_data = std::exchange(other.m_data, nullptr);
+        m_size = std::exchange(other.m_size, 0);
+    }
+    return *this;
+}
+
+MappedFile::~MappedFile()
+{
+    unmap();
+}
+
+void MappedFile::unmap()
+{
+    if (m_data)
+    {
+        ::munmap(m_data, m_size);
+        m_data = nullptr;
+        m_size = 0;
+    }
+}
+
+const std::byte* MappedFile::get_data() const
+{
+    return static_cast<const std::byte*>(m_data);
+}
+
+std::size_t MappedFile::get_size() const
+{
+    return m_size;
+}
+
+std::string_view MappedFile::get_view() const
+{
+    return {static_cast<const char*>(m_data), m_size};
+}
@@ -0,0 +1,353 @@
+#include <Match.hpp>
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <limits>
+#include <mutex>
+#include <sstream>
+#include <stdexcept>
+#include <thread>
+
+namespace
+{
+constexpr double CONFIDENCE_95_Z = 1.959964;
+/**
+ * @brief random lines tried for a pair before its opening is played without them, only an
+ *  opening that is mate or stalemate in fewer than random_plies plies runs out of them
+ */
+constexpr std::size_t MAX_RANDOM_LINE_ATTEMPTS = 100;
+
+GameEndReason to_end_reason(DrawReason draw_reason)
+{
+    switch (draw_reason)
+    {
+    case DrawReason::FIFTY_MOVE_RULE:
+        return GameEndReason::FIFTY_MOVE_RULE;
+    case DrawReason::THREEFOLD_REPETITION:
+        return GameEndReason::THREEFOLD_REPETITION;
+    case DrawReason::INSUFFICIENT_MATERIAL:
+        return GameEndReason::INSUFFICIENT_MATERIAL;
+    default:
+        return GameEndReason::NONE;
+    }
+}
+
+double score_to_elo(double score)
+{
+    if (score <= 0.0)
+    {
+        return -std::numeric_limits<double>::infinity();
+    }
+    if (score >= 1.0)
+    {
+        return std::numeric_limits<double>::infinity();
+    }
+    return -400.0 * std::log10(1.0 / score - 1.0);
+}
+
+double elo_to_score(double elo)
+{
+    return 1.0 / (1.0 + std::pow(10.0, -elo / 400.0));
+}
+
+/**
+ * @brief variance of the points of a single game
+ */
+double get_score_variance(const MatchScore& score)
+{
+    const auto mean = score.get_score();
+    const auto game_count = static_cast<double>(score.get_game_count());
+    return (score.wins * (1.0 - mean) * (1.0 - mean) + score.draws * (0.5 - mean) * (0.5 - mean)
+            + score.losses * mean * mean)
+           / game_count;
+}
+
+bool is_number(const std::string& field)
+{
+    return !field.empty()
+           && std::all_of(field.begin(), field.end(),
+                          [](char field_char) { return std::isdigit(field_char) != 0; });
+}
+}  // namespace
+
+PlayedGame play_game(GameState game,
+                     const SearchLimits& white_limits,
+                     const SearchLimits& black_limits,
+                     std::uint32_t max_plies,
+                     const std::atomic<bool>& stop_requested,
+                     const SearchedMoveCallback& on_move_searched)
+{
+    PlayedGame played;
+    while (true)
+    {
+        auto& position = game.get_position();
+        const auto side_to_move = position.get_side_to_move();
+        if (!position.has_any_legal_move())
+        {
+            const auto is_checkmate = position.is_in_check();
+            played.result = !is_checkmate                          ? GameResult::DRAW
+                            : side_to_move == PieceColor::WHITE ? GameResult::BLACK_WON
+                                                                : GameResult::WHITE_WON;
+            played.end_reason = is_checkmate ? GameEndReason::CHECKMATE : GameEndReason::STALEMATE;
+            return played;
+        }
+        if (const auto draw_reason = game.get_draw_reason(); draw_reason != DrawReason::NONE)
+        {
+            played.result = GameResult::DRAW;
+            played.end_reason = to_end_reason(draw_reason);
+            return played;
+        }
+        if (played.ply_count == max_plies)
+        {
+            played.result = GameResult::DRAW;
+            played.end_reason = GameEndReason::MOVE_LIMIT;
+            return played;
+        }
+
+        const auto& limits = side_to_move == PieceColor::WHITE ? white_limits : black_limits;
+        const auto result = search(game, limits, stop_requested);
+        if (stop_requested || !result.best_move)
+        {
+            return {};
+        }
+        if (on_move_searched)
+        {
+            on_move_searched(game, result);
+        }
+        game.make_move(*result.best_move);
+        ++played.ply_count;
+    }
+}
+
+std::uint64_t MatchScore::get_game_count() const
+{
+    return wins + draws + losses;
+}
+
+double MatchScore::get_score() const
+{
+    const auto game_count = get_game_count();
+    return game_count == 0 ? 0.5 : (wins + 0.5 * draws) / game_count;
+}
+
+EloEstimate estimate_elo(const MatchScore& score)
+{
+    const auto game_count = score.get_game_count();
+    if (game_count == 0)
+    {
+        return {};
+    }
+    const auto mean = score.get_score();
+    if (mean <= 0.0 || mean >= 1.0)
+    {
+        return {score_to_elo(mean), std::numeric_limits<double>::infinity()};
+    }
+    const auto error = CONFIDENCE_95_Z * std::sqrt(get_score_variance(score) / game_count);
+    return {score_to_elo(mean), (score_to_elo(mean + error) - score_to_elo(mean - error)) / 2};
+}
+
+const char* to_c_str(SprtDecision decision)
+{
+    switch (decision)
+    {
+    case SprtDecision::CONTINUE:
+        return "continue";
+    case SprtDecision::ACCEPT_H0:
+        return "H0 accepted";
+    case SprtDecision::ACCEPT_H1:
+        return "H1 accepted";
+    default:
+        return "error";
+    };
+}
+
+double get_sprt_llr(const MatchScore& score, const SprtParameters& parameters)
+{
+    const auto game_count = static_cast<double>(score.get_game_count());
+    if (game_count == 0)
+    {
+        return 0.0;
+    }
+    // outcomes not seen yet count as half a game each, a clean sweep has no variance otherwise
+    const auto regularize = [](std::uint64_t count) { return count == 0 ? 0.5 : count; };
+    const auto wins = regularize(score.wins);
+    const auto draws = regularize(score.draws);
+    const auto losses = regularize(score.losses);
+    const auto total = wins + draws + losses;
+    const auto mean = (wins + 0.5 * draws) / total;
+    const auto variance = (wins * (1.0 - mean) * (1.0 - mean) + draws * (0.5 - mean) * (0.5 - mean)
+                           + losses * mean * mean)
+                          / total;
+    const auto score0 = elo_to_score(parameters.elo0);
+    const auto score1 = elo_to_score(parameters.elo1);
+    return (score1 - score0) * (2 * mean - score0 - score1) / (2 * variance / game_count);
+}
+
+double get_sprt_lower_bound(const SprtParameters& parameters)
+{
+    return std::log(parameters.beta / (1 - parameters.alpha));
+}
+
+double get_sprt_upper_bound(const SprtParameters& parameters)
+{
+    return std::log((1 - parameters.beta) / parameters.alpha);
+}
+
+SprtDecision get_sprt_decision(const MatchScore& score, const SprtParameters& parameters)
+{
+    const auto llr = get_sprt_llr(score, parameters);
+    if (llr <= get_sprt_lower_bound(parameters))
+    {
+        return SprtDecision::ACCEPT_H0;
+    }
+    if (llr >= get_sprt_upper_bound(parameters))
+    {
+        return SprtDecision::ACCEPT_H1;
+    }
+    return SprtDecision::CONTINUE;
+}
+
+bool play_random_plies(GameState& game, std::uint32_t ply_count, std::mt19937& random)
+{
+    std::vector<Move> moves;
+    for (std::uint32_t ply = 0; ply != ply_count; ++ply)
+    {
+        game.get_position().generate_legal_moves(moves);
+        if (moves.empty())
+        {
+            return false;
+        }
+        game.make_move(moves[random() % moves.size()]);
+    }
+    return true;
+}
+
+MatchScore run_match(const std::vector<std::string>& opening_fens,
+                     const MatchConfig& config,
+                     const MatchGameCallback& on_game_finished)
+{
+    if (opening_fens.empty())
+    {
+        throw std::invalid_argument("Match needs at least one opening");
+    }
+    std::vector<GameState> openings;
+    openings.reserve(opening_fens.size());
+    for (const auto& fen : opening_fens)
+    {
+        openings.push_back(GameState::from_fen(fen));
+    }
+
+    // both games of a pair replay the random line from a generator seeded for the pair
+    const auto get_pair_start = [&config](const GameState& opening, std::size_t pair_index) {
+        std::seed_seq seed{config.seed, static_cast<std::uint32_t>(pair_index)};
+        std::mt19937 random{seed};
+        for (std::size_t attempt = 0; attempt != MAX_RANDOM_LINE_ATTEMPTS; ++attempt)
+        {
+            auto game = opening;
+            if (play_random_plies(game, config.random_plies, random))
+            {
+                return game;
+            }
+        }
+        return opening;
+    };
+
+    MatchScore score;
+    std::mutex score_mutex;
+    std::atomic<std::size_t> next_game_index{0};
+    std::atomic<bool> stop_requested{false};
+    const auto play_games = [&] {
+        while (!stop_requested)
+        {
+            MatchGame match_game;
+            match_game.game_index = next_game_index++;
+            if (match_game.game_index >= config.game_count)
+            {
+                return;
+            }
+            const auto pair_index = match_game.game_index / 2;
+            match_game.opening_index = pair_index % openings.size();
+            match_game.first_plays_white = match_game.game_index % 2 == 0;
+            const auto& white = match_game.first_plays_white ? config.first : config.second;
+            const auto& black = match_game.first_plays_white ? config.second : config.first;
+            auto game = get_pair_start(openings[match_game.opening_index], pair_index);
+            match_game.start_key = game.get_key();
+            match_game.game = play_game(std::move(game), white.limits, black.limits,
+                                        config.max_plies, stop_requested);
+            if (match_game.game.result == GameResult::UNKNOWN)
+            {
+                return;
+            }
+
+            std::lock_guard lock{score_mutex};
+            const auto first_color_won = match_game.first_plays_white ? GameResult::WHITE_WON
+                                                                      : GameResult::BLACK_WON;
+            if (match_game.game.result == GameResult::DRAW)
+            {
+                ++score.draws;
+            }
+            else if (match_game.game.result == first_color_won)
+            {
+                ++score.wins;
+            }
+            else
+            {
+                ++score.losses;
+            }
+            if (on_game_finished && !on_game_finished(match_game, score))
+            {
+                stop_requested = true;
+            }
+        }
+    };
+
+    const auto thread_count = std::clamp<std::size_t>(config.thread_count, 1,
+                                                       std::max<std::size_t>(1, config.game_count));
+    std::vector<std::thread> workers;
+    for (std::size_t thread_index = 1; thread_index < thread_count; ++thread_index)
+    {
+        workers.emplace_back(play_games);
+    }
+    play_games();
+    for (auto& worker : workers)
+    {
+        worker.join();
+    }
+    return score;
+}
+
+std::vector<std::string> read_openings(std::istream& input)
+{
+    std::vector<std::string> openings;
+    std::string line;
+    while (std::getline(input, line))
+    {
+        std::istringstream line_stream{line};
+        std::vector<std::string> fields;
+        std::string field;
+        while (fields.size() != 6 && line_stream >> field)
+        {
+            fields.push_back(field);
+        }
+        if (fields.empty() || fields[0][0] == '#')
+        {
+            continue;
+        }
+        if (fields.size() < 4)
+        {
+            throw std::invalid_argument("Opening must contain at least 4 fields");
+        }
+        if (fields.size() != 6 || !is_number(fields[4]) || !is_number(fields[5]))
+        {
+            fields.resize(4);
+            fields.insert(fields.end(), {"0", "1"});
+        }
+        auto fen = fields[0];
+        for (std::size_t field_index = 1; field_index != fields.size(); ++field_index)
+        {
+            fen.append(" ").append(fields[field_index]);
+        }
+        openings.push_back(std::move(fen));
+    }
+    return openings;
+}
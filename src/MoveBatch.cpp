@@ -0,0 +1,197 @@
+#include <MoveBatch.hpp>
+#include <algorithm>
+#include <iterator>
+
+namespace
+{
+void generate_range(const PositionState* positions,
+                    std::size_t position_count,
+                    MoveBatch& batch,
+                    PositionState& position,
+                    std::vector<Move>& moves)
+{
+    for (std::size_t position_index = 0; position_index != position_count; ++position_index)
+    {
+        position = positions[position_index];
+        position.generate_legal_moves(moves);
+        batch.add_position(moves);
+    }
+}
+}  // namespace
+
+MoveBatch::MoveBatch()
+    : m_offsets{0}
+{
+}
+
+void MoveBatch::clear()
+{
+    m_moves.clear();
+    m_offsets.resize(1);
+}
+
+void MoveBatch::reserve(std::size_t position_count, std::size_t move_count)
+{
+    m_offsets.reserve(position_count + 1);
+    m_moves.reserve(move_count);
+}
+
+void MoveBatch::add_position(const std::vector<Move>& moves)
+{
+    m_moves.insert(m_moves.end(), moves.begin(), moves.end());
+    m_offsets.push_back(m_moves.size());
+}
+
+void MoveBatch::append(const MoveBatch& other)
+{
+    const auto move_offset = m_moves.size();
+    m_moves.insert(m_moves.end(), other.m_moves.begin(), other.m_moves.end());
+    std::transform(other.m_offsets.begin() + 1, other.m_offsets.end(),
+                   std::back_inserter(m_offsets),
+                   [move_offset](std::size_t offset) { return offset + move_offset; });
+}
+
+std::size_t MoveBatch::get_position_count() const
+{
+    return m_offsets.size() - 1;
+}
+
+std::size_t MoveBatch::get_offset(std::size_t position_index) const
+{
+    return m_offsets[position_index];
+}
+
+std::size_t MoveBatch::get_move_count(std::size_t position_index) const
+{
+    return m_offsets[position_index + 1] - m_offsets[position_index];
+}
+
+const Move* MoveBatch::get_moves_begin(std::size_t position_index) const
+{
+    return m_moves.data() + m_offsets[position_index];
+}
+
+const Move* MoveBatch::get_moves_end(std::size_t position_index) const
+{
+    return m_moves.data() + m_offsets[position_index + 1];
+}
+
+const std::vector<Move>& MoveBatch::get_moves() const
+{
+    return m_moves;
+}
+
+void generate_available_moves_batch(const PositionState* positions,
+                                    std::size_t position_count,
+                                    MoveBatch& batch)
+{
+    batch.clear();
+    PositionState position;
+    std::vector<Move> moves;
+    generate_range(positions, position_count, batch, position, moves);
+}
+
+MoveBatchGenerator::MoveBatchGenerator(std::size_t thread_count)
+    : m_scratches(std::max<std::size_t>(1, thread_count))
+{
+    for (std::size_t chunk_index = 1; chunk_index != m_scratches.size(); ++chunk_index)
+    {
+        m_workers.emplace_back([this, chunk_index] { run_worker(chunk_index); });
+    }
+}
+
+MoveBatchGenerator::~MoveBatchGenerator()
+{
+    {
+        std::lock_guard lock{m_mutex};
+        m_shutdown = true;
+    }
+    m_start_condition.notify_all();
+    for (auto& worker : m_workers)
+    {
+        worker.join();
+    }
+}
+
+std::size_t MoveBatchGenerator::get_thread_count() const
+{
+    return m_scratches.size();
+}
+
+void MoveBatchGenerator::generate(const PositionState* positions,
+                                  std::size_t position_count,
+                                  MoveBatch& batch)
+{
+    batch.clear();
+    const auto chunk_count = std::max<std::size_t>(
+        1, std::min(m_scratches.size(), position_count / MIN_BATCH_POSITIONS_PER_THREAD));
+    {
+        std::lock_guard lock{m_mutex};
+        m_positions = positions;
+        m_position_count = position_count;
+        m_chunk_count = chunk_count;
+        m_chunk_size = (position_count + chunk_count - 1) / chunk_count;
+        m_pending_chunk_count = chunk_count - 1;
+        if (chunk_count != 1)
+        {
+            ++m_generation;
+        }
+    }
+    if (chunk_count != 1)
+    {
+        m_start_condition.notify_all();
+    }
+
+    generate_chunk(0, batch);
+    if (chunk_count == 1)
+    {
+        return;
+    }
+    std::unique_lock lock{m_mutex};
+    m_done_condition.wait(lock, [this] { return m_pending_chunk_count == 0; });
+    for (std::size_t chunk_index = 1; chunk_index != chunk_count; ++chunk_index)
+    {
+        batch.append(m_scratches[chunk_index].batch);
+    }
+}
+
+void MoveBatchGenerator::run_worker(std::size_t chunk_index)
+{
+    std::uint64_t served_generation = 0;
+    while (true)
+    {
+        {
+            std::unique_lock lock{m_mutex};
+            m_start_condition.wait(
+                lock, [&] { return m_shutdown || m_generation != served_generation; });
+            if (m_shutdown)
+            {
+                return;
+            }
+            served_generation = m_generation;
+            // small batches are split into fewer chunks than there are threads
+            if (chunk_index >= m_chunk_count)
+            {
+                continue;
+            }
+        }
+        auto& chunk_batch = m_scratches[chunk_index].batch;
+        chunk_batch.clear();
+        generate_chunk(chunk_index, chunk_batch);
+        {
+            std::lock_guard lock{m_mutex};
+            --m_pending_chunk_count;
+        }
+        m_done_condition.notify_one();
+    }
+}
+
+void MoveBatchGenerator::generate_chunk(std::size_t chunk_index, MoveBatch& batch)
+{
+    // written under the mutex before the chunk was handed out, read only until it is done
+    const auto chunk_begin = std::min(m_position_count, chunk_index * m_chunk_size);
+    const auto chunk_end = std::min(m_position_count, chunk_begin + m_chunk_size);
+    auto& scratch = m_scratches[chunk_index];
+    generate_range(m_positions + chunk_begin, chunk_end - chunk_begin, batch, scratch.position,
+                   scratch.moves);
+}
@@ -1,133 +1,172 @@
+#include <Attacks.hpp>
 #include <Board.hpp>
+#include <Geometry.hpp>
+#include <Instrumentation.hpp>
 #include <MoveGenerator.hpp>
 #include <array>
+#include <cstdlib>
 #include <literals.hpp>
+#include <stdexcept>
 #include <vector>
 
 namespace
 {
-bool is_piece_info_valid(const Board& board,
-                         const Position& piece_position,
-                         PieceType expected_type,
-                         PieceColor side_to_move)
+bool is_castling_rook_placement_valid(const Position& rook_position,
+                                      const Position& king_position,
+                                      PieceColor side_to_move,
+                                      bool fisher_random,
+                                      bool queen_side_rook)
 {
-    try
-    {
-        const auto& piece = board.get_piece_at_position(piece_position);
-        return piece.get_type() == expected_type && piece.get_color() == side_to_move;
-    }
-    catch (const std::exception& e)
+    const auto back_rank = side_to_move == PieceColor::WHITE ? 0 : 7;
+    // if normal chess we know the exact position of the rooks
+    if (!fisher_random)
     {
-        std::cerr << e.what() << '\n';
-        return false;
+        return rook_position == Position{queen_side_rook ? 0 : 7, back_rank};
     }
+    const bool relative_to_king_position_valid
+        = queen_side_rook ? rook_position.x < king_position.x : rook_position.x > king_position.x;
+    return relative_to_king_position_valid && rook_position.y == back_rank;
 }
 
-bool is_king_info_valid(const Board& board,
-                        const Position& piece_position,
-                        PieceColor side_to_move,
-                        bool king_moved,
-                        bool fisher_random)
+SpecialMovesError validate_castling_rook(const Board& board,
+                                         const std::optional<Position>& rook_position,
+                                         PieceColor side_to_move,
+                                         const Position& king_position,
+                                         bool fisher_random,
+                                         bool queen_side_rook)
 {
-    if (!is_piece_info_valid(board, piece_position, PieceType::KING, side_to_move))
+    if (!rook_position)
     {
-        return false;
+        return SpecialMovesError::NONE;
     }
-    // if king moved than we dont care about castling
-    if (king_moved)
+    if (!Board::is_piece_position_valid(*rook_position)
+        || !board.get_pieces(side_to_move, PieceType::ROOK).contains(Square{*rook_position}))
     {
-        return true;
+        return SpecialMovesError::ROOK_MISSING;
     }
-    if (!fisher_random)
+    if (!is_castling_rook_placement_valid(*rook_position, king_position, side_to_move,
+                                          fisher_random, queen_side_rook))
     {
-        if (side_to_move == PieceColor::WHITE)
-        {
-            return board.get_piece_at_position(piece_position).get_position() == Position{4, 0};
-        }
-        return board.get_piece_at_position(piece_position).get_position() == Position{4, 7};
+        return SpecialMovesError::ROOK_MISPLACED;
     }
-    // if fisher random than we can only be sure about y position
-    if (side_to_move == PieceColor::WHITE)
+    return SpecialMovesError::NONE;
+}
+}  // namespace
+
+const char* to_c_str(SpecialMovesError error)
+{
+    switch (error)
     {
-        return board.get_piece_at_position(piece_position).get_position().y == 0;
+    case SpecialMovesError::NONE:
+        return "none";
+    case SpecialMovesError::KING_MISSING:
+        return "king missing";
+    case SpecialMovesError::KING_MISPLACED:
+        return "king misplaced";
+    case SpecialMovesError::EN_PASSANT_SQUARE_INVALID:
+        return "en passant square invalid";
+    case SpecialMovesError::EN_PASSANT_PAWN_MISSING:
+        return "en passant pawn missing";
+    case SpecialMovesError::ROOK_MISSING:
+        return "rook missing";
+    case SpecialMovesError::ROOK_MISPLACED:
+        return "rook misplaced";
+    default:
+        return "unknown";
     }
-    return board.get_piece_at_position(piece_position).get_position().y == 7;
 }
 
-/**
- * @warning this function presumes that king info is valid
- */
-bool is_rook_info_valid(const Board& board,
-                        const std::optional<Position>& piece_position,
-                        PieceColor side_to_move,
-                        const Position& king_position,
-                        bool fisher_random,
-                        bool queen_side_rook = false)
+SpecialMovesError SpecialMovesData::validate(const Board& board,
+                                             PieceColor side_to_move,
+                                             bool fisher_random) const noexcept
 {
-    if (!piece_position)
+    const auto king_position = board.get_king_position(side_to_move);
+    if (!king_position)
     {
-        return true;
+        return SpecialMovesError::KING_MISSING;
     }
-    if (!is_piece_info_valid(board, *piece_position, PieceType::ROOK, side_to_move))
+    const auto back_rank = side_to_move == PieceColor::WHITE ? 0 : 7;
+    // if king moved than we dont care about castling, if fisher random than we can only be sure
+    // about y position
+    if (!king_moved
+        && (king_position->y != back_rank || (!fisher_random && king_position->x != 4)))
     {
-        return false;
+        return SpecialMovesError::KING_MISPLACED;
     }
-    const auto& rook_position = *piece_position;
-    // if normal chess we know the exact position of the rooks
-    if (!fisher_random)
+
+    if (en_passant_takable)
     {
-        if (queen_side_rook)
+        const auto pawn_direction = side_to_move == PieceColor::WHITE ? 1 : -1;
+        if (en_passant_takable->y != (side_to_move == PieceColor::WHITE ? 5 : 2)
+            || !Board::is_piece_position_valid(*en_passant_takable))
+        {
+            return SpecialMovesError::EN_PASSANT_SQUARE_INVALID;
+        }
+        const Position pawn_position{en_passant_takable->x, en_passant_takable->y - pawn_direction};
+        if (!board.get_pieces(get_opposite_color(side_to_move), PieceType::PAWN)
+                 .contains(Square{pawn_position}))
         {
-            return side_to_move == PieceColor::WHITE ? rook_position == Position{0, 0}
-                                                     : rook_position == Position{0, 7};
+            return SpecialMovesError::EN_PASSANT_PAWN_MISSING;
         }
-        return side_to_move == PieceColor::WHITE ? rook_position == Position{7, 0}
-                                                 : rook_position == Position{7, 7};
     }
 
-    const bool y_position_valid
-        = side_to_move == PieceColor::WHITE ? rook_position.y == 0 : rook_position.y == 7;
-
-    const bool relative_to_king_position_valid
-        = queen_side_rook ? rook_position.x < king_position.x : rook_position.x > king_position.x;
-    return relative_to_king_position_valid && y_position_valid;
-}
-
-bool is_en_passant_info_valid(const Board& board,
-                              const std::optional<Position>& piece_position,
-                              PieceColor side_to_move)
-{
-    if (!piece_position)
+    if (const auto error = validate_castling_rook(board, king_side_rook, side_to_move,
+                                                  *king_position, fisher_random, false);
+        error != SpecialMovesError::NONE)
     {
-        return true;
-    }
-    const auto& pawn_position = *piece_position;
-    if (side_to_move == PieceColor::WHITE)
-    {
-        return pawn_position.y == 5
-               && is_piece_info_valid(board, pawn_position + Position{0, -1}, PieceType::PAWN,
-                                      PieceColor::BLACK);
+        return error;
     }
-    return pawn_position.y == 2
-           && is_piece_info_valid(board, pawn_position + Position{0, 1}, PieceType::PAWN,
-                                  PieceColor::WHITE);
+    return validate_castling_rook(board, queen_side_rook, side_to_move, *king_position,
+                                  fisher_random, true);
 }
-}  // namespace
 
 bool SpecialMovesData::is_ok(const Board& board, PieceColor side_to_move, bool fisher_random) const
 {
-    return is_king_info_valid(board, king_position, side_to_move, king_moved, fisher_random)
-           && is_en_passant_info_valid(board, en_passant_takable, side_to_move)
-           && is_rook_info_valid(board, king_side_rook, side_to_move, king_position, fisher_random)
-           && is_rook_info_valid(board, queen_side_rook, side_to_move, king_position, fisher_random,
-                                 true);
+    return validate(board, side_to_move, fisher_random) == SpecialMovesError::NONE;
 }
 namespace
 {
+/**
+ * @warning king of side to move has to be on board
+ */
+bool is_castling_possible(const Board& board,
+                          const SpecialMovesData& special_move_data,
+                          PieceColor side_to_move,
+                          bool king_side)
+{
+    // if king moved no castling is possible
+    const auto& rook_position
+        = king_side ? special_move_data.king_side_rook : special_move_data.queen_side_rook;
+    if (special_move_data.king_moved || !rook_position)
+    {
+        return false;
+    }
+    const auto opposite_color = get_opposite_color(side_to_move);
+    const auto king_position = *board.get_king_position(side_to_move);
+    const Square king_square{king_position};
+    const auto squares_to_rook = get_between_squares(king_square, Square{*rook_position});
+    if (!(squares_to_rook & board.get_occupied_squares()).empty())
+    {
+        return false;
+    }
+    // king may not castle out of check, pass through or land on attacked square
+    const Position king_target{king_side ? 6 : 2, king_position.y};
+    const auto king_path = get_between_squares(king_square, Square{king_target})
+                           | SquareSet{king_position, king_target};
+    for (auto it = king_path.begin(); it != king_path.end(); ++it)
+    {
+        if (is_square_attacked(board, it.get_square(), opposite_color))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
 class MoveGenerator
 {
 public:
-    using MovesContainer = std::unordered_map<Position, std::unordered_set<Position>>;
+    using MovesContainer = NormalMoves;
 
 public:
     MoveGenerator(Board& board, const SpecialMovesData& special_move_data, PieceColor side_to_move);
@@ -139,7 +178,7 @@ public:
 private:
     void generate_normal_moves();
     void generate_special_moves();
-    bool is_board_valid_after_move(Board& board, const Position& king_position) const;
+    bool is_board_valid_after_move(const Board& board) const;
 
 private:
     Board& m_board;
@@ -150,26 +189,46 @@ private:
     bool m_queen_side_castle_possible{false};
 };
 
-class RawMoveGenerator : public PieceVisitor
+template <PieceType piece_type, typename Generator>
+void visit_pieces_of_type(const Board& board, PieceColor piece_color, Generator& generator)
+{
+    for (const auto& position : board.get_pieces(piece_color, piece_type))
+    {
+        generator.template visit<piece_type>(position, piece_color);
+    }
+}
+
+/**
+ * @brief calls generator.visit<piece type>(position, color) for every piece of color, pieces
+ *  are taken from the board masks type by type so generators are dispatched without virtual
+ *  calls and without scanning empty squares
+ */
+template <typename Generator>
+void visit_pieces(const Board& board, PieceColor piece_color, Generator& generator)
+{
+    visit_pieces_of_type<PieceType::KING>(board, piece_color, generator);
+    visit_pieces_of_type<PieceType::QUEEN>(board, piece_color, generator);
+    visit_pieces_of_type<PieceType::BISHOP>(board, piece_color, generator);
+    visit_pieces_of_type<PieceType::KNIGHT>(board, piece_color, generator);
+    visit_pieces_of_type<PieceType::ROOK>(board, piece_color, generator);
+    visit_pieces_of_type<PieceType::PAWN>(board, piece_color, generator);
+}
+
+class RawMoveGenerator
 {
 public:
-    using MovesContainer = std::unordered_map<Position, std::unordered_set<Position>>;
+    using MovesContainer = NormalMoves;
 
 public:
     RawMoveGenerator(const Board& board,
                      const SpecialMovesData& special_move_data,
                      PieceColor side_to_move);
     const MovesContainer& get_available_raw_moves() const;
-    void visit(King& piece) override;
-    void visit(Queen& piece) override;
-    void visit(Bishop& piece) override;
-    void visit(Knight& piece) override;
-    void visit(Rook& piece) override;
-    void visit(Pawn& piece) override;
+    template <PieceType piece_type>
+    void visit(const Position& piece_position, PieceColor piece_color);
 
 private:
-    template <typename T>
-    void add_move_from_squares_under_attack(T& piece);
+    void visit_pawn(const Position& piece_position, PieceColor piece_color);
 
 private:
     const Board& m_board;
@@ -178,29 +237,25 @@ private:
     const SpecialMovesData& m_special_move_data;
 };
 
-class SquaresUnderAttackGenerator : public PieceVisitor
+class SquaresUnderAttackGenerator
 {
 public:
     SquaresUnderAttackGenerator(const Board& board, PieceColor side_to_move);
-    const std::unordered_set<Position>& get_squares_under_attack() const;
-    void visit(King& piece) override;
-    void visit(Queen& piece) override;
-    void visit(Bishop& piece) override;
-    void visit(Knight& piece) override;
-    void visit(Rook& piece) override;
-    void visit(Pawn& piece) override;
+    const SquareSet& get_squares_under_attack() const;
+    template <PieceType piece_type>
+    void visit(const Position& piece_position, PieceColor piece_color);
 
 private:
     bool should_generate_move(PieceColor color) const;
-    bool try_add_square(const Position& piece_position);
-
-    void generate_diagonal_moves(const Position& piece_position);
-    void generate_vertical_moves(const Position& piece_position);
+    /**
+     * @brief adds attacked squares not occupied by pieces of side to move
+     */
+    void add_attacks(SquareSet attacks);
 
 private:
     const Board& m_board;
     PieceColor m_side_to_move;
-    std::unordered_set<Position> m_squares_under_attack;
+    SquareSet m_squares_under_attack;
 };
 
 MoveGenerator::MoveGenerator(Board& board,
@@ -248,289 +303,168 @@ const RawMoveGenerator::MovesContainer& RawMoveGenerator::get_available_raw_move
     return m_available_moves;
 }
 
-const std::unordered_set<Position>& SquaresUnderAttackGenerator::get_squares_under_attack() const
+const SquareSet& SquaresUnderAttackGenerator::get_squares_under_attack() const
 {
     return m_squares_under_attack;
 }
 
-template <typename T>
-void RawMoveGenerator::add_move_from_squares_under_attack(T& piece)
-{
-    SquaresUnderAttackGenerator squares_under_attack_generator{m_board, m_side_to_move};
-    squares_under_attack_generator.visit(piece);
-    const auto& available_squares = squares_under_attack_generator.get_squares_under_attack();
-    if (!available_squares.empty())
-    {
-        m_available_moves[piece.get_position()] = available_squares;
-    }
-}
-
 bool SquaresUnderAttackGenerator::should_generate_move(PieceColor color) const
 {
     return color == m_side_to_move;
 }
 
-bool SquaresUnderAttackGenerator::try_add_square(const Position& piece_position)
+void SquaresUnderAttackGenerator::add_attacks(SquareSet attacks)
 {
-    if (!Board::is_piece_position_valid(piece_position))
-    {
-        return false;
-    }
-    if (!m_board.is_square_empty(piece_position))
-    {
-        const auto& piece = m_board.get_piece_at_position(piece_position);
-        if (piece.get_color() != m_side_to_move)
-        {
-            m_squares_under_attack.insert(piece_position);
-        }
-        return false;
-    }
-    m_squares_under_attack.insert(piece_position);
-    return true;
+    m_squares_under_attack |= attacks & ~m_board.get_pieces(m_side_to_move);
 }
 
-void SquaresUnderAttackGenerator::generate_diagonal_moves(const Position& piece_position)
+template <PieceType piece_type>
+void SquaresUnderAttackGenerator::visit(const Position& piece_position, PieceColor piece_color)
 {
-    for (std::int32_t i = 1; i != 9; ++i)
-    {
-        if (!try_add_square(piece_position + Position{i, i}))
-        {
-            break;
-        }
-    }
-    for (std::int32_t i = -1; i != -9; --i)
+    if (!should_generate_move(piece_color))
     {
-        if (!try_add_square(piece_position + Position{i, i}))
-        {
-            break;
-        }
+        return;
     }
-
-    for (std::int32_t i = 1; i != 9; ++i)
+    const Square square{piece_position};
+    if constexpr (piece_type == PieceType::KING)
     {
-        if (!try_add_square(piece_position + Position{-i, i}))
-        {
-            break;
-        }
+        add_attacks(get_king_attacks(square));
     }
-    for (std::int32_t i = -1; i != -9; --i)
+    else if constexpr (piece_type == PieceType::QUEEN)
     {
-        if (!try_add_square(piece_position + Position{-i, i}))
-        {
-            break;
-        }
+        const auto occupancy = m_board.get_occupied_squares();
+        add_attacks(get_bishop_attacks(square, occupancy) | get_rook_attacks(square, occupancy));
     }
-}
-
-void SquaresUnderAttackGenerator::generate_vertical_moves(const Position& piece_position)
-{
-    for (std::int32_t i = 1; i != 9; ++i)
+    else if constexpr (piece_type == PieceType::BISHOP)
     {
-        if (!try_add_square(piece_position + Position{i, 0}))
-        {
-            break;
-        }
+        add_attacks(get_bishop_attacks(square, m_board.get_occupied_squares()));
     }
-    for (std::int32_t i = -1; i != -9; --i)
+    else if constexpr (piece_type == PieceType::KNIGHT)
     {
-        if (!try_add_square(piece_position + Position{i, 0}))
-        {
-            break;
-        }
+        add_attacks(get_knight_attacks(square));
     }
-
-    for (std::int32_t i = 1; i != 9; ++i)
+    else if constexpr (piece_type == PieceType::ROOK)
     {
-        if (!try_add_square(piece_position + Position{0, i}))
-        {
-            break;
-        }
+        add_attacks(get_rook_attacks(square, m_board.get_occupied_squares()));
     }
-    for (std::int32_t i = -1; i != -9; --i)
+    else if constexpr (piece_type == PieceType::PAWN)
     {
-        if (!try_add_square(piece_position + Position{0, i}))
-        {
-            break;
-        }
+        add_attacks(get_pawn_attacks(square, piece_color));
     }
 }
 
-void SquaresUnderAttackGenerator::visit(King& piece)
+template <PieceType piece_type>
+void RawMoveGenerator::visit(const Position& piece_position, PieceColor piece_color)
 {
-    if (!should_generate_move(piece.get_color()))
+    if constexpr (piece_type == PieceType::PAWN)
     {
-        return;
+        visit_pawn(piece_position, piece_color);
     }
-    for (std::int32_t i = -1; i != 2; ++i)
+    else
     {
-        for (std::int32_t j = -1; j != 2; ++j)
+        SquaresUnderAttackGenerator squares_under_attack_generator{m_board, m_side_to_move};
+        squares_under_attack_generator.visit<piece_type>(piece_position, piece_color);
+        const auto& available_squares = squares_under_attack_generator.get_squares_under_attack();
+        if (!available_squares.empty())
         {
-            if (i == 0 && j == 0)
-            {
-                continue;
-            }
-            try_add_square(piece.get_position() + Position{i, j});
+            m_available_moves[piece_position] = available_squares;
         }
     }
 }
-void SquaresUnderAttackGenerator::visit(Queen& piece)
-{
-    if (!should_generate_move(piece.get_color()))
-    {
-        return;
-    }
-    generate_diagonal_moves(piece.get_position());
-    generate_vertical_moves(piece.get_position());
-}
-void SquaresUnderAttackGenerator::visit(Bishop& piece)
-{
-    if (!should_generate_move(piece.get_color()))
-    {
-        return;
-    }
-    generate_diagonal_moves(piece.get_position());
-}
-void SquaresUnderAttackGenerator::visit(Knight& piece)
-{
-    if (!should_generate_move(piece.get_color()))
-    {
-        return;
-    }
-    try_add_square(piece.get_position() + Position{2, 1});
-    try_add_square(piece.get_position() + Position{-2, 1});
-    try_add_square(piece.get_position() + Position{1, 2});
-    try_add_square(piece.get_position() + Position{-1, 2});
 
-    try_add_square(piece.get_position() + Position{-2, -1});
-    try_add_square(piece.get_position() + Position{2, -1});
-    try_add_square(piece.get_position() + Position{-1, -2});
-    try_add_square(piece.get_position() + Position{1, -2});
-}
-void SquaresUnderAttackGenerator::visit(Rook& piece)
+void RawMoveGenerator::visit_pawn(const Position& piece_position, PieceColor piece_color)
 {
-    if (!should_generate_move(piece.get_color()))
+    if (piece_color != m_side_to_move)
     {
         return;
     }
-    generate_vertical_moves(piece.get_position());
-}
-void SquaresUnderAttackGenerator::visit(Pawn& piece)
-{
-    if (!should_generate_move(piece.get_color()))
-    {
-        return;
-    }
-    if (piece.get_color() == PieceColor::WHITE)
-    {
-        try_add_square(piece.get_position() + Position{1, 1});
-        try_add_square(piece.get_position() + Position{-1, 1});
-    }
-    else
-    {
-        try_add_square(piece.get_position() + Position{1, -1});
-        try_add_square(piece.get_position() + Position{-1, -1});
-    }
-}
-
-void RawMoveGenerator::visit(King& piece)
-{
-    add_move_from_squares_under_attack(piece);
-}
-void RawMoveGenerator::visit(Queen& piece)
-{
-    add_move_from_squares_under_attack(piece);
-}
-void RawMoveGenerator::visit(Bishop& piece)
-{
-    add_move_from_squares_under_attack(piece);
-}
-void RawMoveGenerator::visit(Knight& piece)
-{
-    add_move_from_squares_under_attack(piece);
-}
-void RawMoveGenerator::visit(Rook& piece)
-{
-    add_move_from_squares_under_attack(piece);
-}
-void RawMoveGenerator::visit(Pawn& piece)
-{
-    if (piece.get_color() != m_side_to_move)
-    {
-        return;
-    }
-    const auto try_add_attacking_square = [this, &piece](const Position& piece_position) {
-        if (!Board::is_piece_position_valid(piece_position))
+    const auto try_add_attacking_square = [this, &piece_position](const Position& square) {
+        if (!Board::is_piece_position_valid(square))
         {
             return;
         }
-        if (m_board.is_square_empty(piece_position))
+        const auto piece_code = m_board.get_piece_code(square);
+        if (piece_code.is_empty())
         {
             // check for en_pasant
             if (!m_special_move_data.en_passant_takable)
             {
                 return;
             }
-            if (*m_special_move_data.en_passant_takable != piece_position)
+            if (*m_special_move_data.en_passant_takable != square)
             {
                 return;
             }
-            m_available_moves[piece.get_position()].insert(piece_position);
+            m_available_moves[piece_position].insert(square);
         }
         else
         {
-            if (m_board.get_piece_at_position(piece_position).get_color() == m_side_to_move)
+            if (piece_code.get_color() == m_side_to_move)
             {
                 return;
             }
-            m_available_moves[piece.get_position()].insert(piece_position);
+            m_available_moves[piece_position].insert(square);
         }
     };
-    const auto try_add_normal_square = [this, &piece](const Position& piece_position) {
-        if (!Board::is_piece_position_valid(piece_position))
+    const auto try_add_normal_square = [this, &piece_position](const Position& square) {
+        if (!Board::is_piece_position_valid(square))
         {
-            return;
+            return false;
         }
-        if (m_board.is_square_empty(piece_position))
+        if (m_board.is_square_empty(square))
         {
-            m_available_moves[piece.get_position()].insert(piece_position);
+            m_available_moves[piece_position].insert(square);
+            return true;
         }
+        return false;
     };
-    if (piece.get_color() == PieceColor::WHITE)
+    if (piece_color == PieceColor::WHITE)
     {
-        try_add_attacking_square(piece.get_position() + Position{1, 1});
-        try_add_attacking_square(piece.get_position() + Position{-1, 1});
-        try_add_normal_square(piece.get_position() + Position{0, 1});
+        try_add_attacking_square(piece_position + Position{1, 1});
+        try_add_attacking_square(piece_position + Position{-1, 1});
+        if (try_add_normal_square(piece_position + Position{0, 1}) && piece_position.y == 1)
+        {
+            try_add_normal_square(piece_position + Position{0, 2});
+        }
     }
     else
     {
-        try_add_attacking_square(piece.get_position() + Position{1, -1});
-        try_add_attacking_square(piece.get_position() + Position{-1, -1});
-        try_add_normal_square(piece.get_position() + Position{0, -1});
+        try_add_attacking_square(piece_position + Position{1, -1});
+        try_add_attacking_square(piece_position + Position{-1, -1});
+        if (try_add_normal_square(piece_position + Position{0, -1}) && piece_position.y == 6)
+        {
+            try_add_normal_square(piece_position + Position{0, -2});
+        }
     }
 }
 
 void MoveGenerator::generate_normal_moves()
 {
+    CHESS_TIME_PHASE(NORMAL_MOVES);
     RawMoveGenerator raw_move_generator{m_board, m_special_move_data, m_side_to_move};
-    m_board.apply_piece_visitor(raw_move_generator);
+    visit_pieces(m_board, m_side_to_move, raw_move_generator);
     const auto& available_moves = raw_move_generator.get_available_raw_moves();
     for (const auto& move_list : available_moves)
     {
+        CHESS_COUNT(RAW_MOVES, move_list.second.size());
         for (const auto& move_position : move_list.second)
         {
-            auto new_board = m_board.clone();
-            auto moving_piece = new_board.remove_piece(move_list.first);
-            const auto& king_position = moving_piece->get_type() == PieceType::KING
-                                            ? move_position
-                                            : m_special_move_data.king_position;
-            const auto taken_piece = new_board.remove_piece(move_position);
-            if (taken_piece && taken_piece->get_type() == PieceType::KING)
+            CHESS_COUNT(BOARD_COPIES, 1);
+            auto new_board = m_board;
+            const auto moving_piece = new_board.remove_piece_code(move_list.first);
+            const auto taken_piece = new_board.remove_piece_code(move_position);
+            if (!taken_piece.is_empty() && taken_piece.get_type() == PieceType::KING)
             {
                 throw std::logic_error("Invalid board! Can't capture king!");
             }
-            moving_piece->set_position(move_position);
-            new_board.add_piece(std::move(moving_piece));
-            if (is_board_valid_after_move(new_board, king_position))
+            if (taken_piece.is_empty() && moving_piece.get_type() == PieceType::PAWN
+                && move_position.x != move_list.first.x)
+            {
+                // en passant, captured pawn may have shielded king along the rank
+                new_board.remove_piece_code({move_position.x, move_list.first.y});
+            }
+            new_board.add_piece(moving_piece, move_position);
+            if (is_board_valid_after_move(new_board))
             {
                 m_available_moves[move_list.first].insert(move_position);
             }
@@ -540,54 +474,25 @@ void MoveGenerator::generate_normal_moves()
 
 void MoveGenerator::generate_special_moves()
 {  // TODO: add support of fisher random
-    // if king moved no castling is possible
-    if (m_special_move_data.king_moved)
-    {
-        return;
-    }
-    SquaresUnderAttackGenerator squares_under_attack_generator{m_board,
-                                                               get_opposite_color(m_side_to_move)};
-    m_board.apply_piece_visitor(squares_under_attack_generator);
-    const auto& squares_under_attack = squares_under_attack_generator.get_squares_under_attack();
-
-    // if king is under attack no castling is possible
-    if (squares_under_attack.count(m_special_move_data.king_position))
-    {
-        return;
-    }
-    const auto can_move_through_square = [this, &squares_under_attack](const Position& square) {
-        return m_board.is_square_empty(square) && !squares_under_attack.count(square);
-    };
-    const auto kings_y_coord = m_special_move_data.king_position.y;
-    // king side
-    if (m_special_move_data.king_side_rook)
-    {
-        m_king_side_castle_possible = can_move_through_square(Position{5, kings_y_coord})
-                                      && can_move_through_square({6, kings_y_coord});
-    }
-    // queen side
-    if (m_special_move_data.queen_side_rook)
-    {
-        m_queen_side_castle_possible = m_board.is_square_empty({1, kings_y_coord})
-                                       && can_move_through_square({2, kings_y_coord})
-                                       && can_move_through_square({3, kings_y_coord});
-    }
+    CHESS_TIME_PHASE(SPECIAL_MOVES);
+    m_king_side_castle_possible
+        = is_castling_possible(m_board, m_special_move_data, m_side_to_move, true);
+    m_queen_side_castle_possible
+        = is_castling_possible(m_board, m_special_move_data, m_side_to_move, false);
 }
 
-bool MoveGenerator::is_board_valid_after_move(Board& board, const Position& king_position) const
+bool MoveGenerator::is_board_valid_after_move(const Board& board) const
 {
-    SquaresUnderAttackGenerator squares_under_attack_generator{board,
-                                                               get_opposite_color(m_side_to_move)};
-    board.apply_piece_visitor(squares_under_attack_generator);
-    const auto& squares_under_attack = squares_under_attack_generator.get_squares_under_attack();
-    return !squares_under_attack.count(king_position);
+    CHESS_COUNT(LEGALITY_CHECKS, 1);
+    return !is_square_attacked(board, Square{*board.get_king_position(m_side_to_move)},
+                               get_opposite_color(m_side_to_move));
 }
 
 void MoveGenerator::generate_moves()
 {
+    CHESS_TIME_PHASE(GENERATE_MOVES);
     if (!m_special_move_data.is_ok(m_board, m_side_to_move))
     {
-        std::cerr << __PRETTY_FUNCTION__ << " INVALID SPECIAL_MOVE_DATA\n";
         return;
     }
     generate_normal_moves();
@@ -597,9 +502,7 @@ void MoveGenerator::generate_moves()
 
 SquaresUnderAttack generate_squares_under_attack(Board& board, PieceColor side_to_move)
 {
-    SquaresUnderAttackGenerator squares_under_attack_generator{board, side_to_move};
-    board.apply_piece_visitor(squares_under_attack_generator);
-    return squares_under_attack_generator.get_squares_under_attack();
+    return get_attacked_squares(board, side_to_move) & ~board.get_pieces(side_to_move);
 }
 
 NormalMoves generate_raw_available_moves(Board& board,
@@ -607,7 +510,7 @@ NormalMoves generate_raw_available_moves(Board& board,
                                          PieceColor side_to_move)
 {
     RawMoveGenerator raw_moves_generator{board, special_move_data, side_to_move};
-    board.apply_piece_visitor(raw_moves_generator);
+    visit_pieces(board, side_to_move, raw_moves_generator);
     return raw_moves_generator.get_available_raw_moves();
 }
 
@@ -619,4 +522,390 @@ AvailableMoves generate_available_moves(Board& board,
     move_generator.generate_moves();
     return {move_generator.get_available_moves(), move_generator.is_king_side_castle_possible(),
             move_generator.is_queen_side_castle_possible()};
-}
\ No newline at end of file
+}
+
+bool is_move_legal(const Board& board,
+                   const SpecialMovesData& special_move_data,
+                   PieceColor side_to_move,
+                   const Position& from,
+                   const Position& to,
+                   std::optional<PromotablePieceType> promotion)
+{
+    CHESS_COUNT(LEGALITY_CHECKS, 1);
+    if (!Board::is_piece_position_valid(from) || !Board::is_piece_position_valid(to))
+    {
+        return false;
+    }
+    const auto moving_piece = board.get_piece_code(from);
+    const auto taken_piece = board.get_piece_code(to);
+    if (moving_piece.is_empty() || moving_piece.get_color() != side_to_move
+        || (!taken_piece.is_empty()
+            && (taken_piece.get_color() == side_to_move
+                || taken_piece.get_type() == PieceType::KING))
+        || !special_move_data.is_ok(board, side_to_move))
+    {
+        return false;
+    }
+
+    const auto moving_type = moving_piece.get_type();
+    const Square from_square{from};
+    const Square to_square{to};
+    const auto occupancy = board.get_occupied_squares();
+    const auto pawn_direction = side_to_move == PieceColor::WHITE ? 1 : -1;
+    const bool is_promotion
+        = moving_type == PieceType::PAWN && to.y == (side_to_move == PieceColor::WHITE ? 7 : 0);
+    if (is_promotion != promotion.has_value())
+    {
+        return false;
+    }
+    auto captured_square = to_square;
+    bool is_pseudo_legal = false;
+    switch (moving_type)
+    {
+    case PieceType::KING:
+        if (to.y == from.y && std::abs(to.x - from.x) == 2)
+        {
+            return is_castling_possible(board, special_move_data, side_to_move, to.x > from.x);
+        }
+        is_pseudo_legal = get_king_attacks(from_square).contains(to_square);
+        break;
+    case PieceType::QUEEN:
+        is_pseudo_legal = (get_bishop_attacks(from_square, occupancy)
+                           | get_rook_attacks(from_square, occupancy))
+                              .contains(to_square);
+        break;
+    case PieceType::BISHOP:
+        is_pseudo_legal = get_bishop_attacks(from_square, occupancy).contains(to_square);
+        break;
+    case PieceType::KNIGHT:
+        is_pseudo_legal = get_knight_attacks(from_square).contains(to_square);
+        break;
+    case PieceType::ROOK:
+        is_pseudo_legal = get_rook_attacks(from_square, occupancy).contains(to_square);
+        break;
+    case PieceType::PAWN:
+        if (to.x == from.x)
+        {
+            const Position one_step{from.x, from.y + pawn_direction};
+            const bool is_double_step = to.y == from.y + 2 * pawn_direction
+                                        && from.y == (side_to_move == PieceColor::WHITE ? 1 : 6);
+            is_pseudo_legal = taken_piece.is_empty() && board.is_square_empty(one_step)
+                              && (to == one_step || is_double_step);
+        }
+        else if (get_pawn_attacks(from_square, side_to_move).contains(to_square))
+        {
+            if (taken_piece.is_empty() && special_move_data.en_passant_takable == to)
+            {
+                captured_square = Square{Position{to.x, from.y}};
+                is_pseudo_legal = true;
+            }
+            else
+            {
+                is_pseudo_legal = !taken_piece.is_empty();
+            }
+        }
+        break;
+    }
+    if (!is_pseudo_legal)
+    {
+        return false;
+    }
+
+    // king safety for this move only: sliders see through from and are blocked at to, captured
+    // piece no longer attacks, pinned pieces leaving their line expose the king this way too
+    const auto king_square = moving_type == PieceType::KING
+                                 ? to_square
+                                 : Square{*board.get_king_position(side_to_move)};
+    auto occupancy_after_move = occupancy;
+    occupancy_after_move.erase(from_square);
+    occupancy_after_move.erase(captured_square);
+    occupancy_after_move.insert(to_square);
+    auto attackers = attackers_to(board, king_square, occupancy_after_move)
+                     & board.get_pieces(get_opposite_color(side_to_move));
+    attackers.erase(captured_square);
+    return attackers.empty();
+}
+
+namespace
+{
+/**
+ * @brief calls visitor(piece type, from, targets) with legal targets of every piece of side to
+ *  move until visitor returns false, castling and en passant are left out
+ * @note pins and checks are computed once from king square, so targets are masks and no move is
+ *  tried on a board copy
+ * @return false if visitor stopped the visit
+ */
+template <typename Visitor>
+bool visit_legal_targets(const Board& board, PieceColor side_to_move, Visitor&& visitor)
+{
+    const auto opposite_color = get_opposite_color(side_to_move);
+    const auto own_pieces = board.get_pieces(side_to_move);
+    const auto enemy_pieces = board.get_pieces(opposite_color);
+    const auto occupancy = board.get_occupied_squares();
+    const Square king_square{*board.get_king_position(side_to_move)};
+
+    auto occupancy_without_king = occupancy;
+    occupancy_without_king.erase(king_square);
+    const auto king_moves = get_king_attacks(king_square) & ~own_pieces;
+    SquareSet king_targets;
+    for (auto it = king_moves.begin(); it != king_moves.end(); ++it)
+    {
+        if ((attackers_to(board, it.get_square(), occupancy_without_king) & enemy_pieces).empty())
+        {
+            king_targets.insert(it.get_square());
+        }
+    }
+    if (!visitor(PieceType::KING, king_square, king_targets))
+    {
+        return false;
+    }
+
+    const auto checkers = attackers_to(board, king_square, occupancy) & enemy_pieces;
+    if (checkers.size() > 1)
+    {
+        return true;
+    }
+    auto check_mask = ~SquareSet{};
+    if (!checkers.empty())
+    {
+        const auto checker_square = checkers.begin().get_square();
+        check_mask = get_between_squares(king_square, checker_square) | checkers;
+    }
+
+    // enemy sliders seen from king through own pieces pin the single own piece between them
+    const auto enemy_queens = board.get_pieces(opposite_color, PieceType::QUEEN);
+    const auto pinners
+        = (get_rook_attacks(king_square, enemy_pieces)
+           & (board.get_pieces(opposite_color, PieceType::ROOK) | enemy_queens))
+          | (get_bishop_attacks(king_square, enemy_pieces)
+             & (board.get_pieces(opposite_color, PieceType::BISHOP) | enemy_queens));
+    SquareSet pinned;
+    for (auto it = pinners.begin(); it != pinners.end(); ++it)
+    {
+        const auto blockers = get_between_squares(king_square, it.get_square()) & occupancy;
+        if (blockers.size() == 1 && !(blockers & own_pieces).empty())
+        {
+            pinned |= blockers;
+        }
+    }
+
+    const auto pawn_direction = side_to_move == PieceColor::WHITE ? 1 : -1;
+    const auto pawn_start_rank = side_to_move == PieceColor::WHITE ? 1 : 6;
+    const auto get_targets = [&](PieceType piece_type, Square from) {
+        switch (piece_type)
+        {
+        case PieceType::QUEEN:
+            return get_bishop_attacks(from, occupancy) | get_rook_attacks(from, occupancy);
+        case PieceType::BISHOP:
+            return get_bishop_attacks(from, occupancy);
+        case PieceType::KNIGHT:
+            return get_knight_attacks(from);
+        case PieceType::ROOK:
+            return get_rook_attacks(from, occupancy);
+        default:
+            break;
+        }
+        auto targets = get_pawn_attacks(from, side_to_move) & enemy_pieces;
+        const Position one_step{from.get_file(), from.get_rank() + pawn_direction};
+        if (!occupancy.contains(Square{one_step}))
+        {
+            targets.insert(one_step);
+            const Position two_steps{one_step.x, one_step.y + pawn_direction};
+            if (from.get_rank() == pawn_start_rank && !occupancy.contains(Square{two_steps}))
+            {
+                targets.insert(two_steps);
+            }
+        }
+        return targets;
+    };
+    for (const auto piece_type :
+         {PieceType::QUEEN, PieceType::BISHOP, PieceType::KNIGHT, PieceType::ROOK, PieceType::PAWN})
+    {
+        const auto pieces = board.get_pieces(side_to_move, piece_type);
+        for (auto it = pieces.begin(); it != pieces.end(); ++it)
+        {
+            const auto from = it.get_square();
+            auto targets = get_targets(piece_type, from) & ~own_pieces & check_mask;
+            if (pinned.contains(from))
+            {
+                targets &= get_line(king_square, from);
+            }
+            if (!visitor(piece_type, from, targets))
+            {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief en passant captures are rare enough to be checked one by one
+ */
+SquareSet get_en_passant_capturers(const Board& board,
+                                   const SpecialMovesData& special_move_data,
+                                   PieceColor side_to_move)
+{
+    SquareSet capturers;
+    if (!special_move_data.en_passant_takable)
+    {
+        return capturers;
+    }
+    const auto& target = *special_move_data.en_passant_takable;
+    const auto candidates = get_pawn_attacks(Square{target}, get_opposite_color(side_to_move))
+                            & board.get_pieces(side_to_move, PieceType::PAWN);
+    for (const auto& from : candidates)
+    {
+        if (is_move_legal(board, special_move_data, side_to_move, from, target))
+        {
+            capturers.insert(from);
+        }
+    }
+    return capturers;
+}
+}  // namespace
+
+std::size_t count_legal_moves(const Board& board,
+                              const SpecialMovesData& special_move_data,
+                              PieceColor side_to_move)
+{
+    if (!special_move_data.is_ok(board, side_to_move))
+    {
+        return 0;
+    }
+    const auto promotion_rank_mask = SquareSet{side_to_move == PieceColor::WHITE
+                                                   ? 0xFF00000000000000ULL
+                                                   : 0x00000000000000FFULL};
+    std::size_t move_count = 0;
+    visit_legal_targets(board, side_to_move, [&](PieceType piece_type, Square, SquareSet targets) {
+        move_count += targets.size();
+        if (piece_type == PieceType::PAWN)
+        {
+            // every promotion is a separate move: queen, rook, bishop, knight
+            move_count += 3 * (targets & promotion_rank_mask).size();
+        }
+        return true;
+    });
+    move_count += get_en_passant_capturers(board, special_move_data, side_to_move).size();
+    move_count += is_castling_possible(board, special_move_data, side_to_move, true) ? 1 : 0;
+    move_count += is_castling_possible(board, special_move_data, side_to_move, false) ? 1 : 0;
+    return move_count;
+}
+
+bool has_any_legal_move(const Board& board,
+                        const SpecialMovesData& special_move_data,
+                        PieceColor side_to_move)
+{
+    if (!special_move_data.is_ok(board, side_to_move))
+    {
+        return false;
+    }
+    const bool found_move = !visit_legal_targets(
+        board, side_to_move, [](PieceType, Square, SquareSet targets) { return targets.empty(); });
+    // castling is never the only legal move, king can always step to the square it passes
+    return found_move || !get_en_passant_capturers(board, special_move_data, side_to_move).empty();
+}
+
+NormalMoves::const_iterator::const_iterator(const NormalMoves& moves, std::size_t index)
+    : m_moves{&moves}
+    , m_index{index}
+{
+    skip_empty();
+}
+
+NormalMoves::value_type NormalMoves::const_iterator::operator*() const
+{
+    return {Square{static_cast<std::uint8_t>(m_index)}.to_position(),
+            m_moves->m_destinations[m_index]};
+}
+
+NormalMoves::const_iterator& NormalMoves::const_iterator::operator++()
+{
+    ++m_index;
+    skip_empty();
+    return *this;
+}
+
+bool NormalMoves::const_iterator::operator==(const const_iterator& other) const
+{
+    return m_index == other.m_index;
+}
+
+bool NormalMoves::const_iterator::operator!=(const const_iterator& other) const
+{
+    return m_index != other.m_index;
+}
+
+void NormalMoves::const_iterator::skip_empty()
+{
+    while (m_index != SQUARE_COUNT && m_moves->m_destinations[m_index].empty())
+    {
+        ++m_index;
+    }
+}
+
+NormalMoves::NormalMoves(std::initializer_list<value_type> moves)
+{
+    for (const auto& [origin, destinations] : moves)
+    {
+        (*this)[origin] = destinations;
+    }
+}
+
+SquareSet& NormalMoves::operator[](const Position& origin)
+{
+    return m_destinations[Square{origin}.get_index()];
+}
+
+const SquareSet& NormalMoves::at(const Position& origin) const
+{
+    if (!count(origin))
+    {
+        throw std::out_of_range("No moves from given position");
+    }
+    return m_destinations[Square{origin}.get_index()];
+}
+
+std::size_t NormalMoves::count(const Position& origin) const
+{
+    if (!Board::is_piece_position_valid(origin))
+    {
+        return 0;
+    }
+    return m_destinations[Square{origin}.get_index()].empty() ? 0 : 1;
+}
+
+std::size_t NormalMoves::size() const
+{
+    std::size_t origin_count = 0;
+    for (const auto& destinations : m_destinations)
+    {
+        origin_count += destinations.empty() ? 0 : 1;
+    }
+    return origin_count;
+}
+
+bool NormalMoves::empty() const
+{
+    return begin() == end();
+}
+
+NormalMoves::const_iterator NormalMoves::begin() const
+{
+    return {*this, 0};
+}
+
+NormalMoves::const_iterator NormalMoves::end() const
+{
+    return {*this, SQUARE_COUNT};
+}
+
+bool NormalMoves::operator==(const NormalMoves& other) const
+{
+    return m_destinations == other.m_destinations;
+}
+
+bool NormalMoves::operator!=(const NormalMoves& other) const
+{
+    return !(*this == other);
+}
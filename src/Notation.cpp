@@ -0,0 +1,180 @@
+#include <Notation.hpp>
+#include <cctype>
+
+namespace
+{
+void append_castling(MoveNotation& notation, const Move& move)
+{
+    for (const auto notation_char : std::string_view{"O-O"})
+    {
+        notation.append(notation_char);
+    }
+    if (move.type == MoveType::QUEEN_SIDE_CASTLE)
+    {
+        notation.append('-');
+        notation.append('O');
+    }
+}
+
+bool is_castling(const Move& move)
+{
+    return move.type == MoveType::KING_SIDE_CASTLE || move.type == MoveType::QUEEN_SIDE_CASTLE;
+}
+
+bool is_capture(const Board& board, const Move& move)
+{
+    return move.type == MoveType::EN_PASSANT || !board.is_square_empty(move.to);
+}
+
+void append_promotion(MoveNotation& notation, const Move& move)
+{
+    if (move.promotion)
+    {
+        notation.append('=');
+        notation.append(to_char(static_cast<PieceType>(*move.promotion)));
+    }
+}
+}  // namespace
+
+void MoveNotation::append(char notation_char)
+{
+    if (m_size != MAX_SIZE)
+    {
+        m_chars[m_size++] = notation_char;
+    }
+}
+
+void MoveNotation::append(const Position& position)
+{
+    append(static_cast<char>('a' + position.x));
+    append(static_cast<char>('1' + position.y));
+}
+
+void MoveNotation::append(CheckState check_state)
+{
+    if (check_state == CheckState::CHECK)
+    {
+        append('+');
+    }
+    else if (check_state == CheckState::CHECKMATE)
+    {
+        append('#');
+    }
+}
+
+std::string_view MoveNotation::get_view() const
+{
+    return {m_chars.data(), m_size};
+}
+
+MoveNotation to_san(const PositionState& position,
+                    const std::vector<Move>& legal_moves,
+                    const Move& move,
+                    CheckState check_state)
+{
+    MoveNotation notation;
+    if (is_castling(move))
+    {
+        append_castling(notation, move);
+        notation.append(check_state);
+        return notation;
+    }
+    const auto& board = position.get_board();
+    const auto piece_type = board.get_piece_at_position(move.from).get_type();
+    const bool capture = is_capture(board, move);
+    if (piece_type == PieceType::PAWN)
+    {
+        if (capture)
+        {
+            notation.append(static_cast<char>('a' + move.from.x));
+            notation.append('x');
+        }
+        notation.append(move.to);
+        append_promotion(notation, move);
+        notation.append(check_state);
+        return notation;
+    }
+
+    notation.append(to_char(piece_type));
+    bool ambiguous = false;
+    bool same_file = false;
+    bool same_rank = false;
+    for (const auto& legal_move : legal_moves)
+    {
+        if (legal_move.to != move.to || legal_move.from == move.from
+            || board.get_piece_at_position(legal_move.from).get_type() != piece_type)
+        {
+            continue;
+        }
+        ambiguous = true;
+        same_file = same_file || legal_move.from.x == move.from.x;
+        same_rank = same_rank || legal_move.from.y == move.from.y;
+    }
+    if (ambiguous)
+    {
+        if (!same_file)
+        {
+            notation.append(static_cast<char>('a' + move.from.x));
+        }
+        else if (!same_rank)
+        {
+            notation.append(static_cast<char>('1' + move.from.y));
+        }
+        else
+        {
+            notation.append(move.from);
+        }
+    }
+    if (capture)
+    {
+        notation.append('x');
+    }
+    notation.append(move.to);
+    notation.append(check_state);
+    return notation;
+}
+
+MoveNotation to_lan(const PositionState& position, const Move& move, CheckState check_state)
+{
+    MoveNotation notation;
+    if (is_castling(move))
+    {
+        append_castling(notation, move);
+        notation.append(check_state);
+        return notation;
+    }
+    const auto& board = position.get_board();
+    const auto piece_type = board.get_piece_at_position(move.from).get_type();
+    if (piece_type != PieceType::PAWN)
+    {
+        notation.append(to_char(piece_type));
+    }
+    notation.append(move.from);
+    notation.append(is_capture(board, move) ? 'x' : '-');
+    notation.append(move.to);
+    append_promotion(notation, move);
+    notation.append(check_state);
+    return notation;
+}
+
+MoveNotation to_uci(const Move& move)
+{
+    MoveNotation notation;
+    notation.append(move.from);
+    notation.append(move.to);
+    if (move.promotion)
+    {
+        notation.append(static_cast<char>(
+            std::tolower(to_char(static_cast<PieceType>(*move.promotion)))));
+    }
+    return notation;
+}
+
+CheckState get_check_state(PositionState& position, const std::vector<Move>& legal_moves)
+{
+    if (!position.is_in_check())
+    {
+        return CheckState::NONE;
+    }
+    return legal_moves.empty() ? CheckState::CHECKMATE : CheckState::CHECK;
+}
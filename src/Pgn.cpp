@@ -0,0 +1,692 @@
+#include <Notation.hpp>
+#include <Pgn.hpp>
+#include <algorithm>
+#include <cctype>
+#include <charconv>
+#include <stdexcept>
+#include <thread>
+
+namespace
+{
+constexpr std::size_t MAX_LINE_LENGTH = 79;
+
+/**
+ * @brief fullmove number of the FEN tag, 1 if there is no such tag or the field is missing or
+ *  not a positive number
+ */
+std::size_t get_starting_move_number(const std::vector<PgnTag>& tags)
+{
+    const auto fen_tag = std::find_if(tags.begin(), tags.end(),
+                                      [](const PgnTag& tag) { return tag.name == "FEN"; });
+    if (fen_tag == tags.end())
+    {
+        return 1;
+    }
+    auto fen = fen_tag->value;
+    for (std::size_t field_index = 0; field_index != 5; ++field_index)
+    {
+        const auto field_start = fen.find_first_not_of(' ');
+        const auto field_end = fen.find(' ', field_start);
+        fen.remove_prefix(std::min(field_end, fen.size()));
+    }
+    fen.remove_prefix(std::min(fen.find_first_not_of(' '), fen.size()));
+    const auto field = fen.substr(0, std::min(fen.find(' '), fen.size()));
+    std::size_t move_number = 0;
+    const auto [end, error]
+        = std::from_chars(field.data(), field.data() + field.size(), move_number);
+    if (error != std::errc{} || end != field.data() + field.size() || move_number == 0)
+    {
+        return 1;
+    }
+    return move_number;
+}
+
+bool is_symbol_start(char pgn_char)
+{
+    return std::isalnum(static_cast<unsigned char>(pgn_char));
+}
+
+bool is_symbol_continuation(char pgn_char)
+{
+    switch (pgn_char)
+    {
+    case '_':
+    case '+':
+    case '#':
+    case '=':
+    case ':':
+    case '-':
+    case '/':
+    case '!':
+    case '?':
+        return true;
+    default:
+        return is_symbol_start(pgn_char);
+    }
+}
+
+bool is_move_number(std::string_view symbol)
+{
+    return std::all_of(symbol.begin(), symbol.end(),
+                       [](char pgn_char) { return pgn_char >= '0' && pgn_char <= '9'; });
+}
+
+std::optional<GameResult> get_game_result(std::string_view symbol)
+{
+    if (symbol == "1-0")
+    {
+        return GameResult::WHITE_WON;
+    }
+    if (symbol == "0-1")
+    {
+        return GameResult::BLACK_WON;
+    }
+    if (symbol == "1/2-1/2")
+    {
+        return GameResult::DRAW;
+    }
+    return std::nullopt;
+}
+
+void skip_variation(PgnTokenizer& tokenizer)
+{
+    std::size_t depth = 1;
+    while (depth != 0)
+    {
+        const auto token = tokenizer.next_token();
+        if (token.type == PgnTokenType::END_OF_INPUT)
+        {
+            return;
+        }
+        if (token.type == PgnTokenType::LEFT_PARENTHESIS)
+        {
+            ++depth;
+        }
+        else if (token.type == PgnTokenType::RIGHT_PARENTHESIS)
+        {
+            --depth;
+        }
+    }
+}
+
+bool is_blank_line_before(std::string_view pgn, std::size_t line_start)
+{
+    if (line_start == 0)
+    {
+        return true;
+    }
+    // line_start - 1 is the '\n' ending previous line
+    auto offset = line_start - 1;
+    while (offset != 0)
+    {
+        const auto pgn_char = pgn[offset - 1];
+        if (pgn_char == '\n')
+        {
+            return true;
+        }
+        if (pgn_char != '\r' && pgn_char != ' ' && pgn_char != '\t')
+        {
+            return false;
+        }
+        --offset;
+    }
+    return true;
+}
+
+std::size_t find_game_start(std::string_view pgn, std::size_t offset)
+{
+    while (true)
+    {
+        const auto tag_start = pgn.find("\n[", offset);
+        if (tag_start == std::string_view::npos)
+        {
+            return pgn.size();
+        }
+        if (is_blank_line_before(pgn, tag_start + 1))
+        {
+            return tag_start + 1;
+        }
+        offset = tag_start + 1;
+    }
+}
+}  // namespace
+
+const char* to_c_str(GameResult result)
+{
+    switch (result)
+    {
+    case GameResult::WHITE_WON:
+        return "1-0";
+    case GameResult::BLACK_WON:
+        return "0-1";
+    case GameResult::DRAW:
+        return "1/2-1/2";
+    case GameResult::UNKNOWN:
+        return "*";
+    default:
+        return "error";
+    };
+}
+
+PgnTokenizer::PgnTokenizer(std::string_view input)
+    : m_input(input)
+{
+}
+
+std::size_t PgnTokenizer::get_offset() const
+{
+    return m_offset;
+}
+
+void PgnTokenizer::skip_whitespace_and_escapes()
+{
+    while (m_offset < m_input.size())
+    {
+        const auto pgn_char = m_input[m_offset];
+        // escape mechanism: line starting with '%' is ignored
+        if (pgn_char == '%' && (m_offset == 0 || m_input[m_offset - 1] == '\n'))
+        {
+            read_until('\n');
+            continue;
+        }
+        if (!std::isspace(static_cast<unsigned char>(pgn_char)))
+        {
+            return;
+        }
+        ++m_offset;
+    }
+}
+
+std::string_view PgnTokenizer::read_until(char delimiter)
+{
+    const auto text_start = m_offset;
+    const auto text_end = std::min(m_input.find(delimiter, text_start), m_input.size());
+    m_offset = std::min(text_end + 1, m_input.size());
+    return m_input.substr(text_start, text_end - text_start);
+}
+
+PgnToken PgnTokenizer::next_token()
+{
+    while (true)
+    {
+        skip_whitespace_and_escapes();
+        if (m_offset == m_input.size())
+        {
+            return {PgnTokenType::END_OF_INPUT, {}};
+        }
+        const auto token_start = m_offset;
+        const auto pgn_char = m_input[m_offset++];
+        switch (pgn_char)
+        {
+        case '[':
+            return {PgnTokenType::LEFT_BRACKET, m_input.substr(token_start, 1)};
+        case ']':
+            return {PgnTokenType::RIGHT_BRACKET, m_input.substr(token_start, 1)};
+        case '(':
+            return {PgnTokenType::LEFT_PARENTHESIS, m_input.substr(token_start, 1)};
+        case ')':
+            return {PgnTokenType::RIGHT_PARENTHESIS, m_input.substr(token_start, 1)};
+        case '.':
+            return {PgnTokenType::PERIOD, m_input.substr(token_start, 1)};
+        case '*':
+            return {PgnTokenType::ASTERISK, m_input.substr(token_start, 1)};
+        case '{':
+            return {PgnTokenType::COMMENT, read_until('}')};
+        case ';':
+            return {PgnTokenType::COMMENT, read_until('\n')};
+        case '"':
+        {
+            while (m_offset < m_input.size() && m_input[m_offset] != '"')
+            {
+                m_offset += m_input[m_offset] == '\\' ? 2 : 1;
+            }
+            m_offset = std::min(m_offset, m_input.size());
+            const auto text = m_input.substr(token_start + 1, m_offset - token_start - 1);
+            m_offset = std::min(m_offset + 1, m_input.size());
+            return {PgnTokenType::STRING, text};
+        }
+        case '$':
+            while (m_offset < m_input.size()
+                   && std::isdigit(static_cast<unsigned char>(m_input[m_offset])))
+            {
+                ++m_offset;
+            }
+            return {PgnTokenType::NAG, m_input.substr(token_start, m_offset - token_start)};
+        default:
+            break;
+        }
+        if (is_symbol_start(pgn_char))
+        {
+            while (m_offset < m_input.size() && is_symbol_continuation(m_input[m_offset]))
+            {
+                ++m_offset;
+            }
+            return {PgnTokenType::SYMBOL, m_input.substr(token_start, m_offset - token_start)};
+        }
+        // characters not used by pgn grammar are skipped
+    }
+}
+
+PgnToken PgnTokenizer::peek_token()
+{
+    const auto offset = m_offset;
+    const auto token = next_token();
+    m_offset = offset;
+    return token;
+}
+
+PgnParseStats& operator+=(PgnParseStats& lhs, const PgnParseStats& rhs)
+{
+    lhs.games += rhs.games;
+    lhs.invalid_games += rhs.invalid_games;
+    lhs.moves += rhs.moves;
+    return lhs;
+}
+
+std::optional<Move> resolve_san_move(const PositionState& position,
+                                     const AvailableMoves& available_moves,
+                                     std::string_view san)
+{
+    while (!san.empty() && std::string_view{"+#!?"}.find(san.back()) != std::string_view::npos)
+    {
+        san.remove_suffix(1);
+    }
+    const auto king_position = position.get_king_position(position.get_side_to_move());
+    if (san == "O-O" || san == "0-0")
+    {
+        if (!available_moves.king_side_castle_possible)
+        {
+            return std::nullopt;
+        }
+        return Move{king_position, {6, king_position.y}, MoveType::KING_SIDE_CASTLE};
+    }
+    if (san == "O-O-O" || san == "0-0-0")
+    {
+        if (!available_moves.queen_side_castle_possible)
+        {
+            return std::nullopt;
+        }
+        return Move{king_position, {2, king_position.y}, MoveType::QUEEN_SIDE_CASTLE};
+    }
+
+    auto piece_type = PieceType::PAWN;
+    if (!san.empty() && san.front() != 'P' && piece_type_from_char(san.front()))
+    {
+        piece_type = *piece_type_from_char(san.front());
+        san.remove_prefix(1);
+    }
+    std::optional<PromotablePieceType> promotion;
+    if (!san.empty() && piece_type_from_char(san.back()))
+    {
+        const auto promotion_type = *piece_type_from_char(san.back());
+        if (promotion_type == PieceType::KING || promotion_type == PieceType::PAWN)
+        {
+            return std::nullopt;
+        }
+        promotion = static_cast<PromotablePieceType>(promotion_type);
+        san.remove_suffix(1);
+        if (!san.empty() && san.back() == '=')
+        {
+            san.remove_suffix(1);
+        }
+    }
+    if (san.size() < 2)
+    {
+        return std::nullopt;
+    }
+    const auto destination = position_from_string(san.substr(san.size() - 2));
+    if (!destination)
+    {
+        return std::nullopt;
+    }
+    san.remove_suffix(2);
+    if (!san.empty() && (san.back() == 'x' || san.back() == ':'))
+    {
+        san.remove_suffix(1);
+    }
+    std::optional<std::int32_t> from_x;
+    std::optional<std::int32_t> from_y;
+    for (const auto disambiguation_char : san)
+    {
+        if (disambiguation_char >= 'a' && disambiguation_char <= 'h')
+        {
+            from_x = disambiguation_char - 'a';
+        }
+        else if (disambiguation_char >= '1' && disambiguation_char <= '8')
+        {
+            from_y = disambiguation_char - '1';
+        }
+        else
+        {
+            return std::nullopt;
+        }
+    }
+
+    const auto& board = position.get_board();
+    std::optional<Position> from;
+    for (const auto& move_list : available_moves.normal_moves)
+    {
+        const auto& piece_position = move_list.first;
+        if ((from_x && piece_position.x != *from_x) || (from_y && piece_position.y != *from_y)
+            || board.get_piece_at_position(piece_position).get_type() != piece_type
+            || !move_list.second.count(*destination))
+        {
+            continue;
+        }
+        if (from)
+        {
+            return std::nullopt;
+        }
+        from = piece_position;
+    }
+    if (!from)
+    {
+        return std::nullopt;
+    }
+    const bool reaches_last_rank
+        = piece_type == PieceType::PAWN && (destination->y == 0 || destination->y == 7);
+    if (reaches_last_rank != promotion.has_value())
+    {
+        return std::nullopt;
+    }
+    return position.create_move(*from, *destination, promotion);
+}
+
+PgnReader::PgnReader(PgnVisitor& visitor)
+    : m_visitor(visitor)
+    , m_position(PositionState::get_starting_position())
+{
+}
+
+PgnParseStats PgnReader::parse(std::string_view pgn)
+{
+    m_stats = {};
+    PgnTokenizer tokenizer{pgn};
+    while (tokenizer.peek_token().type != PgnTokenType::END_OF_INPUT)
+    {
+        parse_game(tokenizer);
+    }
+    return m_stats;
+}
+
+void PgnReader::reset_position()
+{
+    while (!m_played_moves.empty())
+    {
+        m_position.unmake_move(m_played_moves.back().first, m_played_moves.back().second);
+        m_played_moves.pop_back();
+    }
+    if (!m_position_is_starting)
+    {
+        m_position = PositionState::get_starting_position();
+        m_position_is_starting = true;
+    }
+}
+
+void PgnReader::parse_tag(PgnTokenizer& tokenizer, std::string_view& invalid_reason)
+{
+    const auto name = tokenizer.next_token();
+    const auto value = tokenizer.next_token();
+    if (name.type != PgnTokenType::SYMBOL || value.type != PgnTokenType::STRING
+        || tokenizer.next_token().type != PgnTokenType::RIGHT_BRACKET)
+    {
+        invalid_reason = "Malformed tag pair";
+        return;
+    }
+    m_visitor.visit_tag(name.text, value.text);
+    if (name.text != "FEN")
+    {
+        return;
+    }
+    try
+    {
+        m_position = PositionState::from_fen(value.text);
+        m_position_is_starting = false;
+    }
+    catch (const std::invalid_argument&)
+    {
+        invalid_reason = "Invalid FEN tag";
+    }
+}
+
+bool PgnReader::play_san_move(std::string_view san)
+{
+    const auto available_moves = m_position.generate_available_moves();
+    const auto move = resolve_san_move(m_position, available_moves, san);
+    if (!move)
+    {
+        return false;
+    }
+    m_visitor.visit_move(m_position, *move);
+    m_played_moves.emplace_back(*move, m_position.make_move(*move));
+    return true;
+}
+
+void PgnReader::parse_game(PgnTokenizer& tokenizer)
+{
+    m_visitor.begin_game();
+    std::string_view invalid_reason;
+    while (tokenizer.peek_token().type == PgnTokenType::LEFT_BRACKET)
+    {
+        tokenizer.next_token();
+        parse_tag(tokenizer, invalid_reason);
+    }
+
+    auto result = GameResult::UNKNOWN;
+    while (true)
+    {
+        const auto token = tokenizer.peek_token();
+        // next game started without game termination marker
+        if (token.type == PgnTokenType::END_OF_INPUT || token.type == PgnTokenType::LEFT_BRACKET)
+        {
+            break;
+        }
+        tokenizer.next_token();
+        if (token.type == PgnTokenType::ASTERISK)
+        {
+            break;
+        }
+        if (token.type == PgnTokenType::LEFT_PARENTHESIS)
+        {
+            skip_variation(tokenizer);
+            continue;
+        }
+        if (token.type != PgnTokenType::SYMBOL || is_move_number(token.text))
+        {
+            continue;
+        }
+        if (const auto game_result = get_game_result(token.text))
+        {
+            result = *game_result;
+            break;
+        }
+        if (invalid_reason.empty() && !play_san_move(token.text))
+        {
+            invalid_reason = "Illegal or ambiguous move";
+        }
+    }
+
+    ++m_stats.games;
+    if (invalid_reason.empty())
+    {
+        m_stats.moves += m_played_moves.size();
+        m_visitor.end_game(result);
+    }
+    else
+    {
+        ++m_stats.invalid_games;
+        m_visitor.invalid_game(invalid_reason);
+    }
+    reset_position();
+}
+
+PgnWriter::PgnWriter(std::ostream& output, std::size_t buffer_size)
+    : m_output(output)
+{
+    m_buffer.reserve(buffer_size);
+}
+
+PgnWriter::~PgnWriter()
+{
+    flush();
+}
+
+void PgnWriter::flush()
+{
+    m_output.write(m_buffer.data(), static_cast<std::streamsize>(m_buffer.size()));
+    m_buffer.clear();
+}
+
+void PgnWriter::append(std::string_view text)
+{
+    if (m_buffer.size() + text.size() > m_buffer.capacity())
+    {
+        flush();
+    }
+    if (text.size() > m_buffer.capacity())
+    {
+        m_output.write(text.data(), static_cast<std::streamsize>(text.size()));
+        return;
+    }
+    m_buffer.insert(m_buffer.end(), text.begin(), text.end());
+}
+
+void PgnWriter::append_movetext_token(std::string_view token)
+{
+    if (m_line_length != 0)
+    {
+        if (m_line_length + 1 + token.size() > MAX_LINE_LENGTH)
+        {
+            append("\n");
+            m_line_length = 0;
+        }
+        else
+        {
+            append(" ");
+            ++m_line_length;
+        }
+    }
+    append(token);
+    m_line_length += token.size();
+}
+
+void PgnWriter::append_move(std::size_t move_number,
+                            bool with_move_number,
+                            bool black_to_move,
+                            std::string_view san)
+{
+    // move number is kept on the same line as its move
+    std::array<char, 32 + MoveNotation::MAX_SIZE> token_chars;
+    auto token_end = token_chars.data();
+    if (with_move_number)
+    {
+        token_end = std::to_chars(token_end, token_end + 20, move_number).ptr;
+        *token_end++ = '.';
+        if (black_to_move)
+        {
+            *token_end++ = '.';
+            *token_end++ = '.';
+        }
+        *token_end++ = ' ';
+    }
+    token_end = std::copy(san.begin(), san.end(), token_end);
+    append_movetext_token(
+        {token_chars.data(), static_cast<std::size_t>(token_end - token_chars.data())});
+}
+
+void PgnWriter::write_game(const std::vector<PgnTag>& tags,
+                           PositionState& position,
+                           const std::vector<Move>& moves,
+                           GameResult result)
+{
+    for (const auto& tag : tags)
+    {
+        append("[");
+        append(tag.name);
+        append(" \"");
+        for (std::size_t value_start = 0; value_start < tag.value.size();)
+        {
+            const auto escape_position
+                = std::min(tag.value.find_first_of("\\\"", value_start), tag.value.size());
+            append(tag.value.substr(value_start, escape_position - value_start));
+            if (escape_position != tag.value.size())
+            {
+                append("\\");
+                append(tag.value.substr(escape_position, 1));
+            }
+            value_start = escape_position + 1;
+        }
+        append("\"]\n");
+    }
+    if (!tags.empty())
+    {
+        append("\n");
+    }
+
+    m_line_length = 0;
+    m_undo_infos.clear();
+    position.generate_legal_moves(m_legal_moves);
+    auto move_number = get_starting_move_number(tags);
+    for (const auto& move : moves)
+    {
+        const bool black_to_move = position.get_side_to_move() == PieceColor::BLACK;
+        auto notation = to_san(position, m_legal_moves, move);
+        m_undo_infos.push_back(position.make_move(move));
+        position.generate_legal_moves(m_next_legal_moves);
+        notation.append(get_check_state(position, m_next_legal_moves));
+        append_move(move_number, !black_to_move || m_undo_infos.size() == 1, black_to_move,
+                    notation.get_view());
+        std::swap(m_legal_moves, m_next_legal_moves);
+        move_number += black_to_move ? 1 : 0;
+    }
+    append_movetext_token(to_c_str(result));
+    append("\n\n");
+
+    for (auto move = moves.rbegin(); move != moves.rend(); ++move)
+    {
+        position.unmake_move(*move, m_undo_infos.back());
+        m_undo_infos.pop_back();
+    }
+}
+
+std::vector<std::string_view> split_pgn_games(std::string_view pgn, std::size_t chunk_count)
+{
+    std::vector<std::string_view> chunks;
+    chunk_count = std::max<std::size_t>(chunk_count, 1);
+    std::size_t chunk_start = 0;
+    for (std::size_t chunk_index = 1; chunk_index <= chunk_count && chunk_start < pgn.size();
+         ++chunk_index)
+    {
+        const auto split_offset = std::max(chunk_start, pgn.size() / chunk_count * chunk_index);
+        const auto chunk_end
+            = chunk_index == chunk_count ? pgn.size() : find_game_start(pgn, split_offset);
+        if (chunk_end > chunk_start)
+        {
+            chunks.push_back(pgn.substr(chunk_start, chunk_end - chunk_start));
+        }
+        chunk_start = chunk_end;
+    }
+    return chunks;
+}
+
+PgnParseStats parse_pgn_parallel(std::string_view pgn, const std::vector<PgnVisitor*>& visitors)
+{
+    const auto chunks = split_pgn_games(pgn, visitors.size());
+    std::vector<PgnParseStats> chunk_stats(chunks.size());
+    std::vector<std::thread> workers;
+    workers.reserve(chunks.size());
+    for (std::size_t chunk_index = 0; chunk_index != chunks.size(); ++chunk_index)
+    {
+        workers.emplace_back([&, chunk_index] {
+            PgnReader reader{*visitors[chunk_index]};
+            chunk_stats[chunk_index] = reader.parse(chunks[chunk_index]);
+        });
+    }
+    PgnParseStats stats;
+    for (std::size_t chunk_index = 0; chunk_index != workers.size(); ++chunk_index)
+    {
+        workers[chunk_index].join();
+        stats += chunk_stats[chunk_index];
+    }
+    return stats;
+}
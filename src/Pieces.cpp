@@ -21,6 +21,48 @@ const char* to_c_str(PieceType piece_type)
     };
 }
 
+std::optional<PieceType> piece_type_from_char(char piece_char)
+{
+    switch (piece_char)
+    {
+    case 'K':
+        return PieceType::KING;
+    case 'Q':
+        return PieceType::QUEEN;
+    case 'B':
+        return PieceType::BISHOP;
+    case 'N':
+        return PieceType::KNIGHT;
+    case 'R':
+        return PieceType::ROOK;
+    case 'P':
+        return PieceType::PAWN;
+    default:
+        return std::nullopt;
+    };
+}
+
+char to_char(PieceType piece_type)
+{
+    switch (piece_type)
+    {
+    case PieceType::KING:
+        return 'K';
+    case PieceType::QUEEN:
+        return 'Q';
+    case PieceType::BISHOP:
+        return 'B';
+    case PieceType::KNIGHT:
+        return 'N';
+    case PieceType::ROOK:
+        return 'R';
+    case PieceType::PAWN:
+        return 'P';
+    default:
+        return '?';
+    };
+}
+
 const char* to_c_str(PromotablePieceType promotable_piece_type)
 {
     switch (promotable_piece_type)
@@ -56,6 +98,21 @@ PieceColor get_opposite_color(PieceColor color)
     return color == PieceColor::WHITE ? PieceColor::BLACK : PieceColor::WHITE;
 }
 
+std::optional<Position> position_from_string(std::string_view square_name)
+{
+    if (square_name.size() != 2 || square_name[0] < 'a' || square_name[0] > 'h'
+        || square_name[1] < '1' || square_name[1] > '8')
+    {
+        return std::nullopt;
+    }
+    return Position{square_name[0] - 'a', square_name[1] - '1'};
+}
+
+std::string to_string(const Position& position)
+{
+    return {static_cast<char>('a' + position.x), static_cast<char>('1' + position.y)};
+}
+
 std::unique_ptr<Piece> Piece::get_piece_from_type(PieceType piece_type,
                                                   PieceColor piece_color,
                                                   const Position& piece_position)
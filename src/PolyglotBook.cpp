@@ -0,0 +1,158 @@
+#include <PolyglotBook.hpp>
+#include <Zobrist.hpp>
+#include <algorithm>
+#include <mutex>
+#include <stdexcept>
+#include <unordered_map>
+
+namespace
+{
+constexpr std::size_t ENTRY_SIZE = 16;
+constexpr std::size_t KEY_OFFSET = 0;
+constexpr std::size_t MOVE_OFFSET = 8;
+constexpr std::size_t WEIGHT_OFFSET = 10;
+
+template <typename T>
+T read_big_endian(const std::byte* data)
+{
+    T value = 0;
+    for (std::size_t i = 0; i != sizeof(T); ++i)
+    {
+        value = static_cast<T>((value << 8) | std::to_integer<T>(data[i]));
+    }
+    return value;
+}
+
+/**
+ * @note polyglot promotion encoding: 1 knight, 2 bishop, 3 rook, 4 queen
+ */
+std::optional<PromotablePieceType> get_promotion(std::uint16_t polyglot_move)
+{
+    switch ((polyglot_move >> 12) & 0x7)
+    {
+    case 1:
+        return PromotablePieceType::KNIGHT;
+    case 2:
+        return PromotablePieceType::BISHOP;
+    case 3:
+        return PromotablePieceType::ROOK;
+    case 4:
+        return PromotablePieceType::QUEEN;
+    default:
+        return std::nullopt;
+    }
+}
+}  // namespace
+
+PolyglotBook::PolyglotBook(const std::string& path)
+    : m_file(path)
+{
+    if (m_file.get_size() % ENTRY_SIZE != 0)
+    {
+        throw std::runtime_error("Polyglot book size is not a multiple of entry size " + path);
+    }
+}
+
+std::shared_ptr<const PolyglotBook> PolyglotBook::open_shared(const std::string& path)
+{
+    static std::mutex books_mutex;
+    static std::unordered_map<std::string, std::weak_ptr<const PolyglotBook>> books;
+
+    std::lock_guard<std::mutex> lock{books_mutex};
+    auto& book = books[path];
+    if (auto opened_book = book.lock())
+    {
+        return opened_book;
+    }
+    auto opened_book = std::make_shared<const PolyglotBook>(path);
+    book = opened_book;
+    return opened_book;
+}
+
+std::size_t PolyglotBook::get_entry_count() const
+{
+    return m_file.get_size() / ENTRY_SIZE;
+}
+
+std::uint64_t PolyglotBook::get_entry_key(std::size_t index) const
+{
+    return read_big_endian<std::uint64_t>(m_file.get_data() + index * ENTRY_SIZE + KEY_OFFSET);
+}
+
+BookMove PolyglotBook::get_entry_move(std::size_t index, const PositionState& position) const
+{
+    const auto entry = m_file.get_data() + index * ENTRY_SIZE;
+    const auto polyglot_move = read_big_endian<std::uint16_t>(entry + MOVE_OFFSET);
+    const auto weight = read_big_endian<std::uint16_t>(entry + WEIGHT_OFFSET);
+    const Position to{polyglot_move & 0x7, (polyglot_move >> 3) & 0x7};
+    const Position from{(polyglot_move >> 6) & 0x7, (polyglot_move >> 9) & 0x7};
+
+    const auto& board = position.get_board();
+    if (board.is_square_empty(from))
+    {
+        return {{from, to}, weight};
+    }
+    const auto& moving_piece = board.get_piece_at_position(from);
+    // castling is stored as king capturing own rook
+    if (moving_piece.get_type() == PieceType::KING && !board.is_square_empty(to)
+        && board.get_piece_at_position(to).get_color() == moving_piece.get_color())
+    {
+        const bool king_side = to.x > from.x;
+        return {{from, {king_side ? 6 : 2, from.y},
+                 king_side ? MoveType::KING_SIDE_CASTLE : MoveType::QUEEN_SIDE_CASTLE},
+                weight};
+    }
+    return {position.create_move(from, to, get_promotion(polyglot_move)), weight};
+}
+
+void PolyglotBook::get_moves(const PositionState& position, std::vector<BookMove>& moves) const
+{
+    moves.clear();
+    const auto key = get_zobrist_key(position);
+    std::size_t first = 0;
+    std::size_t count = get_entry_count();
+    while (count != 0)
+    {
+        const auto step = count / 2;
+        if (get_entry_key(first + step) < key)
+        {
+            first += step + 1;
+            count -= step + 1;
+        }
+        else
+        {
+            count = step;
+        }
+    }
+    for (auto index = first; index != get_entry_count() && get_entry_key(index) == key; ++index)
+    {
+        moves.push_back(get_entry_move(index, position));
+    }
+}
+
+std::optional<Move> PolyglotBook::choose_move(const PositionState& position,
+                                              std::mt19937_64& random_generator) const
+{
+    std::vector<BookMove> moves;
+    get_moves(position, moves);
+    std::uint64_t total_weight = 0;
+    for (const auto& book_move : moves)
+    {
+        total_weight += book_move.weight;
+    }
+    if (total_weight == 0)
+    {
+        return std::nullopt;
+    }
+    std::uniform_int_distribution<std::uint64_t> distribution{0, total_weight - 1};
+    auto choice = distribution(random_generator);
+    for (const auto& book_move : moves)
+    {
+        if (choice < book_move.weight)
+        {
+            return book_move.move;
+        }
+        choice -= book_move.weight;
+    }
+    return std::nullopt;
+}
@@ -0,0 +1,406 @@
+#include <PositionState.hpp>
+#include <Attacks.hpp>
+#include <algorithm>
+#include <cctype>
+#include <cstdlib>
+#include <stdexcept>
+
+namespace
+{
+constexpr std::string_view STARTING_POSITION_FEN
+    = "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1";
+
+std::int32_t get_back_rank(PieceColor color)
+{
+    return color == PieceColor::WHITE ? 0 : 7;
+}
+
+std::int32_t get_promotion_rank(PieceColor color)
+{
+    return color == PieceColor::WHITE ? 7 : 0;
+}
+
+char to_upper(char fen_char)
+{
+    return static_cast<char>(std::toupper(static_cast<unsigned char>(fen_char)));
+}
+
+bool is_upper(char fen_char)
+{
+    return std::isupper(static_cast<unsigned char>(fen_char));
+}
+
+std::string_view next_fen_field(std::string_view& fen)
+{
+    const auto field_start = fen.find_first_not_of(' ');
+    if (field_start == std::string_view::npos)
+    {
+        fen = {};
+        return {};
+    }
+    fen.remove_prefix(field_start);
+    const auto field_end = std::min(fen.find(' '), fen.size());
+    const auto field = fen.substr(0, field_end);
+    fen.remove_prefix(field_end);
+    return field;
+}
+
+bool is_piece_at_position(const Board& board,
+                          const Position& position,
+                          PieceType piece_type,
+                          PieceColor piece_color)
+{
+    if (board.is_square_empty(position))
+    {
+        return false;
+    }
+    const auto& piece = board.get_piece_at_position(position);
+    return piece.get_type() == piece_type && piece.get_color() == piece_color;
+}
+}  // namespace
+
+PositionState::PositionState() = default;
+
+PositionState PositionState::get_starting_position()
+{
+    return from_fen(STARTING_POSITION_FEN);
+}
+
+PositionState PositionState::from_fen(std::string_view fen)
+{
+    PositionState state;
+    const auto placement = next_fen_field(fen);
+    const auto side_to_move = next_fen_field(fen);
+    const auto castling = next_fen_field(fen);
+    const auto en_passant = next_fen_field(fen);
+    if (en_passant.empty())
+    {
+        throw std::invalid_argument("FEN must contain at least 4 fields");
+    }
+
+    std::array<std::int32_t, 2> king_count{0, 0};
+    Position position{0, 7};
+    for (const auto fen_char : placement)
+    {
+        if (fen_char == '/')
+        {
+            if (position.x != 8 || position.y == 0)
+            {
+                throw std::invalid_argument("FEN rank has wrong size");
+            }
+            position = {0, position.y - 1};
+            continue;
+        }
+        if (fen_char >= '1' && fen_char <= '8')
+        {
+            position.x += fen_char - '0';
+            if (position.x > 8)
+            {
+                throw std::invalid_argument("FEN rank has wrong size");
+            }
+            continue;
+        }
+        const auto piece_type = piece_type_from_char(to_upper(fen_char));
+        if (!piece_type || !Board::is_piece_position_valid(position))
+        {
+            throw std::invalid_argument("FEN contains invalid piece placement");
+        }
+        const auto piece_color = is_upper(fen_char) ? PieceColor::WHITE : PieceColor::BLACK;
+        if (*piece_type == PieceType::KING)
+        {
+            ++king_count[to_index(piece_color)];
+        }
+        state.m_board.add_piece(PieceCode{*piece_type, piece_color}, position);
+        ++position.x;
+    }
+    if (position.x != 8 || position.y != 0)
+    {
+        throw std::invalid_argument("FEN placement does not describe 8 ranks");
+    }
+    if (king_count[0] != 1 || king_count[1] != 1)
+    {
+        throw std::invalid_argument("FEN must contain exactly one king of each color");
+    }
+
+    if (side_to_move == "w")
+    {
+        state.m_side_to_move = PieceColor::WHITE;
+    }
+    else if (side_to_move == "b")
+    {
+        state.m_side_to_move = PieceColor::BLACK;
+    }
+    else
+    {
+        throw std::invalid_argument("FEN side to move must be 'w' or 'b'");
+    }
+
+    if (castling != "-")
+    {
+        for (const auto castling_char : castling)
+        {
+            const auto color = is_upper(castling_char) ? PieceColor::WHITE : PieceColor::BLACK;
+            const auto back_rank = get_back_rank(color);
+            const bool king_side = to_upper(castling_char) == 'K';
+            if (!king_side && to_upper(castling_char) != 'Q')
+            {
+                throw std::invalid_argument("FEN castling field is invalid");
+            }
+            const Position rook_position{king_side ? 7 : 0, back_rank};
+            if (state.m_board.get_king_position(color) != Position{4, back_rank}
+                || !is_piece_at_position(state.m_board, rook_position, PieceType::ROOK, color))
+            {
+                throw std::invalid_argument("FEN castling rights do not match the board");
+            }
+            auto& rights = state.m_castling_rights[to_index(color)];
+            (king_side ? rights.king_side_rook : rights.queen_side_rook) = rook_position;
+        }
+    }
+
+    if (en_passant != "-")
+    {
+        const auto en_passant_position = position_from_string(en_passant);
+        const auto pawn_offset = state.m_side_to_move == PieceColor::WHITE ? -1 : 1;
+        if (!en_passant_position
+            || en_passant_position->y != (state.m_side_to_move == PieceColor::WHITE ? 5 : 2)
+            || !is_piece_at_position(state.m_board, *en_passant_position + Position{0, pawn_offset},
+                                     PieceType::PAWN,
+                                     get_opposite_color(state.m_side_to_move)))
+        {
+            throw std::invalid_argument("FEN en passant square is invalid");
+        }
+        state.m_en_passant_takable = en_passant_position;
+    }
+    return state;
+}
+
+PositionState PositionState::clone() const
+{
+    return *this;
+}
+
+Board& PositionState::get_board()
+{
+    return m_board;
+}
+
+const Board& PositionState::get_board() const
+{
+    return m_board;
+}
+
+PieceColor PositionState::get_side_to_move() const
+{
+    return m_side_to_move;
+}
+
+Position PositionState::get_king_position(PieceColor color) const
+{
+    return *m_board.get_king_position(color);
+}
+
+const CastlingRights& PositionState::get_castling_rights(PieceColor color) const
+{
+    return m_castling_rights[to_index(color)];
+}
+
+const std::optional<Position>& PositionState::get_en_passant_takable() const
+{
+    return m_en_passant_takable;
+}
+
+SpecialMovesData PositionState::get_special_moves_data() const
+{
+    const auto& rights = m_castling_rights[to_index(m_side_to_move)];
+    return {!rights.queen_side_rook && !rights.king_side_rook, m_en_passant_takable,
+            rights.queen_side_rook, rights.king_side_rook};
+}
+
+bool PositionState::is_in_check() const
+{
+    return is_square_attacked(m_board, Square{get_king_position(m_side_to_move)},
+                              get_opposite_color(m_side_to_move));
+}
+
+AvailableMoves PositionState::generate_available_moves()
+{
+    return ::generate_available_moves(m_board, get_special_moves_data(), m_side_to_move);
+}
+
+bool PositionState::is_move_legal(const Position& from,
+                                  const Position& to,
+                                  std::optional<PromotablePieceType> promotion) const
+{
+    return ::is_move_legal(m_board, get_special_moves_data(), m_side_to_move, from, to,
+                           promotion);
+}
+
+std::size_t PositionState::count_legal_moves() const
+{
+    return ::count_legal_moves(m_board, get_special_moves_data(), m_side_to_move);
+}
+
+bool PositionState::has_any_legal_move() const
+{
+    return ::has_any_legal_move(m_board, get_special_moves_data(), m_side_to_move);
+}
+
+void PositionState::generate_legal_moves(std::vector<Move>& moves)
+{
+    moves.clear();
+    const auto available_moves = generate_available_moves();
+    const auto promotion_rank = get_promotion_rank(m_side_to_move);
+    for (const auto& move_list : available_moves.normal_moves)
+    {
+        const bool is_pawn
+            = m_board.get_piece_at_position(move_list.first).get_type() == PieceType::PAWN;
+        for (const auto& move_position : move_list.second)
+        {
+            if (is_pawn && move_position.y == promotion_rank)
+            {
+                for (const auto promotion : {PromotablePieceType::QUEEN, PromotablePieceType::ROOK,
+                                             PromotablePieceType::BISHOP,
+                                             PromotablePieceType::KNIGHT})
+                {
+                    moves.push_back({move_list.first, move_position, MoveType::NORMAL, promotion});
+                }
+                continue;
+            }
+            moves.push_back(create_move(move_list.first, move_position));
+        }
+    }
+    const auto king_position = get_king_position(m_side_to_move);
+    if (available_moves.king_side_castle_possible)
+    {
+        moves.push_back({king_position, {6, king_position.y}, MoveType::KING_SIDE_CASTLE});
+    }
+    if (available_moves.queen_side_castle_possible)
+    {
+        moves.push_back({king_position, {2, king_position.y}, MoveType::QUEEN_SIDE_CASTLE});
+    }
+}
+
+Move PositionState::create_move(const Position& from,
+                                const Position& to,
+                                std::optional<PromotablePieceType> promotion) const
+{
+    const auto piece_type = m_board.get_piece_at_position(from).get_type();
+    if (piece_type == PieceType::KING && std::abs(to.x - from.x) == 2)
+    {
+        return {from, to,
+                to.x > from.x ? MoveType::KING_SIDE_CASTLE : MoveType::QUEEN_SIDE_CASTLE};
+    }
+    if (piece_type == PieceType::PAWN && to.x != from.x && m_board.is_square_empty(to))
+    {
+        return {from, to, MoveType::EN_PASSANT};
+    }
+    return {from, to, MoveType::NORMAL, promotion};
+}
+
+void PositionState::move_piece(const Position& from, const Position& to)
+{
+    m_board.add_piece(m_board.remove_piece_code(from), to);
+}
+
+void PositionState::update_castling_rights(const Position& square)
+{
+    for (auto& rights : m_castling_rights)
+    {
+        if (rights.queen_side_rook == square)
+        {
+            rights.queen_side_rook.reset();
+        }
+        if (rights.king_side_rook == square)
+        {
+            rights.king_side_rook.reset();
+        }
+    }
+}
+
+UndoInfo PositionState::make_move(const Move& move)
+{
+    UndoInfo undo_info{std::nullopt, m_en_passant_takable, m_castling_rights};
+    const auto color = m_side_to_move;
+    const auto moving_piece_type = m_board.get_piece_at_position(move.from).get_type();
+
+    if (move.type == MoveType::EN_PASSANT)
+    {
+        m_board.remove_piece_code({move.to.x, move.from.y});
+        undo_info.captured_piece = PieceType::PAWN;
+    }
+    else if (const auto captured_piece = m_board.remove_piece_code(move.to);
+             !captured_piece.is_empty())
+    {
+        undo_info.captured_piece = captured_piece.get_type();
+    }
+
+    if (move.promotion)
+    {
+        m_board.remove_piece_code(move.from);
+        m_board.add_piece(PieceCode{static_cast<PieceType>(*move.promotion), color}, move.to);
+    }
+    else
+    {
+        move_piece(move.from, move.to);
+    }
+
+    const auto back_rank = move.from.y;
+    if (move.type == MoveType::KING_SIDE_CASTLE)
+    {
+        move_piece({7, back_rank}, {5, back_rank});
+    }
+    else if (move.type == MoveType::QUEEN_SIDE_CASTLE)
+    {
+        move_piece({0, back_rank}, {3, back_rank});
+    }
+
+    m_en_passant_takable.reset();
+    if (moving_piece_type == PieceType::PAWN && std::abs(move.to.y - move.from.y) == 2)
+    {
+        m_en_passant_takable = Position{move.from.x, (move.from.y + move.to.y) / 2};
+    }
+    if (moving_piece_type == PieceType::KING)
+    {
+        m_castling_rights[to_index(color)] = {};
+    }
+    update_castling_rights(move.from);
+    update_castling_rights(move.to);
+    m_side_to_move = get_opposite_color(color);
+    return undo_info;
+}
+
+void PositionState::unmake_move(const Move& move, const UndoInfo& undo_info)
+{
+    m_side_to_move = get_opposite_color(m_side_to_move);
+    const auto color = m_side_to_move;
+
+    const auto back_rank = move.from.y;
+    if (move.type == MoveType::KING_SIDE_CASTLE)
+    {
+        move_piece({5, back_rank}, {7, back_rank});
+    }
+    else if (move.type == MoveType::QUEEN_SIDE_CASTLE)
+    {
+        move_piece({3, back_rank}, {0, back_rank});
+    }
+
+    if (move.promotion)
+    {
+        m_board.remove_piece_code(move.to);
+        m_board.add_piece(PieceCode{PieceType::PAWN, color}, move.from);
+    }
+    else
+    {
+        move_piece(move.to, move.from);
+    }
+
+    if (undo_info.captured_piece)
+    {
+        const auto captured_position
+            = move.type == MoveType::EN_PASSANT ? Position{move.to.x, move.from.y} : move.to;
+        m_board.add_piece(PieceCode{*undo_info.captured_piece, get_opposite_color(color)},
+                          captured_position);
+    }
+    m_en_passant_takable = undo_info.en_passant_takable;
+    m_castling_rights = undo_info.castling_rights;
+}
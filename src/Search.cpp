@@ -0,0 +1,272 @@
+#include <Evaluation.hpp>
+#include <Search.hpp>
+#include <algorithm>
+#include <cstdlib>
+
+namespace
+{
+constexpr std::size_t MAX_SEARCH_PLY = 128;
+constexpr std::int32_t INFINITE_SCORE = MATE_SCORE + 1;
+constexpr std::uint64_t STOP_CHECK_INTERVAL = 1024;
+
+class Searcher
+{
+public:
+    Searcher(GameState& game, const SearchLimits& limits, const std::atomic<bool>& stop_requested);
+
+    SearchResult run(const SearchProgressCallback& on_depth_completed);
+
+private:
+    std::int32_t negamax(std::uint32_t depth, std::size_t ply, std::int32_t alpha,
+                         std::int32_t beta);
+    std::int32_t quiescence(std::size_t ply, std::int32_t alpha, std::int32_t beta);
+    /**
+     * @brief principal variation move first, then captures by value of victim, then the rest
+     */
+    void order_moves(std::vector<Move>& moves, std::size_t ply) const;
+    bool is_capture(const Move& move) const;
+    bool should_stop();
+    void update_principal_variation(std::size_t ply, const Move& move);
+
+private:
+    GameState& m_game;
+    const SearchLimits& m_limits;
+    const std::atomic<bool>& m_stop_requested;
+    std::chrono::steady_clock::time_point m_deadline;
+    std::uint64_t m_nodes{0};
+    bool m_aborted{false};
+    std::vector<std::vector<Move>> m_moves;
+    std::vector<std::vector<Move>> m_principal_variations;
+    std::vector<Move> m_previous_principal_variation;
+};
+
+Searcher::Searcher(GameState& game,
+                   const SearchLimits& limits,
+                   const std::atomic<bool>& stop_requested)
+    : m_game{game}
+    , m_limits{limits}
+    , m_stop_requested{stop_requested}
+    , m_deadline{std::chrono::steady_clock::time_point::max()}
+    , m_moves(MAX_SEARCH_PLY + 1)
+    , m_principal_variations(MAX_SEARCH_PLY + 1)
+{
+    if (m_limits.move_time)
+    {
+        m_deadline = std::chrono::steady_clock::now() + *m_limits.move_time;
+    }
+}
+
+SearchResult Searcher::run(const SearchProgressCallback& on_depth_completed)
+{
+    SearchResult result;
+    auto& root_moves = m_moves[0];
+    m_game.get_position().generate_legal_moves(root_moves);
+    if (root_moves.empty())
+    {
+        result.score = m_game.get_position().is_in_check() ? -MATE_SCORE : 0;
+        return result;
+    }
+    result.best_move = root_moves.front();
+
+    const auto max_depth = std::min<std::uint32_t>(m_limits.max_depth, MAX_SEARCH_DEPTH);
+    for (std::uint32_t depth = 1; depth <= max_depth; ++depth)
+    {
+        const auto score = negamax(depth, 0, -INFINITE_SCORE, INFINITE_SCORE);
+        if (m_aborted)
+        {
+            // a partial iteration still improves on the previous one if it found a better move
+            if (!m_principal_variations[0].empty() && result.depth == 0)
+            {
+                result.best_move = m_principal_variations[0].front();
+            }
+            break;
+        }
+        m_previous_principal_variation = m_principal_variations[0];
+        result.best_move = m_previous_principal_variation.front();
+        result.principal_variation = m_previous_principal_variation;
+        result.score = score;
+        result.depth = depth;
+        result.nodes = m_nodes;
+        if (on_depth_completed)
+        {
+            on_depth_completed(result);
+        }
+        if (is_mate_score(score))
+        {
+            break;
+        }
+    }
+    result.nodes = m_nodes;
+    return result;
+}
+
+std::int32_t Searcher::negamax(std::uint32_t depth,
+                               std::size_t ply,
+                               std::int32_t alpha,
+                               std::int32_t beta)
+{
+    m_principal_variations[ply].clear();
+    if (should_stop())
+    {
+        return 0;
+    }
+    ++m_nodes;
+    if (ply != 0
+        && (m_game.is_repetition() || m_game.is_fifty_move_rule_draw()
+            || m_game.is_insufficient_material()))
+    {
+        return 0;
+    }
+    if (depth == 0 || ply == MAX_SEARCH_PLY)
+    {
+        return quiescence(ply, alpha, beta);
+    }
+
+    auto& moves = m_moves[ply];
+    auto& position = m_game.get_position();
+    position.generate_legal_moves(moves);
+    if (moves.empty())
+    {
+        return position.is_in_check() ? -MATE_SCORE + static_cast<std::int32_t>(ply) : 0;
+    }
+    order_moves(moves, ply);
+    for (const auto& move : moves)
+    {
+        m_game.make_move(move);
+        const auto score = -negamax(depth - 1, ply + 1, -beta, -alpha);
+        m_game.unmake_move();
+        if (m_aborted)
+        {
+            return 0;
+        }
+        if (score > alpha)
+        {
+            alpha = score;
+            update_principal_variation(ply, move);
+            if (alpha >= beta)
+            {
+                break;
+            }
+        }
+    }
+    return alpha;
+}
+
+std::int32_t Searcher::quiescence(std::size_t ply, std::int32_t alpha, std::int32_t beta)
+{
+    m_principal_variations[ply].clear();
+    auto& position = m_game.get_position();
+    const auto stand_pat = evaluate(position);
+    if (stand_pat >= beta || ply == MAX_SEARCH_PLY)
+    {
+        return stand_pat;
+    }
+    alpha = std::max(alpha, stand_pat);
+
+    auto& moves = m_moves[ply];
+    position.generate_legal_moves(moves);
+    moves.erase(std::remove_if(moves.begin(), moves.end(),
+                               [this](const Move& move) { return !is_capture(move); }),
+                moves.end());
+    order_moves(moves, ply);
+    for (const auto& move : moves)
+    {
+        if (should_stop())
+        {
+            return 0;
+        }
+        ++m_nodes;
+        m_game.make_move(move);
+        const auto score = -quiescence(ply + 1, -beta, -alpha);
+        m_game.unmake_move();
+        if (m_aborted)
+        {
+            return 0;
+        }
+        if (score > alpha)
+        {
+            alpha = score;
+            if (alpha >= beta)
+            {
+                break;
+            }
+        }
+    }
+    return alpha;
+}
+
+void Searcher::order_moves(std::vector<Move>& moves, std::size_t ply) const
+{
+    const auto& board = m_game.get_position().get_board();
+    const auto get_order_key = [&](const Move& move) {
+        if (ply < m_previous_principal_variation.size()
+            && m_previous_principal_variation[ply] == move)
+        {
+            return INFINITE_SCORE;
+        }
+        const auto victim = board.get_piece_code(move.to);
+        std::int32_t key = victim.is_empty() ? 0 : 10 * (6 - static_cast<std::int32_t>(
+                                                                 victim.get_type()));
+        if (move.type == MoveType::EN_PASSANT)
+        {
+            key = 10;
+        }
+        if (move.promotion == PromotablePieceType::QUEEN)
+        {
+            key += 50;
+        }
+        // cheaper attacker first among captures of the same victim
+        return key + static_cast<std::int32_t>(board.get_piece_code(move.from).get_type());
+    };
+    std::stable_sort(moves.begin(), moves.end(), [&](const Move& lhs, const Move& rhs) {
+        return get_order_key(lhs) > get_order_key(rhs);
+    });
+}
+
+bool Searcher::is_capture(const Move& move) const
+{
+    return move.type == MoveType::EN_PASSANT || move.promotion
+           || !m_game.get_position().get_board().get_piece_code(move.to).is_empty();
+}
+
+bool Searcher::should_stop()
+{
+    if (m_aborted)
+    {
+        return true;
+    }
+    if (m_limits.max_nodes != 0 && m_nodes >= m_limits.max_nodes)
+    {
+        m_aborted = true;
+    }
+    else if (m_nodes % STOP_CHECK_INTERVAL == 0)
+    {
+        m_aborted = m_stop_requested.load(std::memory_order_relaxed)
+                    || std::chrono::steady_clock::now() >= m_deadline;
+    }
+    return m_aborted;
+}
+
+void Searcher::update_principal_variation(std::size_t ply, const Move& move)
+{
+    auto& variation = m_principal_variations[ply];
+    const auto& child_variation = m_principal_variations[ply + 1];
+    variation.clear();
+    variation.push_back(move);
+    variation.insert(variation.end(), child_variation.begin(), child_variation.end());
+}
+}  // namespace
+
+SearchResult search(GameState game,
+                    const SearchLimits& limits,
+                    const std::atomic<bool>& stop_requested,
+                    const SearchProgressCallback& on_depth_completed)
+{
+    Searcher searcher{game, limits, stop_requested};
+    return searcher.run(on_depth_completed);
+}
+
+bool is_mate_score(std::int32_t score)
+{
+    return std::abs(score) >= MATE_SCORE - static_cast<std::int32_t>(MAX_SEARCH_PLY);
+}
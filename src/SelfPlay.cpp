@@ -0,0 +1,160 @@
+#include <BoundedQueue.hpp>
+#include <Match.hpp>
+#include <SelfPlay.hpp>
+#include <TrainingData.hpp>
+#include <algorithm>
+#include <chrono>
+#include <random>
+#include <stdexcept>
+#include <thread>
+#include <unordered_set>
+
+namespace
+{
+/**
+ * @brief writer sleeps instead of spinning on an empty queue so it doesn't take a core from the
+ *  players, the queue holds far more than the samples produced meanwhile
+ */
+constexpr std::chrono::milliseconds WRITER_IDLE_TIME{1};
+
+struct TrainingSample
+{
+    std::uint64_t key{0};
+    TrainingRecord record;
+};
+
+bool is_quiet(const GameState& game, const SearchResult& result)
+{
+    if (!result.best_move || result.best_move->promotion || is_mate_score(result.score))
+    {
+        return false;
+    }
+    const auto& move = *result.best_move;
+    const auto& position = game.get_position();
+    return move.type != MoveType::EN_PASSANT && position.get_board().is_square_empty(move.to)
+           && !position.is_in_check();
+}
+}  // namespace
+
+SelfPlayStatistics run_self_play(const SelfPlayConfig& config,
+                                 const std::atomic<bool>& stop_requested)
+{
+    SelfPlayStatistics statistics;
+    TrainingDataWriter writer{config.output_prefix, config.max_file_size};
+    BoundedQueue<TrainingSample> queue{config.queue_capacity};
+    std::atomic<std::size_t> next_game_index{0};
+    std::atomic<std::size_t> running_player_count{std::max<std::size_t>(1, config.thread_count)};
+    std::atomic<std::uint64_t> game_count{0};
+    std::atomic<std::uint64_t> sampled_count{0};
+    // set by the writer thread on stop request or write error, players only look at this flag
+    std::atomic<bool> stop_players{false};
+
+    const auto play_games = [&](std::size_t thread_index) {
+        std::mt19937 random{config.seed + static_cast<std::uint32_t>(thread_index)};
+        std::vector<TrainingSample> samples;
+        while (!stop_players)
+        {
+            if (config.game_count != 0 && next_game_index++ >= config.game_count)
+            {
+                break;
+            }
+            auto game = GameState::get_starting_position();
+            // a game ending during its random plies is not played, it doesn't use up an index
+            while (!play_random_plies(game, config.random_plies, random))
+            {
+                game = GameState::get_starting_position();
+            }
+            samples.clear();
+            const auto played = play_game(
+                game, config.limits, config.limits, config.max_plies, stop_players,
+                [&](const GameState& searched_game, const SearchResult& result) {
+                    if (searched_game.get_ply_count() < config.min_sample_ply
+                        || !is_quiet(searched_game, result))
+                    {
+                        return;
+                    }
+                    auto record = encode_training_record(
+                        searched_game.get_position(), static_cast<std::int16_t>(result.score),
+                        GameResult::DRAW, searched_game.get_halfmove_clock(),
+                        static_cast<std::uint32_t>(searched_game.get_ply_count()));
+                    samples.push_back({searched_game.get_key(), record});
+                });
+            if (played.result == GameResult::UNKNOWN)
+            {
+                break;
+            }
+            ++game_count;
+            for (auto& sample : samples)
+            {
+                sample.record.result = to_record_result(played.result);
+                bool is_pushed = false;
+                while (!(is_pushed = queue.try_push(sample)) && !stop_players)
+                {
+                    std::this_thread::yield();
+                }
+                // samples dropped on stop are not counted, written + duplicates == sampled
+                if (!is_pushed)
+                {
+                    break;
+                }
+                ++sampled_count;
+            }
+        }
+        --running_player_count;
+    };
+
+    std::vector<std::thread> players;
+    for (std::size_t thread_index = 0; thread_index != running_player_count; ++thread_index)
+    {
+        players.emplace_back(play_games, thread_index);
+    }
+
+    const auto join_players = [&players] {
+        for (auto& player : players)
+        {
+            player.join();
+        }
+    };
+
+    // the writer owns the key set, deduplication needs no synchronization
+    std::unordered_set<std::uint64_t> written_keys;
+    TrainingSample sample;
+    try
+    {
+        while (true)
+        {
+            stop_players = stop_players || stop_requested;
+            const auto is_last_pass = running_player_count == 0;
+            while (queue.try_pop(sample))
+            {
+                if (written_keys.insert(sample.key).second)
+                {
+                    writer.write(sample.record);
+                }
+                else
+                {
+                    ++statistics.duplicate_positions;
+                }
+            }
+            if (is_last_pass)
+            {
+                break;
+            }
+            std::this_thread::sleep_for(WRITER_IDLE_TIME);
+        }
+    }
+    catch (const std::runtime_error&)
+    {
+        stop_players = true;
+        join_players();
+        throw;
+    }
+    join_players();
+    writer.flush();
+
+    statistics.games = game_count;
+    statistics.sampled_positions = sampled_count;
+    statistics.written_positions = writer.get_record_count();
+    statistics.file_count = writer.get_file_count();
+    return statistics;
+}
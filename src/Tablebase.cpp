@@ -0,0 +1,564 @@
+#include <Tablebase.hpp>
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <limits>
+#include <stdexcept>
+
+namespace
+{
+constexpr std::string_view FILE_MAGIC = "CHESSTB2";
+constexpr std::size_t MATERIAL_NAME_SIZE = 8;
+constexpr std::size_t HEADER_SIZE = FILE_MAGIC.size() + MATERIAL_NAME_SIZE;
+constexpr std::string_view FILE_EXTENSION = ".tb";
+constexpr std::size_t NO_INDEX = std::numeric_limits<std::size_t>::max();
+constexpr std::int32_t PAWNLESS_SYMMETRY_COUNT = 8;
+constexpr std::int32_t PAWN_SYMMETRY_COUNT = 2;
+
+/**
+ * @brief king square pairs stored in tables, index of pair is -1 if it isn't stored
+ */
+struct KingPairs
+{
+    std::array<std::int16_t, 64 * 64> indices;
+    std::vector<std::array<std::int32_t, 2>> squares;
+};
+
+KingPairs make_king_pairs(bool has_pawns)
+{
+    KingPairs king_pairs;
+    king_pairs.indices.fill(-1);
+    for (std::int32_t white_king = 0; white_king != 64; ++white_king)
+    {
+        const auto white_x = white_king & 7;
+        const auto white_y = white_king >> 3;
+        if (white_x >= 4 || (!has_pawns && white_y > white_x))
+        {
+            continue;
+        }
+        for (std::int32_t black_king = 0; black_king != 64; ++black_king)
+        {
+            const auto black_x = black_king & 7;
+            const auto black_y = black_king >> 3;
+            const auto is_adjacent
+                = std::max(std::abs(black_x - white_x), std::abs(black_y - white_y)) <= 1;
+            if (is_adjacent || (!has_pawns && white_x == white_y && black_y > black_x))
+            {
+                continue;
+            }
+            king_pairs.indices[64 * white_king + black_king]
+                = static_cast<std::int16_t>(king_pairs.squares.size());
+            king_pairs.squares.push_back({white_king, black_king});
+        }
+    }
+    return king_pairs;
+}
+
+const KingPairs& get_king_pairs(bool has_pawns)
+{
+    static const auto pawnless_king_pairs = make_king_pairs(false);
+    static const auto pawn_king_pairs = make_king_pairs(true);
+    return has_pawns ? pawn_king_pairs : pawnless_king_pairs;
+}
+
+/**
+ * @brief symmetry bit 0 mirrors files, bit 1 mirrors ranks and bit 2 the a1-h8 diagonal
+ */
+std::int32_t transform_square(std::int32_t square, std::int32_t symmetry)
+{
+    auto x = square & 7;
+    auto y = square >> 3;
+    if (symmetry & 4)
+    {
+        std::swap(x, y);
+    }
+    if (symmetry & 1)
+    {
+        x = 7 - x;
+    }
+    if (symmetry & 2)
+    {
+        y = 7 - y;
+    }
+    return 8 * y + x;
+}
+
+bool has_pawns(const TablebasePosition& position, PieceColor color)
+{
+    for (std::size_t i = 0; i != position.piece_count; ++i)
+    {
+        if (position.pieces[i].type == PieceType::PAWN && position.pieces[i].color == color)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool has_pawns(const TablebasePosition& position)
+{
+    return has_pawns(position, PieceColor::WHITE) || has_pawns(position, PieceColor::BLACK);
+}
+
+std::int32_t get_en_passant_square(const TablebasePosition& position)
+{
+    return 8 * (position.side_to_move == PieceColor::WHITE ? 4 : 3) + position.en_passant_file;
+}
+
+std::size_t get_piece_section_size(const TablebasePosition& material)
+{
+    return 2 * get_king_pairs(has_pawns(material)).squares.size()
+           << (6 * (material.piece_count - 2));
+}
+
+/**
+ * @brief en passant section stores the file instead of the square of the pawn taken, which
+ *  is the only pawn of its color in tables of at most four pieces
+ */
+std::size_t get_en_passant_section_size(const TablebasePosition& material)
+{
+    if (!has_pawns(material, PieceColor::WHITE) || !has_pawns(material, PieceColor::BLACK))
+    {
+        return 0;
+    }
+    return 2 * get_king_pairs(true).squares.size() * 8 << (6 * (material.piece_count - 3));
+}
+
+std::size_t get_symmetric_index(const TablebasePosition& position,
+                                const KingPairs& king_pairs,
+                                std::int32_t symmetry)
+{
+    const auto king_pair
+        = king_pairs.indices[64 * transform_square(position.pieces[0].square, symmetry)
+                             + transform_square(position.pieces[1].square, symmetry)];
+    if (king_pair < 0)
+    {
+        return NO_INDEX;
+    }
+    auto index = to_index(position.side_to_move) * king_pairs.squares.size()
+                 + static_cast<std::size_t>(king_pair);
+    const auto en_passant_square
+        = position.en_passant_file < 0 ? -1 : get_en_passant_square(position);
+    if (en_passant_square >= 0)
+    {
+        const auto en_passant_file = transform_square(en_passant_square, symmetry) & 7;
+        index = index * 8 + static_cast<std::size_t>(en_passant_file);
+    }
+    for (std::size_t i = 2; i != position.piece_count; ++i)
+    {
+        if (position.pieces[i].square != en_passant_square)
+        {
+            const auto square = transform_square(position.pieces[i].square, symmetry);
+            index = (index << 6) | static_cast<std::size_t>(square);
+        }
+    }
+    return en_passant_square < 0 ? index : get_piece_section_size(position) + index;
+}
+
+/**
+ * @brief order of non king pieces in material names
+ */
+std::int32_t get_piece_order(PieceType piece_type)
+{
+    switch (piece_type)
+    {
+    case PieceType::QUEEN:
+        return 0;
+    case PieceType::ROOK:
+        return 1;
+    case PieceType::BISHOP:
+        return 2;
+    case PieceType::KNIGHT:
+        return 3;
+    case PieceType::PAWN:
+        return 4;
+    default:
+        return -1;
+    }
+}
+
+std::int32_t get_material_value(PieceType piece_type)
+{
+    switch (piece_type)
+    {
+    case PieceType::QUEEN:
+        return 9;
+    case PieceType::ROOK:
+        return 5;
+    case PieceType::BISHOP:
+    case PieceType::KNIGHT:
+        return 3;
+    case PieceType::PAWN:
+        return 1;
+    default:
+        return 0;
+    }
+}
+
+std::int32_t get_sort_group(const TablebasePiece& piece)
+{
+    const auto color_offset = piece.color == PieceColor::WHITE ? 0 : 1;
+    return piece.type == PieceType::KING ? color_offset : 2 + color_offset;
+}
+
+std::string get_color_material(const TablebasePosition& position, PieceColor color)
+{
+    std::string material;
+    for (std::size_t i = 0; i != position.piece_count; ++i)
+    {
+        if (position.pieces[i].color == color)
+        {
+            material.push_back(to_char(position.pieces[i].type));
+        }
+    }
+    return material;
+}
+
+bool is_canonical(const TablebasePosition& position)
+{
+    std::array<std::int32_t, 2> values{0, 0};
+    std::array<std::array<std::int32_t, MAX_TABLEBASE_PIECE_COUNT>, 2> orders{};
+    std::array<std::size_t, 2> counts{0, 0};
+    for (std::size_t i = 0; i != position.piece_count; ++i)
+    {
+        const auto& piece = position.pieces[i];
+        const auto color_index = to_index(piece.color);
+        values[color_index] += get_material_value(piece.type);
+        orders[color_index][counts[color_index]++] = get_piece_order(piece.type);
+    }
+    if (values[0] != values[1])
+    {
+        return values[0] > values[1];
+    }
+    // same value: side with the more valuable pieces first is white, KBKN rather than KNKB
+    return !std::lexicographical_compare(orders[1].begin(), orders[1].begin() + counts[1],
+                                         orders[0].begin(), orders[0].begin() + counts[0]);
+}
+}  // namespace
+
+const char* to_c_str(TablebaseResult result)
+{
+    switch (result)
+    {
+    case TablebaseResult::WIN:
+        return "win";
+    case TablebaseResult::DRAW:
+        return "draw";
+    case TablebaseResult::LOSS:
+        return "loss";
+    default:
+        return "error";
+    };
+}
+
+std::uint8_t encode_tablebase_probe(const TablebaseProbe& probe)
+{
+    switch (probe.result)
+    {
+    case TablebaseResult::WIN:
+        return probe.plies_to_mate;
+    case TablebaseResult::LOSS:
+        return static_cast<std::uint8_t>(TABLEBASE_LOSS_OFFSET + probe.plies_to_mate);
+    default:
+        return TABLEBASE_DRAW;
+    }
+}
+
+std::optional<TablebaseProbe> decode_tablebase_value(std::uint8_t value)
+{
+    if (value == TABLEBASE_DRAW)
+    {
+        return TablebaseProbe{TablebaseResult::DRAW, 0};
+    }
+    if (value < TABLEBASE_LOSS_OFFSET)
+    {
+        return TablebaseProbe{TablebaseResult::WIN, value};
+    }
+    if (value - TABLEBASE_LOSS_OFFSET <= TABLEBASE_MAX_LOSS_PLIES)
+    {
+        return TablebaseProbe{TablebaseResult::LOSS,
+                              static_cast<std::uint8_t>(value - TABLEBASE_LOSS_OFFSET)};
+    }
+    return std::nullopt;
+}
+
+std::optional<TablebasePosition> parse_material_name(std::string_view material_name)
+{
+    const auto black_king = material_name.find('K', 1);
+    if (material_name.empty() || material_name.front() != 'K'
+        || black_king == std::string_view::npos
+        || material_name.size() > MAX_TABLEBASE_PIECE_COUNT)
+    {
+        return std::nullopt;
+    }
+    TablebasePosition position;
+    position.pieces[0] = {PieceType::KING, PieceColor::WHITE, 0};
+    position.pieces[1] = {PieceType::KING, PieceColor::BLACK, 0};
+    position.piece_count = 2;
+    for (std::size_t i = 1; i != material_name.size(); ++i)
+    {
+        if (i == black_king)
+        {
+            continue;
+        }
+        const auto piece_type = piece_type_from_char(material_name[i]);
+        if (!piece_type || *piece_type == PieceType::KING)
+        {
+            return std::nullopt;
+        }
+        const auto color = i < black_king ? PieceColor::WHITE : PieceColor::BLACK;
+        position.pieces[position.piece_count++] = {*piece_type, color, 0};
+    }
+    return position;
+}
+
+std::string get_material_name(const TablebasePosition& position)
+{
+    return "K" + get_color_material(position, PieceColor::WHITE).substr(1) + "K"
+           + get_color_material(position, PieceColor::BLACK).substr(1);
+}
+
+void sort_tablebase_pieces(TablebasePosition& position)
+{
+    std::stable_sort(position.pieces.begin(), position.pieces.begin() + position.piece_count,
+                     [](const TablebasePiece& lhs, const TablebasePiece& rhs)
+                     {
+                         const auto lhs_group = get_sort_group(lhs);
+                         const auto rhs_group = get_sort_group(rhs);
+                         if (lhs_group != rhs_group)
+                         {
+                             return lhs_group < rhs_group;
+                         }
+                         return get_piece_order(lhs.type) < get_piece_order(rhs.type);
+                     });
+}
+
+TablebasePosition flip_colors(const TablebasePosition& position)
+{
+    auto flipped = position;
+    for (std::size_t i = 0; i != flipped.piece_count; ++i)
+    {
+        auto& piece = flipped.pieces[i];
+        piece.color = get_opposite_color(piece.color);
+        piece.square ^= 56;
+    }
+    flipped.side_to_move = get_opposite_color(position.side_to_move);
+    return flipped;
+}
+
+TablebasePosition canonicalize(TablebasePosition position)
+{
+    sort_tablebase_pieces(position);
+    if (!is_canonical(position))
+    {
+        position = flip_colors(position);
+        sort_tablebase_pieces(position);
+    }
+    return position;
+}
+
+std::optional<TablebasePosition> get_tablebase_position(const PositionState& position)
+{
+    for (const auto color : {PieceColor::WHITE, PieceColor::BLACK})
+    {
+        const auto& castling_rights = position.get_castling_rights(color);
+        if (castling_rights.king_side_rook || castling_rights.queen_side_rook)
+        {
+            return std::nullopt;
+        }
+    }
+    TablebasePosition tablebase_position;
+    tablebase_position.side_to_move = position.get_side_to_move();
+    const auto& board = position.get_board();
+    for (std::int32_t y = 0; y != 8; ++y)
+    {
+        for (std::int32_t x = 0; x != 8; ++x)
+        {
+            if (board.is_square_empty({x, y}))
+            {
+                continue;
+            }
+            if (tablebase_position.piece_count == MAX_TABLEBASE_PIECE_COUNT)
+            {
+                return std::nullopt;
+            }
+            const auto& piece = board.get_piece_at_position({x, y});
+            tablebase_position.pieces[tablebase_position.piece_count++]
+                = {piece.get_type(), piece.get_color(), 8 * y + x};
+        }
+    }
+    sort_tablebase_pieces(tablebase_position);
+
+    // the en passant right only matters when a pawn of side to move stands next to the pawn
+    const auto& en_passant_takable = position.get_en_passant_takable();
+    if (en_passant_takable)
+    {
+        const auto pawn_y = en_passant_takable->y
+                            + (tablebase_position.side_to_move == PieceColor::WHITE ? -1 : 1);
+        for (const auto capture_x : {en_passant_takable->x - 1, en_passant_takable->x + 1})
+        {
+            if (capture_x < 0 || capture_x >= 8 || board.is_square_empty({capture_x, pawn_y}))
+            {
+                continue;
+            }
+            const auto& piece = board.get_piece_at_position({capture_x, pawn_y});
+            if (piece.get_type() == PieceType::PAWN
+                && piece.get_color() == tablebase_position.side_to_move)
+            {
+                tablebase_position.en_passant_file = en_passant_takable->x;
+            }
+        }
+    }
+    return tablebase_position;
+}
+
+std::size_t get_tablebase_size(const TablebasePosition& material)
+{
+    return get_piece_section_size(material) + get_en_passant_section_size(material);
+}
+
+std::size_t get_tablebase_index(const TablebasePosition& position)
+{
+    const auto is_pawn_table = has_pawns(position);
+    const auto& king_pairs = get_king_pairs(is_pawn_table);
+    auto index = NO_INDEX;
+    for (std::int32_t symmetry = 0;
+         symmetry != (is_pawn_table ? PAWN_SYMMETRY_COUNT : PAWNLESS_SYMMETRY_COUNT); ++symmetry)
+    {
+        index = std::min(index, get_symmetric_index(position, king_pairs, symmetry));
+    }
+    return index;
+}
+
+void set_tablebase_index(TablebasePosition& position, std::size_t index)
+{
+    const auto& king_pairs = get_king_pairs(has_pawns(position));
+    const auto piece_section_size = get_piece_section_size(position);
+    const auto is_en_passant = index >= piece_section_size;
+    const auto section_size
+        = is_en_passant ? get_en_passant_section_size(position) : piece_section_size;
+    if (is_en_passant)
+    {
+        index -= piece_section_size;
+    }
+    position.side_to_move = static_cast<PieceColor>(index / (section_size / 2));
+    index %= section_size / 2;
+
+    auto en_passant_pawn = position.piece_count;
+    for (std::size_t i = 2; is_en_passant && i != position.piece_count; ++i)
+    {
+        if (position.pieces[i].type == PieceType::PAWN
+            && position.pieces[i].color != position.side_to_move)
+        {
+            en_passant_pawn = i;
+            break;
+        }
+    }
+    for (std::size_t i = position.piece_count; i-- != 2;)
+    {
+        if (i != en_passant_pawn)
+        {
+            position.pieces[i].square = static_cast<std::int32_t>(index & 63);
+            index >>= 6;
+        }
+    }
+    position.en_passant_file = -1;
+    if (is_en_passant)
+    {
+        position.en_passant_file = static_cast<std::int32_t>(index % 8);
+        position.pieces[en_passant_pawn].square = get_en_passant_square(position);
+        index /= 8;
+    }
+    const auto& king_squares = king_pairs.squares[index];
+    position.pieces[0].square = king_squares[0];
+    position.pieces[1].square = king_squares[1];
+}
+
+void write_tablebase_file(const std::string& path,
+                          std::string_view material_name,
+                          const std::vector<std::uint8_t>& values)
+{
+    std::ofstream file{path, std::ios::binary};
+    std::array<char, MATERIAL_NAME_SIZE> name{};
+    std::copy(material_name.begin(), material_name.end(), name.begin());
+    file.write(FILE_MAGIC.data(), FILE_MAGIC.size());
+    file.write(name.data(), name.size());
+    file.write(reinterpret_cast<const char*>(values.data()),
+               static_cast<std::streamsize>(values.size()));
+    if (!file)
+    {
+        throw std::runtime_error("can't write tablebase " + path);
+    }
+}
+
+Tablebase::Tablebase(const std::string& path)
+    : m_file{path}
+{
+    const auto view = m_file.get_view();
+    if (view.size() < HEADER_SIZE || view.substr(0, FILE_MAGIC.size()) != FILE_MAGIC)
+    {
+        throw std::runtime_error(path + " is not a tablebase");
+    }
+    const auto name = view.substr(FILE_MAGIC.size(), MATERIAL_NAME_SIZE);
+    m_material_name = std::string{name.substr(0, name.find('\0'))};
+    const auto material = parse_material_name(m_material_name);
+    if (!material || view.size() != HEADER_SIZE + get_tablebase_size(*material))
+    {
+        throw std::runtime_error(path + " has wrong size for its material");
+    }
+}
+
+const std::string& Tablebase::get_material_name() const
+{
+    return m_material_name;
+}
+
+std::uint8_t Tablebase::get_value(std::size_t index) const
+{
+    return std::to_integer<std::uint8_t>(m_file.get_data()[HEADER_SIZE + index]);
+}
+
+void TablebaseSet::load_directory(const std::string& path)
+{
+    for (const auto& entry : std::filesystem::directory_iterator{path})
+    {
+        if (entry.path().extension() != FILE_EXTENSION)
+        {
+            continue;
+        }
+        Tablebase tablebase{entry.path().string()};
+        const auto material_name = tablebase.get_material_name();
+        m_tablebases.insert_or_assign(material_name, std::move(tablebase));
+    }
+}
+
+std::size_t TablebaseSet::get_table_count() const
+{
+    return m_tablebases.size();
+}
+
+std::optional<TablebaseProbe> TablebaseSet::probe(const PositionState& position) const
+{
+    const auto tablebase_position = get_tablebase_position(position);
+    if (!tablebase_position)
+    {
+        return std::nullopt;
+    }
+    return probe(*tablebase_position);
+}
+
+std::optional<TablebaseProbe> TablebaseSet::probe(const TablebasePosition& position) const
+{
+    if (position.piece_count == 2)
+    {
+        return TablebaseProbe{TablebaseResult::DRAW, 0};
+    }
+    const auto canonical_position = canonicalize(position);
+    const auto tablebase = m_tablebases.find(get_material_name(canonical_position));
+    if (tablebase == m_tablebases.end())
+    {
+        return std::nullopt;
+    }
+    return decode_tablebase_value(
+        tablebase->second.get_value(get_tablebase_index(canonical_position)));
+}
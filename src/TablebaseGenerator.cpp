@@ -0,0 +1,781 @@
+#include <TablebaseGenerator.hpp>
+#include <algorithm>
+#include <atomic>
+#include <filesystem>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+
+namespace
+{
+/**
+ * @brief value of positions not solved yet, the ones left when solving ends are draws
+ */
+constexpr std::uint8_t UNKNOWN = 254;
+constexpr std::size_t NO_PIECE = MAX_TABLEBASE_PIECE_COUNT;
+
+struct Direction
+{
+    std::int32_t x;
+    std::int32_t y;
+};
+constexpr std::array<Direction, 4> ROOK_DIRECTIONS = {{{1, 0}, {-1, 0}, {0, 1}, {0, -1}}};
+constexpr std::array<Direction, 4> BISHOP_DIRECTIONS = {{{1, 1}, {1, -1}, {-1, 1}, {-1, -1}}};
+constexpr std::array<Direction, 8> KING_DIRECTIONS
+    = {{{1, 0}, {-1, 0}, {0, 1}, {0, -1}, {1, 1}, {1, -1}, {-1, 1}, {-1, -1}}};
+constexpr std::array<Direction, 8> KNIGHT_JUMPS
+    = {{{1, 2}, {2, 1}, {2, -1}, {1, -2}, {-1, -2}, {-2, -1}, {-2, 1}, {-1, 2}}};
+constexpr std::array<PieceType, 4> PROMOTION_TYPES
+    = {PieceType::QUEEN, PieceType::ROOK, PieceType::BISHOP, PieceType::KNIGHT};
+
+std::int32_t get_x(std::int32_t square)
+{
+    return square & 7;
+}
+
+std::int32_t get_y(std::int32_t square)
+{
+    return square >> 3;
+}
+
+std::int32_t to_square(std::int32_t x, std::int32_t y)
+{
+    return 8 * y + x;
+}
+
+bool is_on_board(std::int32_t x, std::int32_t y)
+{
+    return x >= 0 && x < 8 && y >= 0 && y < 8;
+}
+
+std::int32_t get_sign(std::int32_t value)
+{
+    return (value > 0) - (value < 0);
+}
+
+std::uint64_t get_occupancy(const TablebasePosition& position)
+{
+    std::uint64_t occupancy = 0;
+    for (std::size_t i = 0; i != position.piece_count; ++i)
+    {
+        occupancy |= std::uint64_t{1} << position.pieces[i].square;
+    }
+    return occupancy;
+}
+
+std::size_t find_piece(const TablebasePosition& position, std::int32_t square)
+{
+    for (std::size_t i = 0; i != position.piece_count; ++i)
+    {
+        if (position.pieces[i].square == square)
+        {
+            return i;
+        }
+    }
+    return NO_PIECE;
+}
+
+bool is_path_clear(std::int32_t from, std::int32_t to, std::uint64_t occupancy)
+{
+    const auto step_x = get_sign(get_x(to) - get_x(from));
+    const auto step_y = get_sign(get_y(to) - get_y(from));
+    for (auto x = get_x(from) + step_x, y = get_y(from) + step_y; to_square(x, y) != to;
+         x += step_x, y += step_y)
+    {
+        if (occupancy & (std::uint64_t{1} << to_square(x, y)))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool attacks(const TablebasePiece& piece, std::int32_t square, std::uint64_t occupancy)
+{
+    const auto dx = get_x(square) - get_x(piece.square);
+    const auto dy = get_y(square) - get_y(piece.square);
+    const auto distance_x = std::abs(dx);
+    const auto distance_y = std::abs(dy);
+    const auto is_straight = (dx == 0) != (dy == 0);
+    const auto is_diagonal = distance_x == distance_y && dx != 0;
+    switch (piece.type)
+    {
+    case PieceType::KING:
+        return std::max(distance_x, distance_y) == 1;
+    case PieceType::KNIGHT:
+        return distance_x * distance_y == 2;
+    case PieceType::PAWN:
+        return distance_x == 1 && dy == (piece.color == PieceColor::WHITE ? 1 : -1);
+    case PieceType::ROOK:
+        return is_straight && is_path_clear(piece.square, square, occupancy);
+    case PieceType::BISHOP:
+        return is_diagonal && is_path_clear(piece.square, square, occupancy);
+    case PieceType::QUEEN:
+        return (is_straight || is_diagonal) && is_path_clear(piece.square, square, occupancy);
+    default:
+        return false;
+    }
+}
+
+bool is_king_attacked(const TablebasePosition& position, PieceColor king_color)
+{
+    const auto occupancy = get_occupancy(position);
+    std::int32_t king_square = 0;
+    for (std::size_t i = 0; i != position.piece_count; ++i)
+    {
+        const auto& piece = position.pieces[i];
+        if (piece.type == PieceType::KING && piece.color == king_color)
+        {
+            king_square = piece.square;
+        }
+    }
+    for (std::size_t i = 0; i != position.piece_count; ++i)
+    {
+        const auto& piece = position.pieces[i];
+        if (piece.color != king_color && attacks(piece, king_square, occupancy))
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+void remove_piece(TablebasePosition& position, std::size_t piece_index)
+{
+    std::copy(position.pieces.begin() + piece_index + 1,
+              position.pieces.begin() + position.piece_count,
+              position.pieces.begin() + piece_index);
+    --position.piece_count;
+}
+
+bool has_pawn_beside(const TablebasePosition& position, std::int32_t square, PieceColor color)
+{
+    for (const auto x : {get_x(square) - 1, get_x(square) + 1})
+    {
+        if (!is_on_board(x, get_y(square)))
+        {
+            continue;
+        }
+        const auto piece_index = find_piece(position, to_square(x, get_y(square)));
+        if (piece_index != NO_PIECE && position.pieces[piece_index].type == PieceType::PAWN
+            && position.pieces[piece_index].color == color)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief square of the pawn that can be taken en passant
+ */
+std::int32_t get_en_passant_square(const TablebasePosition& position)
+{
+    return to_square(position.en_passant_file,
+                     position.side_to_move == PieceColor::WHITE ? 4 : 3);
+}
+
+bool is_en_passant_valid(const TablebasePosition& position, std::uint64_t occupancy)
+{
+    const auto square = get_en_passant_square(position);
+    const auto pawn_index = find_piece(position, square);
+    if (pawn_index == NO_PIECE || position.pieces[pawn_index].type != PieceType::PAWN
+        || position.pieces[pawn_index].color == position.side_to_move)
+    {
+        return false;
+    }
+    // the pawn came from its start square through the square behind it
+    const auto backward = position.side_to_move == PieceColor::WHITE ? 8 : -8;
+    const auto passed_squares = (std::uint64_t{1} << (square + backward))
+                                | (std::uint64_t{1} << (square + 2 * backward));
+    return (occupancy & passed_squares) == 0
+           && has_pawn_beside(position, square, position.side_to_move);
+}
+
+void add_child(const TablebasePosition& position,
+               std::size_t piece_index,
+               std::int32_t to,
+               std::optional<PieceType> promotion,
+               std::vector<TablebasePosition>& children)
+{
+    auto child = position;
+    const auto captured_index = find_piece(position, to);
+    child.pieces[piece_index].square = to;
+    if (promotion)
+    {
+        child.pieces[piece_index].type = *promotion;
+    }
+    if (captured_index != NO_PIECE)
+    {
+        remove_piece(child, captured_index);
+    }
+    child.side_to_move = get_opposite_color(position.side_to_move);
+    child.en_passant_file = -1;
+    if (!is_king_attacked(child, position.side_to_move))
+    {
+        children.push_back(child);
+    }
+}
+
+void add_pawn_moves(const TablebasePosition& position,
+                    std::size_t piece_index,
+                    std::vector<TablebasePosition>& children)
+{
+    const auto& pawn = position.pieces[piece_index];
+    const auto is_white = pawn.color == PieceColor::WHITE;
+    const auto forward = is_white ? 1 : -1;
+    const auto x = get_x(pawn.square);
+    const auto y = get_y(pawn.square) + forward;
+    const auto add_pawn_child = [&position, &children, piece_index, y, is_white](std::int32_t to)
+    {
+        if (y == (is_white ? 7 : 0))
+        {
+            for (const auto promotion : PROMOTION_TYPES)
+            {
+                add_child(position, piece_index, to, promotion, children);
+            }
+            return;
+        }
+        add_child(position, piece_index, to, std::nullopt, children);
+    };
+
+    if (find_piece(position, to_square(x, y)) == NO_PIECE)
+    {
+        add_pawn_child(to_square(x, y));
+        const auto double_push = to_square(x, y + forward);
+        if (get_y(pawn.square) == (is_white ? 1 : 6)
+            && find_piece(position, double_push) == NO_PIECE)
+        {
+            const auto child_count = children.size();
+            add_child(position, piece_index, double_push, std::nullopt, children);
+            if (children.size() != child_count
+                && has_pawn_beside(position, double_push, get_opposite_color(pawn.color)))
+            {
+                children.back().en_passant_file = x;
+            }
+        }
+    }
+    if (position.en_passant_file >= 0 && std::abs(position.en_passant_file - x) == 1
+        && get_y(pawn.square) == (is_white ? 4 : 3))
+    {
+        auto captured = position;
+        const auto captured_index = find_piece(position, get_en_passant_square(position));
+        remove_piece(captured, captured_index);
+        add_child(captured, captured_index < piece_index ? piece_index - 1 : piece_index,
+                  to_square(position.en_passant_file, y), std::nullopt, children);
+    }
+    for (const auto capture_x : {x - 1, x + 1})
+    {
+        if (!is_on_board(capture_x, y))
+        {
+            continue;
+        }
+        const auto captured_index = find_piece(position, to_square(capture_x, y));
+        if (captured_index != NO_PIECE && position.pieces[captured_index].color != pawn.color
+            && position.pieces[captured_index].type != PieceType::KING)
+        {
+            add_pawn_child(to_square(capture_x, y));
+        }
+    }
+}
+
+/**
+ * @brief calls add_square for squares reached by piece until it returns false
+ */
+template <typename AddSquare>
+void for_each_piece_square(const TablebasePiece& piece, const AddSquare& add_square)
+{
+    const auto slide = [&piece, &add_square](const auto& directions)
+    {
+        for (const auto& direction : directions)
+        {
+            auto x = get_x(piece.square) + direction.x;
+            auto y = get_y(piece.square) + direction.y;
+            while (is_on_board(x, y) && add_square(to_square(x, y)))
+            {
+                x += direction.x;
+                y += direction.y;
+            }
+        }
+    };
+    const auto step = [&piece, &add_square](const auto& directions)
+    {
+        for (const auto& direction : directions)
+        {
+            const auto x = get_x(piece.square) + direction.x;
+            const auto y = get_y(piece.square) + direction.y;
+            if (is_on_board(x, y))
+            {
+                add_square(to_square(x, y));
+            }
+        }
+    };
+    switch (piece.type)
+    {
+    case PieceType::KING:
+        step(KING_DIRECTIONS);
+        break;
+    case PieceType::KNIGHT:
+        step(KNIGHT_JUMPS);
+        break;
+    case PieceType::QUEEN:
+        slide(ROOK_DIRECTIONS);
+        slide(BISHOP_DIRECTIONS);
+        break;
+    case PieceType::ROOK:
+        slide(ROOK_DIRECTIONS);
+        break;
+    case PieceType::BISHOP:
+        slide(BISHOP_DIRECTIONS);
+        break;
+    default:
+        break;
+    }
+}
+
+bool is_same_material(const TablebasePosition& lhs, const TablebasePosition& rhs)
+{
+    if (lhs.piece_count != rhs.piece_count)
+    {
+        return false;
+    }
+    for (std::size_t i = 0; i != lhs.piece_count; ++i)
+    {
+        if (lhs.pieces[i].type != rhs.pieces[i].type)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief adds parent if it is valid, with every en passant right it might have had as well
+ */
+void add_parent(TablebasePosition parent, std::vector<TablebasePosition>& parents)
+{
+    if (!is_tablebase_position_valid(parent))
+    {
+        return;
+    }
+    parents.push_back(parent);
+    const auto pawn_y = parent.side_to_move == PieceColor::WHITE ? 4 : 3;
+    for (std::size_t i = 0; i != parent.piece_count; ++i)
+    {
+        const auto& piece = parent.pieces[i];
+        if (piece.type != PieceType::PAWN || piece.color == parent.side_to_move
+            || get_y(piece.square) != pawn_y)
+        {
+            continue;
+        }
+        auto en_passant_parent = parent;
+        en_passant_parent.en_passant_file = get_x(piece.square);
+        if (is_tablebase_position_valid(en_passant_parent))
+        {
+            parents.push_back(en_passant_parent);
+        }
+    }
+}
+
+/**
+ * @brief sorted indices without duplicates, symmetric positions share their index
+ */
+void get_unique_indices(const std::vector<TablebasePosition>& positions,
+                        std::vector<std::size_t>& indices)
+{
+    indices.clear();
+    for (const auto& position : positions)
+    {
+        indices.push_back(get_tablebase_index(position));
+    }
+    std::sort(indices.begin(), indices.end());
+    indices.erase(std::unique(indices.begin(), indices.end()), indices.end());
+}
+
+std::uint8_t encode_win(std::uint32_t plies)
+{
+    return encode_tablebase_probe({TablebaseResult::WIN, static_cast<std::uint8_t>(plies)});
+}
+
+std::uint8_t encode_loss(std::uint32_t plies)
+{
+    return encode_tablebase_probe({TablebaseResult::LOSS, static_cast<std::uint8_t>(plies)});
+}
+}  // namespace
+
+bool is_tablebase_position_valid(const TablebasePosition& position)
+{
+    const auto occupancy = get_occupancy(position);
+    if (static_cast<std::size_t>(__builtin_popcountll(occupancy)) != position.piece_count)
+    {
+        return false;
+    }
+    for (std::size_t i = 0; i != position.piece_count; ++i)
+    {
+        const auto& piece = position.pieces[i];
+        if (piece.type == PieceType::PAWN && (get_y(piece.square) == 0 || get_y(piece.square) == 7))
+        {
+            return false;
+        }
+    }
+    if (position.en_passant_file >= 0 && !is_en_passant_valid(position, occupancy))
+    {
+        return false;
+    }
+    return !is_king_attacked(position, get_opposite_color(position.side_to_move));
+}
+
+bool is_tablebase_side_to_move_in_check(const TablebasePosition& position)
+{
+    return is_king_attacked(position, position.side_to_move);
+}
+
+void generate_tablebase_moves(const TablebasePosition& position,
+                              std::vector<TablebasePosition>& children)
+{
+    children.clear();
+    const auto color = position.side_to_move;
+    for (std::size_t i = 0; i != position.piece_count; ++i)
+    {
+        const auto& piece = position.pieces[i];
+        if (piece.color != color)
+        {
+            continue;
+        }
+        if (piece.type == PieceType::PAWN)
+        {
+            add_pawn_moves(position, i, children);
+            continue;
+        }
+        for_each_piece_square(piece,
+                              [&position, &children, i, color](std::int32_t to)
+                              {
+                                  const auto target = find_piece(position, to);
+                                  if (target == NO_PIECE)
+                                  {
+                                      add_child(position, i, to, std::nullopt, children);
+                                      return true;
+                                  }
+                                  const auto& captured = position.pieces[target];
+                                  if (captured.color != color && captured.type != PieceType::KING)
+                                  {
+                                      add_child(position, i, to, std::nullopt, children);
+                                  }
+                                  return false;
+                              });
+    }
+}
+
+void generate_tablebase_unmoves(const TablebasePosition& position,
+                                std::vector<TablebasePosition>& parents)
+{
+    parents.clear();
+    const auto color = get_opposite_color(position.side_to_move);
+    const auto occupancy = get_occupancy(position);
+    if (position.en_passant_file >= 0)
+    {
+        // only the double push of the pawn that can be taken leads here
+        auto parent = position;
+        const auto square = get_en_passant_square(position);
+        parent.pieces[find_piece(position, square)].square
+            = square + (color == PieceColor::WHITE ? -16 : 16);
+        parent.side_to_move = color;
+        parent.en_passant_file = -1;
+        add_parent(parent, parents);
+        return;
+    }
+    for (std::size_t i = 0; i != position.piece_count; ++i)
+    {
+        const auto& piece = position.pieces[i];
+        if (piece.color != color)
+        {
+            continue;
+        }
+        const auto add_origin = [&position, &parents, occupancy, i, color](std::int32_t from)
+        {
+            if (occupancy & (std::uint64_t{1} << from))
+            {
+                return false;
+            }
+            auto parent = position;
+            parent.pieces[i].square = from;
+            parent.side_to_move = color;
+            add_parent(parent, parents);
+            return true;
+        };
+        if (piece.type != PieceType::PAWN)
+        {
+            for_each_piece_square(piece, add_origin);
+            continue;
+        }
+        const auto is_white = color == PieceColor::WHITE;
+        const auto backward = is_white ? -1 : 1;
+        const auto x = get_x(piece.square);
+        const auto y = get_y(piece.square);
+        if (y + backward == (is_white ? 0 : 7) || !add_origin(to_square(x, y + backward)))
+        {
+            continue;
+        }
+        // with a pawn beside it the double push would have left an en passant right
+        if (y == (is_white ? 3 : 4)
+            && !has_pawn_beside(position, piece.square, position.side_to_move))
+        {
+            add_origin(to_square(x, y + 2 * backward));
+        }
+    }
+}
+
+TablebaseGenerator::TablebaseGenerator(std::size_t thread_count)
+    : m_thread_count{std::max<std::size_t>(thread_count, 1)}
+{
+}
+
+const std::vector<std::uint8_t>& TablebaseGenerator::generate(std::string_view material_name)
+{
+    const auto material = parse_material_name(material_name);
+    if (!material)
+    {
+        throw std::invalid_argument("unknown tablebase material " + std::string{material_name});
+    }
+    const auto canonical_material = canonicalize(*material);
+    const auto canonical_name = get_material_name(canonical_material);
+    if (const auto table = m_tables.find(canonical_name); table != m_tables.end())
+    {
+        return table->second;
+    }
+
+    for (std::size_t i = 2; i != canonical_material.piece_count; ++i)
+    {
+        auto captured = canonical_material;
+        std::copy(captured.pieces.begin() + i + 1, captured.pieces.begin() + captured.piece_count,
+                  captured.pieces.begin() + i);
+        if (--captured.piece_count > 2)
+        {
+            generate(get_material_name(canonicalize(captured)));
+        }
+        if (canonical_material.pieces[i].type != PieceType::PAWN)
+        {
+            continue;
+        }
+        for (const auto promotion : PROMOTION_TYPES)
+        {
+            auto promoted = canonical_material;
+            promoted.pieces[i].type = promotion;
+            generate(get_material_name(canonicalize(promoted)));
+        }
+    }
+    auto values = solve(canonical_material);
+    return m_tables.emplace(canonical_name, std::move(values)).first->second;
+}
+
+void TablebaseGenerator::write(const std::string& directory) const
+{
+    for (const auto& [material_name, values] : m_tables)
+    {
+        const auto path = std::filesystem::path{directory} / (material_name + ".tb");
+        write_tablebase_file(path.string(), material_name, values);
+    }
+}
+
+std::vector<std::string> TablebaseGenerator::get_material_names() const
+{
+    std::vector<std::string> material_names;
+    for (const auto& table : m_tables)
+    {
+        material_names.push_back(table.first);
+    }
+    return material_names;
+}
+
+std::uint8_t TablebaseGenerator::probe(const TablebasePosition& position) const
+{
+    if (position.piece_count == 2)
+    {
+        return TABLEBASE_DRAW;
+    }
+    const auto canonical_position = canonicalize(position);
+    const auto table = m_tables.find(get_material_name(canonical_position));
+    if (table == m_tables.end())
+    {
+        throw std::logic_error("tablebase for " + get_material_name(canonical_position)
+                               + " is not generated");
+    }
+    return table->second[get_tablebase_index(canonical_position)];
+}
+
+std::vector<std::uint8_t> TablebaseGenerator::solve(const TablebasePosition& material) const
+{
+    const auto size = get_tablebase_size(material);
+    const auto values = std::make_unique<std::atomic<std::uint8_t>[]>(size);
+    const auto remaining_moves = std::make_unique<std::atomic<std::uint8_t>[]>(size);
+    // captures and promotions convert to solved tables, their best outcome is kept aside and
+    // applied at the layer of its distance so a shorter mate found meanwhile still wins
+    std::vector<std::uint8_t> conversion_wins(size, 0);
+    std::vector<std::uint8_t> conversion_losses(size, 0);
+    std::vector<std::uint8_t> conversion_draws(size, 0);
+    std::atomic<bool> is_overflow{false};
+
+    run_parallel(size, [&](std::size_t begin, std::size_t end) {
+        auto position = material;
+        std::vector<TablebasePosition> children;
+        std::vector<TablebasePosition> same_material_children;
+        std::vector<std::size_t> child_indices;
+        for (auto index = begin; index != end; ++index)
+        {
+            set_tablebase_index(position, index);
+            // symmetric positions are solved once at their smallest index
+            if (!is_tablebase_position_valid(position) || get_tablebase_index(position) != index)
+            {
+                values[index].store(TABLEBASE_INVALID, std::memory_order_relaxed);
+                continue;
+            }
+            generate_tablebase_moves(position, children);
+            same_material_children.clear();
+            for (const auto& child : children)
+            {
+                if (is_same_material(child, material))
+                {
+                    same_material_children.push_back(child);
+                    continue;
+                }
+                const auto child_probe = *decode_tablebase_value(probe(child));
+                const auto plies = static_cast<std::uint8_t>(child_probe.plies_to_mate + 1);
+                if (child_probe.result == TablebaseResult::LOSS)
+                {
+                    auto& conversion_win = conversion_wins[index];
+                    conversion_win = conversion_win == 0 ? plies : std::min(conversion_win, plies);
+                }
+                else if (child_probe.result == TablebaseResult::WIN)
+                {
+                    conversion_losses[index] = std::max(conversion_losses[index], plies);
+                }
+                else
+                {
+                    conversion_draws[index] = 1;
+                }
+            }
+            // unmoves find a parent once per child index, moves to symmetric children count once
+            get_unique_indices(same_material_children, child_indices);
+            const auto remaining = static_cast<std::uint8_t>(child_indices.size());
+            remaining_moves[index].store(remaining, std::memory_order_relaxed);
+
+            auto value = UNKNOWN;
+            if (children.empty())
+            {
+                value = is_tablebase_side_to_move_in_check(position) ? encode_loss(0)
+                                                                     : TABLEBASE_DRAW;
+            }
+            else if (remaining == 0 && conversion_wins[index] == 0)
+            {
+                if (conversion_losses[index] > TABLEBASE_MAX_LOSS_PLIES)
+                {
+                    is_overflow = true;
+                }
+                value = conversion_draws[index] ? TABLEBASE_DRAW
+                                                : encode_loss(conversion_losses[index]);
+            }
+            values[index].store(value, std::memory_order_relaxed);
+        }
+    });
+    const auto max_conversion_plies
+        = std::max(*std::max_element(conversion_wins.begin(), conversion_wins.end()),
+                   *std::max_element(conversion_losses.begin(), conversion_losses.end()));
+
+    for (std::uint32_t plies = 1; !is_overflow; ++plies)
+    {
+        const auto is_win_layer = plies % 2 == 1;
+        if (plies > (is_win_layer ? TABLEBASE_MAX_WIN_PLIES : TABLEBASE_MAX_LOSS_PLIES))
+        {
+            is_overflow = true;
+            break;
+        }
+        const auto source_value = is_win_layer ? encode_loss(plies - 1) : encode_win(plies - 1);
+        std::atomic<std::size_t> found_count{0};
+        run_parallel(size, [&](std::size_t begin, std::size_t end) {
+            auto position = material;
+            std::vector<TablebasePosition> parents;
+            std::vector<std::size_t> parent_indices;
+            std::size_t layer_found_count = 0;
+            for (auto index = begin; index != end; ++index)
+            {
+                const auto value = values[index].load(std::memory_order_relaxed);
+                if (is_win_layer && value == UNKNOWN && conversion_wins[index] == plies)
+                {
+                    values[index].store(encode_win(plies), std::memory_order_relaxed);
+                    ++layer_found_count;
+                    continue;
+                }
+                if (value != source_value)
+                {
+                    continue;
+                }
+                ++layer_found_count;
+                set_tablebase_index(position, index);
+                generate_tablebase_unmoves(position, parents);
+                get_unique_indices(parents, parent_indices);
+                for (const auto parent_index : parent_indices)
+                {
+                    if (values[parent_index].load(std::memory_order_relaxed) != UNKNOWN)
+                    {
+                        continue;
+                    }
+                    if (is_win_layer)
+                    {
+                        values[parent_index].store(encode_win(plies), std::memory_order_relaxed);
+                        continue;
+                    }
+                    // last move not refuted yet is lost as well, unless a conversion wins later
+                    if (remaining_moves[parent_index].fetch_sub(1) != 1
+                        || conversion_wins[parent_index] != 0)
+                    {
+                        continue;
+                    }
+                    const auto loss_plies
+                        = std::max<std::uint32_t>(plies, conversion_losses[parent_index]);
+                    if (loss_plies > TABLEBASE_MAX_LOSS_PLIES)
+                    {
+                        is_overflow = true;
+                    }
+                    values[parent_index].store(conversion_draws[parent_index]
+                                                   ? TABLEBASE_DRAW
+                                                   : encode_loss(loss_plies),
+                                               std::memory_order_relaxed);
+                }
+            }
+            found_count += layer_found_count;
+        });
+        if (found_count == 0 && plies > max_conversion_plies)
+        {
+            break;
+        }
+    }
+    if (is_overflow)
+    {
+        throw std::runtime_error("distance to mate of " + get_material_name(material)
+                                 + " doesn't fit into tablebase encoding");
+    }
+
+    std::vector<std::uint8_t> result(size);
+    for (std::size_t index = 0; index != size; ++index)
+    {
+        const auto value = values[index].load(std::memory_order_relaxed);
+        result[index] = value == UNKNOWN ? TABLEBASE_DRAW : value;
+    }
+    return result;
+}
+
+void TablebaseGenerator::run_parallel(
+    std::size_t count, const std::function<void(std::size_t, std::size_t)>& function) const
+{
+    const auto chunk_size = (count + m_thread_count - 1) / m_thread_count;
+    std::vector<std::thread> workers;
+    for (std::size_t begin = chunk_size; begin < count; begin += chunk_size)
+    {
+        workers.emplace_back(function, begin, std::min(begin + chunk_size, count));
+    }
+    function(0, std::min(chunk_size, count));
+    for (auto& worker : workers)
+    {
+        worker.join();
+    }
+}
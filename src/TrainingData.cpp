@@ -0,0 +1,154 @@
+#include <MappedFile.hpp>
+#include <TrainingData.hpp>
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <stdexcept>
+#include <string_view>
+
+namespace
+{
+constexpr std::string_view FILE_MAGIC = "CHESSTD1";
+
+constexpr std::array<std::pair<PieceColor, bool>, 4> CASTLING_FLAGS = {
+    std::pair{PieceColor::WHITE, true}, std::pair{PieceColor::WHITE, false},
+    std::pair{PieceColor::BLACK, true}, std::pair{PieceColor::BLACK, false}};
+}  // namespace
+
+std::int8_t to_record_result(GameResult result)
+{
+    return result == GameResult::WHITE_WON ? 1 : result == GameResult::BLACK_WON ? -1 : 0;
+}
+
+TrainingRecord encode_training_record(const PositionState& position,
+                                      std::int16_t score,
+                                      GameResult result,
+                                      std::uint32_t halfmove_clock,
+                                      std::uint32_t ply)
+{
+    TrainingRecord record;
+    const auto& board = position.get_board();
+    const auto occupancy = board.get_occupied_squares();
+    record.occupancy = occupancy.get_bits();
+    std::size_t piece_index = 0;
+    for (auto it = occupancy.begin(); it != occupancy.end(); ++it, ++piece_index)
+    {
+        const auto code = board.get_piece_code(it.get_square()).get_value();
+        record.pieces[piece_index / 2]
+            |= static_cast<std::uint8_t>(code << (4 * (piece_index % 2)));
+    }
+
+    record.score = score;
+    record.flags = position.get_side_to_move() == PieceColor::BLACK ? 1 : 0;
+    for (std::size_t flag_index = 0; flag_index != CASTLING_FLAGS.size(); ++flag_index)
+    {
+        const auto [color, king_side] = CASTLING_FLAGS[flag_index];
+        const auto& rights = position.get_castling_rights(color);
+        if (king_side ? rights.king_side_rook.has_value() : rights.queen_side_rook.has_value())
+        {
+            record.flags |= static_cast<std::uint8_t>(1 << (flag_index + 1));
+        }
+    }
+    if (const auto& en_passant = position.get_en_passant_takable())
+    {
+        record.en_passant_file = static_cast<std::uint8_t>(en_passant->x);
+    }
+    record.result = to_record_result(result);
+    record.halfmove_clock = static_cast<std::uint8_t>(std::min<std::uint32_t>(halfmove_clock, 255));
+    record.ply = static_cast<std::uint16_t>(std::min<std::uint32_t>(ply, UINT16_MAX));
+    return record;
+}
+
+Board decode_board(const TrainingRecord& record)
+{
+    Board board;
+    const SquareSet occupancy{record.occupancy};
+    std::size_t piece_index = 0;
+    for (auto it = occupancy.begin(); it != occupancy.end(); ++it, ++piece_index)
+    {
+        const auto code = (record.pieces[piece_index / 2] >> (4 * (piece_index % 2))) & 0xF;
+        board.add_piece(PieceCode{static_cast<PieceType>((code & 7) - 1),
+                                  static_cast<PieceColor>(code >> 3)},
+                        *it);
+    }
+    return board;
+}
+
+PieceColor get_side_to_move(const TrainingRecord& record)
+{
+    return (record.flags & 1) != 0 ? PieceColor::BLACK : PieceColor::WHITE;
+}
+
+GameResult get_result(const TrainingRecord& record)
+{
+    return record.result > 0   ? GameResult::WHITE_WON
+           : record.result < 0 ? GameResult::BLACK_WON
+                               : GameResult::DRAW;
+}
+
+TrainingDataWriter::TrainingDataWriter(std::string path_prefix, std::size_t max_file_size)
+    : m_path_prefix{std::move(path_prefix)}
+    , m_max_file_size{std::max(max_file_size, FILE_MAGIC.size() + sizeof(TrainingRecord))}
+{
+    open_next_file();
+}
+
+void TrainingDataWriter::write(const TrainingRecord& record)
+{
+    if (m_file_size + sizeof(TrainingRecord) > m_max_file_size)
+    {
+        open_next_file();
+    }
+    m_file.write(reinterpret_cast<const char*>(&record), sizeof(record));
+    if (!m_file)
+    {
+        throw std::runtime_error("can't write training data " + m_path_prefix);
+    }
+    m_file_size += sizeof(record);
+    ++m_record_count;
+}
+
+void TrainingDataWriter::flush()
+{
+    m_file.flush();
+}
+
+std::size_t TrainingDataWriter::get_file_count() const
+{
+    return m_file_count;
+}
+
+std::uint64_t TrainingDataWriter::get_record_count() const
+{
+    return m_record_count;
+}
+
+void TrainingDataWriter::open_next_file()
+{
+    std::array<char, 8> suffix;
+    std::snprintf(suffix.data(), suffix.size(), "-%03zu", m_file_count);
+    const auto path = m_path_prefix + suffix.data() + ".bin";
+    m_file = std::ofstream{path, std::ios::binary};
+    m_file.write(FILE_MAGIC.data(), FILE_MAGIC.size());
+    if (!m_file)
+    {
+        throw std::runtime_error("can't create training data " + path);
+    }
+    m_file_size = FILE_MAGIC.size();
+    ++m_file_count;
+}
+
+std::vector<TrainingRecord> read_training_records(const std::string& path)
+{
+    const MappedFile file{path};
+    const auto view = file.get_view();
+    if (view.substr(0, FILE_MAGIC.size()) != FILE_MAGIC
+        || (view.size() - FILE_MAGIC.size()) % sizeof(TrainingRecord) != 0)
+    {
+        throw std::runtime_error(path + " is not training data");
+    }
+    std::vector<TrainingRecord> records((view.size() - FILE_MAGIC.size()) / sizeof(TrainingRecord));
+    std::memcpy(records.data(), view.data() + FILE_MAGIC.size(),
+                records.size() * sizeof(TrainingRecord));
+    return records;
+}
@@ -0,0 +1,375 @@
+#include <Evaluation.hpp>
+#include <EvaluationParameters.hpp>
+#include <Tuner.hpp>
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <thread>
+
+namespace
+{
+constexpr std::size_t PIECE_TYPE_COUNT = 6;
+constexpr std::size_t BISHOP_PAIR_PARAMETER = PIECE_TYPE_COUNT;
+constexpr std::size_t PIECE_SQUARE_PARAMETERS = BISHOP_PAIR_PARAMETER + 1;
+constexpr std::size_t PARAMETER_COUNT = PIECE_SQUARE_PARAMETERS + PIECE_TYPE_COUNT * 64;
+
+constexpr std::uint16_t FEATURE_INDEX_MASK = 0x1FF;
+constexpr std::uint16_t BLACK_FEATURE_FLAG = 0x8000;
+
+constexpr double ADAM_EPSILON = 1e-8;
+constexpr double MIN_SCALING_CONSTANT = 1e-4;
+constexpr double MAX_SCALING_CONSTANT = 0.05;
+constexpr std::size_t SCALING_CONSTANT_ITERATIONS = 40;
+
+constexpr std::array<const char*, PIECE_TYPE_COUNT> PIECE_TYPE_NAMES = {
+    "king", "queen", "bishop", "knight", "rook", "pawn"};
+
+double get_win_probability(double scaling_constant, double score)
+{
+    return 1.0 / (1.0 + std::exp(-scaling_constant * score));
+}
+
+void append_values(std::string& text, const std::int32_t* values, std::size_t value_count)
+{
+    std::array<char, 16> value_text;
+    for (std::size_t value_index = 0; value_index != value_count; ++value_index)
+    {
+        std::snprintf(value_text.data(), value_text.size(), value_index == 0 ? "%d" : ", %d",
+                      values[value_index]);
+        text.append(value_text.data());
+    }
+}
+}  // namespace
+
+EvaluationParameters EvaluationParameters::get_compiled()
+{
+    EvaluationParameters parameters;
+    parameters.piece_values = EVALUATION_PIECE_VALUES;
+    parameters.bishop_pair_bonus = EVALUATION_BISHOP_PAIR_BONUS;
+    parameters.piece_square_tables = EVALUATION_PIECE_SQUARE_TABLES;
+    return parameters;
+}
+
+std::string format_evaluation_parameters(const EvaluationParameters& parameters)
+{
+    std::string text =
+        "#pragma once\n"
+        "#include <array>\n"
+        "#include <cstdint>\n"
+        "\n"
+        "/**\n"
+        " * @brief parameters of evaluate in centipawns, indexed by PieceType\n"
+        " * @note piece square tables are laid out the way the board is looked at by white: "
+        "first row is\n"
+        " *  rank 8, last row rank 1. Kept in own header so tuned values can replace it as a "
+        "whole\n"
+        " */\n"
+        "inline constexpr std::array<std::int32_t, 6> EVALUATION_PIECE_VALUES{";
+    append_values(text, parameters.piece_values.data(), parameters.piece_values.size());
+    text.append("};\n\ninline constexpr std::int32_t EVALUATION_BISHOP_PAIR_BONUS = ");
+    text.append(std::to_string(parameters.bishop_pair_bonus));
+    text.append(
+        ";\n"
+        "\n"
+        "// clang-format off\n"
+        "inline constexpr std::array<std::array<std::int32_t, 64>, 6> "
+        "EVALUATION_PIECE_SQUARE_TABLES{{\n");
+    std::array<char, 8> value_text;
+    for (std::size_t type_index = 0; type_index != PIECE_TYPE_COUNT; ++type_index)
+    {
+        text.append("    // ").append(PIECE_TYPE_NAMES[type_index]).append("\n");
+        for (std::size_t square_index = 0; square_index != 64; ++square_index)
+        {
+            const auto file = square_index % 8;
+            text.append(file != 0 ? ", " : square_index == 0 ? "    {" : "     ");
+            std::snprintf(value_text.data(), value_text.size(), "%3d",
+                          parameters.piece_square_tables[type_index][square_index]);
+            text.append(value_text.data());
+            if (file == 7)
+            {
+                text.append(square_index == 63 ? "},\n" : ",\n");
+            }
+        }
+    }
+    text.append("}};\n// clang-format on\n");
+    return text;
+}
+
+TunerDataset::TunerDataset()
+    : m_offsets{0}
+{
+}
+
+void TunerDataset::reserve(std::size_t position_count)
+{
+    // a middlegame position has about 30 pieces
+    m_offsets.reserve(position_count + 1);
+    m_features.reserve(position_count * 30);
+    m_bishop_pairs.reserve(position_count);
+    m_results.reserve(position_count);
+    m_scores.reserve(position_count);
+}
+
+void TunerDataset::add_position(const Board& board, float result, std::int16_t score)
+{
+    board.for_each_piece([this](PieceCode piece_code, const Position& position) {
+        const auto color = piece_code.get_color();
+        const auto type_index = static_cast<std::uint16_t>(piece_code.get_type());
+        const auto square_index = get_piece_square_index(Square{position}, color);
+        const auto color_flag = color == PieceColor::BLACK ? BLACK_FEATURE_FLAG : 0;
+        m_features.push_back(static_cast<std::uint16_t>((type_index * 64 + square_index)
+                                                        | color_flag));
+    });
+    m_offsets.push_back(static_cast<std::uint32_t>(m_features.size()));
+    const auto has_bishop_pair = [&board](PieceColor color) {
+        return board.get_pieces(color, PieceType::BISHOP).size() >= 2 ? 1 : 0;
+    };
+    m_bishop_pairs.push_back(static_cast<std::int8_t>(has_bishop_pair(PieceColor::WHITE)
+                                                      - has_bishop_pair(PieceColor::BLACK)));
+    m_results.push_back(result);
+    m_scores.push_back(score);
+}
+
+void TunerDataset::add_records(const std::vector<TrainingRecord>& records)
+{
+    reserve(get_position_count() + records.size());
+    for (const auto& record : records)
+    {
+        const auto is_white_to_move = get_side_to_move(record) == PieceColor::WHITE;
+        add_position(decode_board(record), 0.5f + 0.5f * record.result,
+                     static_cast<std::int16_t>(is_white_to_move ? record.score : -record.score));
+    }
+}
+
+std::size_t TunerDataset::get_position_count() const
+{
+    return m_results.size();
+}
+
+const std::uint16_t* TunerDataset::get_features_begin(std::size_t position_index) const
+{
+    return m_features.data() + m_offsets[position_index];
+}
+
+const std::uint16_t* TunerDataset::get_features_end(std::size_t position_index) const
+{
+    return m_features.data() + m_offsets[position_index + 1];
+}
+
+std::int8_t TunerDataset::get_bishop_pair(std::size_t position_index) const
+{
+    return m_bishop_pairs[position_index];
+}
+
+float TunerDataset::get_result(std::size_t position_index) const
+{
+    return m_results[position_index];
+}
+
+std::int16_t TunerDataset::get_score(std::size_t position_index) const
+{
+    return m_scores[position_index];
+}
+
+EvaluationTuner::EvaluationTuner(const TunerDataset& dataset,
+                                 const EvaluationParameters& initial_parameters,
+                                 const TunerConfig& config)
+    : m_dataset{dataset}
+    , m_config{config}
+    , m_scaling_constant{std::log(10.0) / 400.0}
+    , m_parameters(PARAMETER_COUNT)
+    , m_first_moments(PARAMETER_COUNT)
+    , m_second_moments(PARAMETER_COUNT)
+{
+    m_config.thread_count = std::max<std::size_t>(1, m_config.thread_count);
+    std::copy(initial_parameters.piece_values.begin(), initial_parameters.piece_values.end(),
+              m_parameters.begin());
+    m_parameters[BISHOP_PAIR_PARAMETER] = initial_parameters.bishop_pair_bonus;
+    for (std::size_t type_index = 0; type_index != PIECE_TYPE_COUNT; ++type_index)
+    {
+        const auto& table = initial_parameters.piece_square_tables[type_index];
+        std::copy(table.begin(), table.end(),
+                  m_parameters.begin() + PIECE_SQUARE_PARAMETERS + type_index * 64);
+    }
+}
+
+double EvaluationTuner::fit_scaling_constant()
+{
+    // golden section search, the error is unimodal in k
+    const auto ratio = (std::sqrt(5.0) - 1.0) / 2.0;
+    auto low = MIN_SCALING_CONSTANT;
+    auto high = MAX_SCALING_CONSTANT;
+    const auto get_error_at = [this](double scaling_constant) {
+        m_scaling_constant = scaling_constant;
+        return get_error();
+    };
+    auto left = high - ratio * (high - low);
+    auto right = low + ratio * (high - low);
+    auto left_error = get_error_at(left);
+    auto right_error = get_error_at(right);
+    for (std::size_t iteration = 0; iteration != SCALING_CONSTANT_ITERATIONS; ++iteration)
+    {
+        if (left_error < right_error)
+        {
+            high = right;
+            right = left;
+            right_error = left_error;
+            left = high - ratio * (high - low);
+            left_error = get_error_at(left);
+        }
+        else
+        {
+            low = left;
+            left = right;
+            left_error = right_error;
+            right = low + ratio * (high - low);
+            right_error = get_error_at(right);
+        }
+    }
+    m_scaling_constant = (low + high) / 2;
+    return m_scaling_constant;
+}
+
+void EvaluationTuner::set_scaling_constant(double scaling_constant)
+{
+    m_scaling_constant = scaling_constant;
+}
+
+double EvaluationTuner::get_scaling_constant() const
+{
+    return m_scaling_constant;
+}
+
+double EvaluationTuner::get_error() const
+{
+    return compute_error(nullptr);
+}
+
+double EvaluationTuner::run_epoch()
+{
+    std::vector<double> gradient(PARAMETER_COUNT);
+    const auto error = compute_error(&gradient);
+    ++m_step_count;
+    const auto first_correction = 1.0 - std::pow(m_config.beta1, m_step_count);
+    const auto second_correction = 1.0 - std::pow(m_config.beta2, m_step_count);
+    for (std::size_t parameter = 0; parameter != PARAMETER_COUNT; ++parameter)
+    {
+        auto& first_moment = m_first_moments[parameter];
+        auto& second_moment = m_second_moments[parameter];
+        first_moment = m_config.beta1 * first_moment + (1.0 - m_config.beta1) * gradient[parameter];
+        second_moment = m_config.beta2 * second_moment
+                        + (1.0 - m_config.beta2) * gradient[parameter] * gradient[parameter];
+        m_parameters[parameter]
+            -= m_config.learning_rate * (first_moment / first_correction)
+               / (std::sqrt(second_moment / second_correction) + ADAM_EPSILON);
+    }
+    return error;
+}
+
+double EvaluationTuner::evaluate(std::size_t position_index) const
+{
+    double score = m_dataset.get_bishop_pair(position_index) * m_parameters[BISHOP_PAIR_PARAMETER];
+    const auto features_end = m_dataset.get_features_end(position_index);
+    for (auto feature = m_dataset.get_features_begin(position_index); feature != features_end;
+         ++feature)
+    {
+        const auto index = *feature & FEATURE_INDEX_MASK;
+        const auto value = m_parameters[index / 64] + m_parameters[PIECE_SQUARE_PARAMETERS + index];
+        score += (*feature & BLACK_FEATURE_FLAG) != 0 ? -value : value;
+    }
+    return score;
+}
+
+EvaluationParameters EvaluationTuner::get_parameters() const
+{
+    const auto round = [](double value) { return static_cast<std::int32_t>(std::lround(value)); };
+    EvaluationParameters parameters;
+    std::transform(m_parameters.begin(), m_parameters.begin() + PIECE_TYPE_COUNT,
+                   parameters.piece_values.begin(), round);
+    parameters.bishop_pair_bonus = round(m_parameters[BISHOP_PAIR_PARAMETER]);
+    for (std::size_t type_index = 0; type_index != PIECE_TYPE_COUNT; ++type_index)
+    {
+        const auto table_begin = m_parameters.begin() + PIECE_SQUARE_PARAMETERS + type_index * 64;
+        std::transform(table_begin, table_begin + 64,
+                       parameters.piece_square_tables[type_index].begin(), round);
+    }
+    return parameters;
+}
+
+double EvaluationTuner::accumulate_error(std::size_t begin,
+                                         std::size_t end,
+                                         std::vector<double>& gradient) const
+{
+    double error = 0.0;
+    for (std::size_t position_index = begin; position_index != end; ++position_index)
+    {
+        const auto probability = get_win_probability(m_scaling_constant, evaluate(position_index));
+        const auto target
+            = m_config.result_weight * m_dataset.get_result(position_index)
+              + (1.0 - m_config.result_weight)
+                    * get_win_probability(m_scaling_constant, m_dataset.get_score(position_index));
+        const auto difference = probability - target;
+        error += difference * difference;
+        if (gradient.empty())
+        {
+            continue;
+        }
+        // derivative of the squared error by the evaluation, every parameter enters linearly
+        const auto slope
+            = 2.0 * difference * probability * (1.0 - probability) * m_scaling_constant;
+        gradient[BISHOP_PAIR_PARAMETER] += slope * m_dataset.get_bishop_pair(position_index);
+        const auto features_end = m_dataset.get_features_end(position_index);
+        for (auto feature = m_dataset.get_features_begin(position_index); feature != features_end;
+             ++feature)
+        {
+            const auto index = *feature & FEATURE_INDEX_MASK;
+            const auto signed_slope = (*feature & BLACK_FEATURE_FLAG) != 0 ? -slope : slope;
+            gradient[index / 64] += signed_slope;
+            gradient[PIECE_SQUARE_PARAMETERS + index] += signed_slope;
+        }
+    }
+    return error;
+}
+
+double EvaluationTuner::compute_error(std::vector<double>* gradient) const
+{
+    const auto position_count = m_dataset.get_position_count();
+    if (position_count == 0)
+    {
+        return 0.0;
+    }
+    const auto thread_count = std::min(m_config.thread_count, position_count);
+    const auto chunk_size = (position_count + thread_count - 1) / thread_count;
+    std::vector<double> errors(thread_count);
+    std::vector<std::vector<double>> gradients(
+        thread_count, std::vector<double>(gradient ? PARAMETER_COUNT : 0));
+    const auto accumulate_chunk = [&](std::size_t chunk_index) {
+        const auto chunk_begin = std::min(position_count, chunk_index * chunk_size);
+        const auto chunk_end = std::min(position_count, chunk_begin + chunk_size);
+        errors[chunk_index] = accumulate_error(chunk_begin, chunk_end, gradients[chunk_index]);
+    };
+    std::vector<std::thread> workers;
+    for (std::size_t chunk_index = 1; chunk_index < thread_count; ++chunk_index)
+    {
+        workers.emplace_back(accumulate_chunk, chunk_index);
+    }
+    accumulate_chunk(0);
+    for (auto& worker : workers)
+    {
+        worker.join();
+    }
+
+    double error = 0.0;
+    for (std::size_t chunk_index = 0; chunk_index != thread_count; ++chunk_index)
+    {
+        error += errors[chunk_index];
+        if (gradient)
+        {
+            for (std::size_t parameter = 0; parameter != PARAMETER_COUNT; ++parameter)
+            {
+                (*gradient)[parameter] += gradients[chunk_index][parameter] / position_count;
+            }
+        }
+    }
+    return error / position_count;
+}
@@ -0,0 +1,145 @@
+#include <UnixSocket.hpp>
+#include <cerrno>
+#include <cstring>
+#include <poll.h>
+#include <stdexcept>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include <utility>
+
+namespace
+{
+sockaddr_un get_address(const std::string& path)
+{
+    sockaddr_un address{};
+    if (path.size() >= sizeof(address.sun_path))
+    {
+        throw std::runtime_error("Socket path too long " + path);
+    }
+    address.sun_family = AF_UNIX;
+    std::memcpy(address.sun_path, path.c_str(), path.size() + 1);
+    return address;
+}
+}  // namespace
+
+UnixSocket UnixSocket::listen(const std::string& path)
+{
+    const auto address = get_address(path);
+    UnixSocket socket{::socket(AF_UNIX, SOCK_STREAM, 0)};
+    if (!socket.is_open())
+    {
+        throw std::runtime_error("Can't create socket");
+    }
+    ::unlink(path.c_str());
+    if (::bind(socket.m_file_descriptor, reinterpret_cast<const sockaddr*>(&address),
+               sizeof(address))
+            != 0
+        || ::listen(socket.m_file_descriptor, SOMAXCONN) != 0)
+    {
+        throw std::runtime_error("Can't listen on socket " + path);
+    }
+    return socket;
+}
+
+UnixSocket UnixSocket::connect(const std::string& path)
+{
+    const auto address = get_address(path);
+    UnixSocket socket{::socket(AF_UNIX, SOCK_STREAM, 0)};
+    if (!socket.is_open()
+        || ::connect(socket.m_file_descriptor, reinterpret_cast<const sockaddr*>(&address),
+                     sizeof(address))
+               != 0)
+    {
+        throw std::runtime_error("Can't connect to socket " + path);
+    }
+    return socket;
+}
+
+UnixSocket::UnixSocket(int file_descriptor)
+    : m_file_descriptor{file_descriptor}
+{
+}
+
+UnixSocket::UnixSocket(UnixSocket&& other) noexcept
+    : m_file_descriptor(std::exchange(other.m_file_descriptor, -1))
+{
+}
+
+UnixSocket& UnixSocket::operator=(UnixSocket&& other) noexcept
+{
+    if (this != &other)
+    {
+        close();
+        m_file_descriptor = std::exchange(other.m_file_descriptor, -1);
+    }
+    return *this;
+}
+
+UnixSocket::~UnixSocket()
+{
+    close();
+}
+
+bool UnixSocket::is_open() const
+{
+    return m_file_descriptor >= 0;
+}
+
+UnixSocket UnixSocket::accept(int timeout_ms) const
+{
+    pollfd poll_descriptor{m_file_descriptor, POLLIN, 0};
+    if (::poll(&poll_descriptor, 1, timeout_ms) <= 0)
+    {
+        return {};
+    }
+    return UnixSocket{::accept(m_file_descriptor, nullptr, nullptr)};
+}
+
+std::size_t UnixSocket::read_some(char* data, std::size_t size) const
+{
+    while (true)
+    {
+        const auto read_size = ::recv(m_file_descriptor, data, size, 0);
+        if (read_size >= 0)
+        {
+            return static_cast<std::size_t>(read_size);
+        }
+        if (errno != EINTR)
+        {
+            return 0;
+        }
+    }
+}
+
+bool UnixSocket::write_all(const char* data, std::size_t size) const
+{
+    while (size != 0)
+    {
+        const auto written_size = ::send(m_file_descriptor, data, size, MSG_NOSIGNAL);
+        if (written_size < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+            return false;
+        }
+        data += written_size;
+        size -= static_cast<std::size_t>(written_size);
+    }
+    return true;
+}
+
+void UnixSocket::shutdown() const
+{
+    ::shutdown(m_file_descriptor, SHUT_RDWR);
+}
+
+void UnixSocket::close()
+{
+    if (m_file_descriptor >= 0)
+    {
+        ::close(std::exchange(m_file_descriptor, -1));
+    }
+}
@@ -0,0 +1,305 @@
+#include <gtest/gtest.h>
+
+#include <AnalysisConnection.hpp>
+#include <future>
+#include <unistd.h>
+
+namespace
+{
+constexpr auto ROOK_MATE_FEN = "6k1/5ppp/8/8/8/8/8/R5K1 w - - 0 1";
+constexpr auto STARTING_FEN = "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1";
+
+std::string get_test_socket_path(const char* name)
+{
+    return "/tmp/chess_analysis_test_" + std::to_string(::getpid()) + "_" + name + ".sock";
+}
+
+/**
+ * @brief collects replies of server, waits until expected number arrived
+ */
+class ReplyCollector
+{
+public:
+    AnalysisServer::ReplyCallback get_callback()
+    {
+        return [this](std::string reply) {
+            std::lock_guard lock{m_mutex};
+            m_replies.push_back(std::move(reply));
+            m_condition.notify_all();
+        };
+    }
+
+    std::vector<std::string> wait_for(std::size_t reply_count)
+    {
+        std::unique_lock lock{m_mutex};
+        m_condition.wait(lock, [&] { return m_replies.size() >= reply_count; });
+        return m_replies;
+    }
+
+private:
+    std::mutex m_mutex;
+    std::condition_variable m_condition;
+    std::vector<std::string> m_replies;
+};
+}  // namespace
+
+TEST(AnalysisProtocol, frames_survive_arbitrary_splits)
+{
+    const auto stream = encode_frame("1 metrics") + encode_frame("") + encode_frame("2 eval x");
+    FrameDecoder decoder;
+    std::vector<std::string> frames;
+    for (const auto byte : stream)
+    {
+        decoder.append(&byte, 1);
+        while (auto frame = decoder.next_frame())
+        {
+            frames.push_back(std::move(*frame));
+        }
+    }
+    EXPECT_EQ(frames, (std::vector<std::string>{"1 metrics", "", "2 eval x"}));
+}
+
+TEST(AnalysisProtocol, oversized_frame_is_rejected)
+{
+    const std::string header = {'\xFF', '\xFF', '\xFF', '\x7F'};
+    FrameDecoder decoder;
+    decoder.append(header.data(), header.size());
+    EXPECT_THROW(decoder.next_frame(), std::length_error);
+}
+
+TEST(AnalysisProtocol, requests_round_trip)
+{
+    AnalysisRequest request;
+    request.id = 7;
+    request.command = AnalysisCommand::SEARCH;
+    request.fen = ROOK_MATE_FEN;
+    request.limits.max_depth = 3;
+    request.limits.move_time = std::chrono::milliseconds{50};
+    request.deadline = std::chrono::milliseconds{100};
+    const auto payload = format_analysis_request(request);
+    EXPECT_EQ(payload, std::string{"7 search 3 50 100 "} + ROOK_MATE_FEN);
+
+    const auto parsed = parse_analysis_request(payload);
+    EXPECT_EQ(parsed.id, 7u);
+    EXPECT_EQ(parsed.command, AnalysisCommand::SEARCH);
+    EXPECT_EQ(parsed.fen, ROOK_MATE_FEN);
+    EXPECT_EQ(parsed.limits.max_depth, 3u);
+    EXPECT_EQ(parsed.limits.move_time, std::chrono::milliseconds{50});
+    EXPECT_EQ(parsed.deadline, std::chrono::milliseconds{100});
+
+    const auto unlimited = parse_analysis_request("8 search 0 0 0 8/8/8/8/8/8/8/8 w - - 0 1");
+    EXPECT_EQ(unlimited.limits.max_depth, MAX_SEARCH_DEPTH);
+    EXPECT_FALSE(unlimited.limits.move_time);
+    EXPECT_FALSE(unlimited.deadline);
+}
+
+TEST(AnalysisProtocol, malformed_requests_throw)
+{
+    EXPECT_THROW(parse_analysis_request(""), std::invalid_argument);
+    EXPECT_THROW(parse_analysis_request("x moves 8/8/8/8/8/8/8/8 w - - 0 1"),
+                 std::invalid_argument);
+    EXPECT_THROW(parse_analysis_request("1 perft 8/8/8/8/8/8/8/8 w - - 0 1"),
+                 std::invalid_argument);
+    EXPECT_THROW(parse_analysis_request("1 moves"), std::invalid_argument);
+    EXPECT_THROW(parse_analysis_request("1 search 3 x 0 8/8/8/8/8/8/8/8 w - - 0 1"),
+                 std::invalid_argument);
+    EXPECT_EQ(get_payload_id("12 ok"), 12u);
+    EXPECT_EQ(get_payload_id("ok"), 0u);
+}
+
+TEST(AnalysisServer, batches_short_requests)
+{
+    AnalysisServerConfig config;
+    config.batch_window = std::chrono::milliseconds{50};
+    AnalysisServer server{config};
+    ReplyCollector collector;
+    const auto starting_fen = "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1";
+    server.submit(std::string{"1 moves "} + starting_fen, collector.get_callback());
+    server.submit(std::string{"2 eval "} + starting_fen, collector.get_callback());
+    server.submit("3 moves not a fen", collector.get_callback());
+    server.submit("4 bogus", collector.get_callback());
+
+    auto replies = collector.wait_for(4);
+    std::sort(replies.begin(), replies.end());
+    EXPECT_EQ(replies[0].rfind("1 ok ", 0), 0u) << replies[0];
+    EXPECT_EQ(std::count(replies[0].begin(), replies[0].end(), ' '), 21);
+    EXPECT_EQ(replies[1], "2 ok 0");
+    EXPECT_EQ(replies[2].rfind("3 error ", 0), 0u) << replies[2];
+    EXPECT_EQ(replies[3].rfind("4 error ", 0), 0u) << replies[3];
+
+    const auto metrics = server.get_metrics();
+    EXPECT_EQ(metrics.batches, 1u);
+    EXPECT_EQ(metrics.batched_requests, 3u);
+    EXPECT_EQ(metrics.latencies[static_cast<std::size_t>(AnalysisCommand::LEGAL_MOVES)]
+                  .sample_count,
+              1u);
+    EXPECT_EQ(metrics.failed_requests, 2u);
+}
+
+TEST(AnalysisServer, searches_and_rejects_when_full)
+{
+    AnalysisServerConfig config;
+    config.search_thread_count = 1;
+    config.max_queued_searches = 1;
+    ReplyCollector collector;
+    {
+        AnalysisServer server{config};
+        server.submit(std::string{"1 search 3 0 0 "} + ROOK_MATE_FEN, collector.get_callback());
+        const auto replies = collector.wait_for(1);
+        EXPECT_EQ(replies[0].rfind("1 ok bestmove a1a8 ", 0), 0u) << replies[0];
+
+        // an unlimited search occupies the thread, the next one fills the queue
+        server.submit("2 search 0 0 0 rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1",
+                      collector.get_callback());
+        while (server.get_metrics().search_queue_depth != 0)
+        {
+            std::this_thread::yield();
+        }
+        server.submit(std::string{"3 search 1 0 1 "} + ROOK_MATE_FEN, collector.get_callback());
+        server.submit(std::string{"4 search 1 0 0 "} + ROOK_MATE_FEN, collector.get_callback());
+        EXPECT_EQ(collector.wait_for(2)[1], "4 error busy");
+        const auto metrics = server.get_metrics();
+        EXPECT_EQ(metrics.rejected_requests, 1u);
+        EXPECT_EQ(metrics.failed_requests, 1u);
+        // the rejection answered at once doesn't pull down the latency of served searches
+        const auto& latency = metrics.latencies[static_cast<std::size_t>(AnalysisCommand::SEARCH)];
+        EXPECT_EQ(latency.sample_count, 1u);
+    }
+    auto replies = collector.wait_for(4);
+    std::sort(replies.begin(), replies.end());
+    EXPECT_EQ(replies[1].rfind("2 ok bestmove ", 0), 0u) << replies[1];
+    EXPECT_EQ(replies[2], "3 error shutting down");
+}
+
+TEST(AnalysisServer, expired_search_is_not_searched)
+{
+    AnalysisServerConfig config;
+    config.search_thread_count = 1;
+    AnalysisServer server{config};
+    ReplyCollector collector;
+    server.submit("1 search 0 100 0 rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1",
+                  collector.get_callback());
+    server.submit(std::string{"2 search 1 0 10 "} + ROOK_MATE_FEN, collector.get_callback());
+    const auto replies = collector.wait_for(2);
+    EXPECT_EQ(replies[1], "2 error deadline expired");
+    EXPECT_EQ(server.get_metrics().expired_requests, 1u);
+}
+
+TEST(AnalysisServer, serves_over_unix_socket)
+{
+    const auto path = get_test_socket_path("single");
+    const auto listener = UnixSocket::listen(path);
+    auto client_reply = std::async(std::launch::async, [&path] {
+        const auto client = UnixSocket::connect(path);
+        const auto frame = encode_frame("5 metrics");
+        EXPECT_TRUE(client.write_all(frame.data(), frame.size()));
+        FrameDecoder decoder;
+        char buffer[256];
+        while (const auto size = client.read_some(buffer, sizeof(buffer)))
+        {
+            decoder.append(buffer, size);
+            if (auto reply = decoder.next_frame())
+            {
+                return *reply;
+            }
+        }
+        return std::string{};
+    });
+
+    const auto connection = listener.accept(5000);
+    ASSERT_TRUE(connection.is_open());
+    AnalysisServer server;
+    FrameDecoder decoder;
+    char buffer[256];
+    std::optional<std::string> payload;
+    while (!payload)
+    {
+        const auto size = connection.read_some(buffer, sizeof(buffer));
+        ASSERT_NE(size, 0u);
+        decoder.append(buffer, size);
+        payload = decoder.next_frame();
+    }
+    server.submit(*payload, [&connection](std::string reply) {
+        const auto frame = encode_frame(reply);
+        connection.write_all(frame.data(), frame.size());
+    });
+    const auto reply = client_reply.get();
+    EXPECT_EQ(reply.rfind("5 ok {\"batch_queue_depth\":0,", 0), 0u) << reply;
+    ::unlink(path.c_str());
+}
+
+TEST(AnalysisServer, rejects_batch_requests_when_full)
+{
+    AnalysisServerConfig config;
+    config.max_queued_batch_requests = 2;
+    config.batch_window = std::chrono::seconds{1};
+    AnalysisServer server{config};
+    ReplyCollector collector;
+    for (const auto id : {"1", "2", "3"})
+    {
+        server.submit(std::string{id} + " eval " + STARTING_FEN, collector.get_callback());
+    }
+    EXPECT_EQ(collector.wait_for(1)[0], "3 error busy");
+    EXPECT_EQ(server.get_metrics().rejected_requests, 1u);
+    EXPECT_EQ(collector.wait_for(3).size(), 3u);
+}
+
+TEST(AnalysisConnection, client_not_reading_does_not_stall_others)
+{
+    const auto path = get_test_socket_path("slow");
+    const auto listener = UnixSocket::listen(path);
+    AnalysisServer server;
+    constexpr std::size_t MAX_OUTBOUND_BYTES = 64 * 1024;
+
+    const auto slow_client = UnixSocket::connect(path);
+    auto slow_socket = listener.accept(5000);
+    ASSERT_TRUE(slow_socket.is_open());
+    const AnalysisConnection slow_connection{std::move(slow_socket), server, MAX_OUTBOUND_BYTES};
+    std::string requests;
+    for (std::size_t id = 1; id <= 20000; ++id)
+    {
+        requests += encode_frame(std::to_string(id) + " moves " + STARTING_FEN);
+    }
+    // fails once the server dropped the client, which is fine here
+    slow_client.write_all(requests.data(), requests.size());
+
+    const auto client = UnixSocket::connect(path);
+    auto socket = listener.accept(5000);
+    ASSERT_TRUE(socket.is_open());
+    const AnalysisConnection connection{std::move(socket), server, MAX_OUTBOUND_BYTES};
+    const auto request = [&client](const std::string& payload) {
+        return std::async(std::launch::async, [&client, payload] {
+            const auto frame = encode_frame(payload);
+            client.write_all(frame.data(), frame.size());
+            FrameDecoder decoder;
+            char buffer[256];
+            while (const auto size = client.read_some(buffer, sizeof(buffer)))
+            {
+                decoder.append(buffer, size);
+                if (auto reply = decoder.next_frame())
+                {
+                    return *reply;
+                }
+            }
+            return std::string{};
+        });
+    };
+    // the batch queue may still be full of requests of the slow client, busy is an answer too
+    auto reply = request(std::string{"1 eval "} + STARTING_FEN);
+    ASSERT_EQ(reply.wait_for(std::chrono::seconds{3}), std::future_status::ready);
+    EXPECT_EQ(reply.get().rfind("1 ", 0), 0u);
+
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds{5};
+    while ((!slow_connection.is_closed() || server.get_metrics().batch_queue_depth != 0)
+           && std::chrono::steady_clock::now() < deadline)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds{1});
+    }
+    reply = request(std::string{"2 eval "} + STARTING_FEN);
+    ASSERT_EQ(reply.wait_for(std::chrono::seconds{3}), std::future_status::ready);
+    EXPECT_EQ(reply.get(), "2 ok 0");
+    EXPECT_TRUE(slow_connection.is_closed());
+    EXPECT_TRUE(slow_connection.is_slow_consumer());
+    EXPECT_FALSE(connection.is_closed());
+    ::unlink(path.c_str());
+}
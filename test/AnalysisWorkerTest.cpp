@@ -0,0 +1,63 @@
+#include <gtest/gtest.h>
+
+#include <AnalysisWorker.hpp>
+
+TEST(AnalysisWorker, publishes_moves_and_result)
+{
+    AnalysisWorker worker;
+    SearchLimits limits;
+    limits.max_depth = 3;
+    const auto request_id
+        = worker.analyse(GameState::from_fen("6k1/5ppp/8/8/8/8/8/R5K1 w - - 0 1"), limits);
+    worker.wait_until_finished(request_id);
+    const auto snapshot = worker.get_snapshot();
+    EXPECT_EQ(snapshot.request_id, request_id);
+    EXPECT_FALSE(snapshot.is_searching);
+    EXPECT_EQ(snapshot.legal_moves.size(), 17u);
+    ASSERT_TRUE(snapshot.result.best_move);
+    EXPECT_EQ(snapshot.result.best_move->to, (Position{0, 7}));
+}
+
+TEST(AnalysisWorker, new_request_replaces_running_search)
+{
+    AnalysisWorker worker;
+    worker.analyse(GameState::get_starting_position(), {});
+    SearchLimits limits;
+    limits.max_depth = 1;
+    const auto request_id = worker.analyse(GameState::get_starting_position(), limits);
+    worker.wait_until_finished(request_id);
+    const auto snapshot = worker.get_snapshot();
+    EXPECT_EQ(snapshot.request_id, request_id);
+    EXPECT_EQ(snapshot.result.depth, 1u);
+    EXPECT_EQ(snapshot.legal_moves.size(), 20u);
+}
+
+TEST(AnalysisWorker, stop_keeps_last_completed_depth)
+{
+    AnalysisWorker worker;
+    const auto request_id = worker.analyse(GameState::get_starting_position(), {});
+    while (worker.get_snapshot().result.depth == 0)
+    {
+        std::this_thread::yield();
+    }
+    worker.stop();
+    worker.wait_until_finished(request_id);
+    const auto snapshot = worker.get_snapshot();
+    EXPECT_FALSE(snapshot.is_searching);
+    EXPECT_GE(snapshot.result.depth, 1u);
+    EXPECT_TRUE(snapshot.result.best_move);
+}
+
+TEST(AnalysisWorker, stop_before_pickup_finishes_request)
+{
+    AnalysisWorker worker;
+    for (std::size_t iteration = 0; iteration != 100; ++iteration)
+    {
+        const auto request_id = worker.analyse(GameState::get_starting_position(), {});
+        worker.stop();
+        worker.wait_until_finished(request_id);
+        const auto snapshot = worker.get_snapshot();
+        EXPECT_EQ(snapshot.request_id, request_id);
+        EXPECT_FALSE(snapshot.is_searching);
+    }
+}
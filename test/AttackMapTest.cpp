@@ -0,0 +1,69 @@
+#include <gtest/gtest.h>
+
+#include <AttackMap.hpp>
+#include <Attacks.hpp>
+#include <PositionState.hpp>
+
+namespace
+{
+void expect_map_matches_board(const AttackMap& attack_map, const Board& board)
+{
+    EXPECT_TRUE(attack_map == AttackMap{board});
+    const auto occupancy = board.get_occupied_squares();
+    for (const auto color : {PieceColor::WHITE, PieceColor::BLACK})
+    {
+        EXPECT_EQ(attack_map.get_attacked_squares(color), get_attacked_squares(board, color));
+        for (std::uint8_t index = 0; index != SQUARE_COUNT; ++index)
+        {
+            const Square square{index};
+            EXPECT_EQ(attack_map.get_attacker_count(square, color),
+                      (attackers_to(board, square, occupancy) & board.get_pieces(color)).size());
+        }
+    }
+}
+}  // namespace
+
+TEST(AttackMap, counts_attackers_of_both_colors)
+{
+    const auto position = PositionState::from_fen("4k3/8/8/3r4/8/2N1N3/8/3RK3 w - - 0 1");
+    const AttackMap attack_map{position.get_board()};
+    const Square d5{Position{3, 4}};
+    EXPECT_EQ(attack_map.get_attacker_count(d5, PieceColor::WHITE), 3u);
+    EXPECT_EQ(attack_map.get_attacker_count(d5, PieceColor::BLACK), 0u);
+    EXPECT_TRUE(attack_map.is_attacked(Square{Position{3, 0}}, PieceColor::BLACK));
+    EXPECT_EQ(attack_map.get_piece_attacks(Square{Position{0, 0}}), SquareSet{});
+}
+
+TEST(AttackMap, incremental_updates_match_full_recomputation)
+{
+    for (const auto fen : {"rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1",
+                           "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1",
+                           "8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8 w - - 0 1",
+                           "r3k2r/1P6/8/8/8/8/6p1/R3K2R b KQkq - 0 1"})
+    {
+        auto position = PositionState::from_fen(fen);
+        AttackMap attack_map{position.get_board()};
+        std::vector<Move> moves;
+        for (std::size_t ply = 0; ply != 60; ++ply)
+        {
+            position.generate_legal_moves(moves);
+            if (moves.empty())
+            {
+                break;
+            }
+            // every move is made and unmade once, then one of them is kept
+            for (const auto& move : moves)
+            {
+                const auto undo_info = position.make_move(move);
+                attack_map.update(position.get_board(), move);
+                expect_map_matches_board(attack_map, position.get_board());
+                position.unmake_move(move, undo_info);
+                attack_map.update(position.get_board(), move);
+            }
+            expect_map_matches_board(attack_map, position.get_board());
+            const auto& move = moves[(ply * 7) % moves.size()];
+            position.make_move(move);
+            attack_map.update(position.get_board(), move);
+        }
+    }
+}
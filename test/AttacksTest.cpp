@@ -0,0 +1,123 @@
+#include <gtest/gtest.h>
+
+#include <Attacks.hpp>
+#include <MoveGenerator.hpp>
+#include <PositionState.hpp>
+
+namespace
+{
+SquareSet get_attacked_squares_piece_by_piece(const Board& board, PieceColor color)
+{
+    SquareSet attacks;
+    board.for_each_piece(
+        [&board, &attacks, color](PieceCode piece_code, const Position& position)
+        {
+            if (piece_code.get_color() != color)
+            {
+                return;
+            }
+            const Square square{position};
+            const auto occupancy = board.get_occupied_squares();
+            switch (piece_code.get_type())
+            {
+            case PieceType::KING:
+                attacks |= get_king_attacks(square);
+                break;
+            case PieceType::QUEEN:
+                attacks |= get_bishop_attacks(square, occupancy);
+                attacks |= get_rook_attacks(square, occupancy);
+                break;
+            case PieceType::BISHOP:
+                attacks |= get_bishop_attacks(square, occupancy);
+                break;
+            case PieceType::KNIGHT:
+                attacks |= get_knight_attacks(square);
+                break;
+            case PieceType::ROOK:
+                attacks |= get_rook_attacks(square, occupancy);
+                break;
+            case PieceType::PAWN:
+                attacks |= get_pawn_attacks(square, color);
+                break;
+            }
+        });
+    return attacks;
+}
+
+void expect_matches_squares_under_attack(PositionState& position)
+{
+    auto& board = position.get_board();
+    for (const auto color : {PieceColor::WHITE, PieceColor::BLACK})
+    {
+        const auto squares_under_attack = generate_squares_under_attack(board, color);
+        const auto own_pieces = board.get_pieces(color);
+        EXPECT_EQ(get_attacked_squares(board, color),
+                  get_attacked_squares_piece_by_piece(board, color));
+        EXPECT_EQ(get_attacked_squares(board, color), get_attacked_squares_scalar(board, color));
+        for (std::uint8_t index = 0; index != SQUARE_COUNT; ++index)
+        {
+            const Square square{index};
+            if (own_pieces.contains(square))
+            {
+                continue;
+            }
+            EXPECT_EQ(is_square_attacked(board, square, color),
+                      squares_under_attack.contains(square))
+                << to_string(square.to_position()) << " by " << to_c_str(color);
+        }
+    }
+}
+
+}  // namespace
+
+TEST(Attacks, leaper_masks)
+{
+    EXPECT_EQ(get_knight_attacks(Square{Position{0, 0}}), (SquareSet{{1, 2}, {2, 1}}));
+    EXPECT_EQ(get_king_attacks(Square{Position{7, 7}}), (SquareSet{{6, 7}, {6, 6}, {7, 6}}));
+    EXPECT_EQ(get_pawn_attacks(Square{Position{0, 1}}, PieceColor::WHITE), (SquareSet{{1, 2}}));
+    EXPECT_EQ(get_pawn_attacks(Square{Position{4, 6}}, PieceColor::BLACK),
+              (SquareSet{{3, 5}, {5, 5}}));
+}
+
+TEST(Attacks, sliders_stop_at_first_blocker)
+{
+    const SquareSet occupancy{{3, 3}, {3, 5}, {5, 3}, {1, 1}};
+    EXPECT_EQ(get_rook_attacks(Square{Position{3, 3}}, occupancy),
+              (SquareSet{{3, 4}, {3, 5}, {4, 3}, {5, 3}, {2, 3}, {1, 3}, {0, 3}, {3, 2}, {3, 1},
+                         {3, 0}}));
+    EXPECT_EQ(get_bishop_attacks(Square{Position{3, 3}}, occupancy).size(), 12u);
+}
+
+TEST(Attacks, attackers_to)
+{
+    auto position = PositionState::from_fen("4k3/8/8/3r4/8/1N3n2/4P3/R3K3 w Q - 0 1");
+    const auto& board = position.get_board();
+    const Square d4{Position{3, 3}};
+    EXPECT_EQ(attackers_to(board, d4, board.get_occupied_squares()),
+              (SquareSet{{1, 2}, {5, 2}, {3, 4}}));
+    // attackers of both colors are returned
+    EXPECT_EQ(attackers_to(board, Square{Position{4, 0}}, board.get_occupied_squares()),
+              (SquareSet{{0, 0}, {5, 2}}));
+}
+
+TEST(Attacks, matches_squares_under_attack)
+{
+    const std::vector<std::string_view> fens
+        = {"rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1",
+           "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1",
+           "8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8 w - - 0 1",
+           "r4rk1/1pp1qppp/p1np1n2/2b1p1B1/2B1P1b1/P1NP1N2/1PP1QPPP/R4RK1 w - - 0 10"};
+    for (const auto fen : fens)
+    {
+        auto position = PositionState::from_fen(fen);
+        expect_matches_squares_under_attack(position);
+        std::vector<Move> moves;
+        position.generate_legal_moves(moves);
+        for (const auto& move : moves)
+        {
+            const auto undo_info = position.make_move(move);
+            expect_matches_squares_under_attack(position);
+            position.unmake_move(move, undo_info);
+        }
+    }
+}
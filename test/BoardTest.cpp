@@ -12,3 +12,59 @@ TEST(Board, clone)
     EXPECT_EQ(piece.get_type(), PieceType::ROOK);
     EXPECT_EQ(piece.get_color(), PieceColor::WHITE);
 }
+
+TEST(Board, piece_codes_follow_pieces)
+{
+    Board board;
+    board.add_piece(std::make_unique<Knight>(PieceColor::BLACK, Position{6, 7}));
+    board.add_piece(std::make_unique<King>(PieceColor::WHITE, Position{4, 0}));
+    EXPECT_EQ(board.get_piece_code({6, 7}), PieceCode(PieceType::KNIGHT, PieceColor::BLACK));
+    EXPECT_EQ(board.get_piece_code({6, 7}).get_type(), PieceType::KNIGHT);
+    EXPECT_EQ(board.get_piece_code({6, 7}).get_color(), PieceColor::BLACK);
+    EXPECT_TRUE(board.get_piece_code({8, 0}).is_empty());
+
+    std::size_t piece_count = 0;
+    board.for_each_piece([&piece_count](PieceCode piece_code, const Position& position) {
+        EXPECT_FALSE(piece_code.is_empty());
+        ++piece_count;
+    });
+    EXPECT_EQ(piece_count, 2u);
+
+    board.remove_piece({6, 7});
+    EXPECT_TRUE(board.get_piece_code({6, 7}).is_empty());
+}
+
+TEST(Board, copies_are_independent)
+{
+    Board original_board;
+    original_board.add_piece(PieceCode{PieceType::QUEEN, PieceColor::BLACK}, {3, 7});
+    auto copied_board = original_board;
+    copied_board.remove_piece_code({3, 7});
+    copied_board.add_piece(PieceCode{PieceType::PAWN, PieceColor::WHITE}, {4, 3});
+    EXPECT_EQ(original_board.get_piece_code({3, 7}),
+              PieceCode(PieceType::QUEEN, PieceColor::BLACK));
+    EXPECT_TRUE(original_board.is_square_empty({4, 3}));
+    EXPECT_TRUE(copied_board.is_square_empty({3, 7}));
+    EXPECT_THROW(copied_board.get_piece_at_position({3, 7}), std::logic_error);
+}
+
+TEST(Board, piece_masks_follow_add_and_remove)
+{
+    Board board;
+    EXPECT_FALSE(board.get_king_position(PieceColor::WHITE));
+    board.add_piece(PieceCode{PieceType::KING, PieceColor::WHITE}, {4, 0});
+    board.add_piece(PieceCode{PieceType::ROOK, PieceColor::WHITE}, {0, 0});
+    board.add_piece(PieceCode{PieceType::ROOK, PieceColor::BLACK}, {7, 7});
+    board.add_piece(PieceCode{PieceType::ROOK, PieceColor::WHITE}, {7, 0});
+    EXPECT_EQ(board.get_king_position(PieceColor::WHITE), (Position{4, 0}));
+    EXPECT_EQ(board.get_pieces(PieceColor::WHITE, PieceType::ROOK), (SquareSet{{0, 0}, {7, 0}}));
+    EXPECT_EQ(board.get_pieces(PieceColor::BLACK), (SquareSet{{7, 7}}));
+    EXPECT_EQ(board.get_occupied_squares().size(), 4u);
+
+    board.add_piece(board.remove_piece_code({4, 0}), {5, 1});
+    board.remove_piece_code({7, 7});
+    EXPECT_EQ(board.get_king_position(PieceColor::WHITE), (Position{5, 1}));
+    EXPECT_TRUE(board.get_pieces(PieceColor::BLACK).empty());
+    board.clear_board();
+    EXPECT_TRUE(board.get_occupied_squares().empty());
+}
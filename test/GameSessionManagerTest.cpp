@@ -0,0 +1,162 @@
+#include <gtest/gtest.h>
+
+#include <GameSessionManager.hpp>
+#include <thread>
+
+namespace
+{
+MoveStatus play(GameSessionManager& manager, SessionId id, std::string_view from_to)
+{
+    const Position from{from_to[0] - 'a', from_to[1] - '1'};
+    const Position to{from_to[2] - 'a', from_to[3] - '1'};
+    return manager.make_move(id, from, to);
+}
+}  // namespace
+
+TEST(GameSessionManager, plays_until_checkmate)
+{
+    GameSessionManager manager{4};
+    const auto id = manager.create_session(PositionState::get_starting_position());
+    EXPECT_EQ(play(manager, id, "f2f3"), MoveStatus::ACCEPTED);
+    EXPECT_EQ(play(manager, id, "e7e5"), MoveStatus::ACCEPTED);
+    EXPECT_EQ(play(manager, id, "e2e5"), MoveStatus::ILLEGAL_MOVE);
+    EXPECT_EQ(play(manager, id, "e7e6"), MoveStatus::ILLEGAL_MOVE);
+    EXPECT_EQ(play(manager, id, "g2g4"), MoveStatus::ACCEPTED);
+    EXPECT_EQ(play(manager, id, "d8h4"), MoveStatus::ACCEPTED);
+    EXPECT_EQ(play(manager, id, "a2a3"), MoveStatus::GAME_OVER);
+
+    const auto snapshot = manager.get_snapshot(id);
+    ASSERT_TRUE(snapshot);
+    EXPECT_EQ(snapshot->result, GameResult::BLACK_WON);
+    EXPECT_EQ(snapshot->end_reason, GameEndReason::CHECKMATE);
+    EXPECT_EQ(snapshot->ply_count, 4u);
+    EXPECT_EQ(snapshot->halfmove_clock, 1u);
+    std::vector<Move> moves;
+    EXPECT_TRUE(manager.generate_legal_moves(id, moves));
+    EXPECT_TRUE(moves.empty());
+}
+
+TEST(GameSessionManager, detects_draws)
+{
+    GameSessionManager manager;
+    const auto repetition = manager.create_session(PositionState::get_starting_position());
+    for (std::size_t cycle = 0; cycle != 2; ++cycle)
+    {
+        EXPECT_EQ(manager.get_snapshot(repetition)->result, GameResult::UNKNOWN);
+        for (const auto move : {"g1f3", "g8f6", "f3g1", "f6g8"})
+        {
+            EXPECT_EQ(play(manager, repetition, move), MoveStatus::ACCEPTED);
+        }
+    }
+    EXPECT_EQ(manager.get_snapshot(repetition)->end_reason, GameEndReason::THREEFOLD_REPETITION);
+    EXPECT_EQ(manager.get_snapshot(repetition)->result, GameResult::DRAW);
+
+    const auto fifty_moves = manager.create_session(
+        PositionState::from_fen("4k3/8/8/8/8/8/8/R3K3 w - - 99 80"), {}, 99);
+    EXPECT_EQ(play(manager, fifty_moves, "a1a2"), MoveStatus::ACCEPTED);
+    EXPECT_EQ(manager.get_snapshot(fifty_moves)->end_reason, GameEndReason::FIFTY_MOVE_RULE);
+
+    const auto bare_kings = manager.create_session(
+        PositionState::from_fen("4k3/8/8/8/8/8/3r4/4K3 w - - 0 1"));
+    EXPECT_EQ(play(manager, bare_kings, "e1d2"), MoveStatus::ACCEPTED);
+    EXPECT_EQ(manager.get_snapshot(bare_kings)->end_reason,
+              GameEndReason::INSUFFICIENT_MATERIAL);
+
+    const auto stalemate = manager.create_session(
+        PositionState::from_fen("7k/5Q2/6K1/8/8/8/8/8 b - - 0 1"));
+    EXPECT_EQ(manager.get_snapshot(stalemate)->end_reason, GameEndReason::STALEMATE);
+}
+
+TEST(GameSessionManager, charges_clocks)
+{
+    GameSessionManager manager;
+    const auto id = manager.create_session(
+        PositionState::get_starting_position(),
+        {std::chrono::milliseconds{1000}, std::chrono::milliseconds{100}});
+    EXPECT_EQ(manager.make_move(id, {4, 1}, {4, 3}, std::nullopt, std::chrono::milliseconds{300}),
+              MoveStatus::ACCEPTED);
+    EXPECT_EQ(manager.make_move(id, {4, 6}, {4, 3}, std::nullopt, std::chrono::milliseconds{50}),
+              MoveStatus::ILLEGAL_MOVE);
+    auto snapshot = manager.get_snapshot(id);
+    EXPECT_EQ(snapshot->clocks.remaining_time[0], std::chrono::milliseconds{800});
+    EXPECT_EQ(snapshot->clocks.remaining_time[1], std::chrono::milliseconds{1000});
+
+    EXPECT_EQ(manager.make_move(id, {4, 6}, {4, 4}, std::nullopt, std::chrono::milliseconds{1000}),
+              MoveStatus::TIME_FORFEIT);
+    snapshot = manager.get_snapshot(id);
+    EXPECT_EQ(snapshot->result, GameResult::WHITE_WON);
+    EXPECT_EQ(snapshot->end_reason, GameEndReason::TIME_FORFEIT);
+    EXPECT_EQ(snapshot->ply_count, 1u);
+}
+
+TEST(GameSessionManager, flag_fall_is_draw_without_mating_material)
+{
+    GameSessionManager manager;
+    const TimeControl time_control{std::chrono::milliseconds{1000}, std::chrono::milliseconds{0}};
+    // black has a lone knight, white's rook would block its own king
+    const auto lone_knight = manager.create_session(
+        PositionState::from_fen("4k3/8/8/8/8/8/8/R3K2n w - - 0 1"), time_control);
+    EXPECT_EQ(manager.make_move(lone_knight, {0, 0}, {0, 1}, std::nullopt,
+                                std::chrono::milliseconds{1000}),
+              MoveStatus::TIME_FORFEIT);
+    auto snapshot = manager.get_snapshot(lone_knight);
+    EXPECT_EQ(snapshot->result, GameResult::BLACK_WON);
+    EXPECT_EQ(snapshot->end_reason, GameEndReason::TIME_FORFEIT);
+
+    const auto bare_king = manager.create_session(
+        PositionState::from_fen("4k3/8/8/8/8/8/8/R3K3 w - - 0 1"), time_control);
+    EXPECT_EQ(manager.make_move(bare_king, {0, 0}, {0, 1}, std::nullopt,
+                                std::chrono::milliseconds{1000}),
+              MoveStatus::TIME_FORFEIT);
+    snapshot = manager.get_snapshot(bare_king);
+    EXPECT_EQ(snapshot->result, GameResult::DRAW);
+    EXPECT_EQ(snapshot->end_reason, GameEndReason::TIMEOUT_VS_INSUFFICIENT_MATERIAL);
+}
+
+TEST(GameSessionManager, closed_session_ids_stay_invalid)
+{
+    GameSessionManager manager{1};
+    const auto first = manager.create_session(PositionState::get_starting_position());
+    EXPECT_TRUE(manager.close_session(first));
+    EXPECT_FALSE(manager.close_session(first));
+    const auto second = manager.create_session(PositionState::get_starting_position());
+    EXPECT_NE(first, second);
+    EXPECT_EQ(play(manager, first, "e2e4"), MoveStatus::UNKNOWN_SESSION);
+    EXPECT_FALSE(manager.get_snapshot(first));
+    EXPECT_EQ(play(manager, second, "e2e4"), MoveStatus::ACCEPTED);
+    EXPECT_EQ(manager.get_session_count(), 1u);
+}
+
+TEST(GameSessionManager, concurrent_games_are_independent)
+{
+    constexpr std::size_t THREAD_COUNT = 4;
+    constexpr std::size_t GAMES_PER_THREAD = 50;
+    GameSessionManager manager{8};
+    std::vector<std::thread> threads;
+    for (std::size_t thread_index = 0; thread_index != THREAD_COUNT; ++thread_index)
+    {
+        threads.emplace_back([&manager] {
+            std::vector<SessionId> ids;
+            for (std::size_t game = 0; game != GAMES_PER_THREAD; ++game)
+            {
+                ids.push_back(manager.create_session(PositionState::get_starting_position()));
+            }
+            for (const auto move : {"f2f3", "e7e5", "g2g4", "d8h4"})
+            {
+                for (const auto id : ids)
+                {
+                    EXPECT_EQ(play(manager, id, move), MoveStatus::ACCEPTED);
+                }
+            }
+            for (const auto id : ids)
+            {
+                EXPECT_EQ(manager.get_snapshot(id)->end_reason, GameEndReason::CHECKMATE);
+            }
+        });
+    }
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+    EXPECT_EQ(manager.get_session_count(), THREAD_COUNT * GAMES_PER_THREAD);
+}
@@ -0,0 +1,114 @@
+#include <gtest/gtest.h>
+
+#include <GameState.hpp>
+#include <Zobrist.hpp>
+
+namespace
+{
+void play_moves(GameState& game_state, const std::vector<std::pair<Position, Position>>& moves)
+{
+    for (const auto& [from, to] : moves)
+    {
+        game_state.make_move(game_state.get_position().create_move(from, to));
+    }
+}
+}  // namespace
+
+TEST(GameState, knight_shuffle_repeats_position)
+{
+    auto game_state = GameState::get_starting_position();
+    const std::vector<std::pair<Position, Position>> shuffle
+        = {{{6, 0}, {5, 2}}, {{6, 7}, {5, 5}}, {{5, 2}, {6, 0}}, {{5, 5}, {6, 7}}};
+    play_moves(game_state, shuffle);
+    EXPECT_EQ(game_state.count_repetitions(), 1u);
+    EXPECT_TRUE(game_state.is_repetition());
+    EXPECT_FALSE(game_state.is_threefold_repetition());
+    EXPECT_EQ(game_state.get_draw_reason(), DrawReason::NONE);
+
+    play_moves(game_state, shuffle);
+    EXPECT_TRUE(game_state.is_threefold_repetition());
+    EXPECT_EQ(game_state.get_draw_reason(), DrawReason::THREEFOLD_REPETITION);
+
+    game_state.unmake_move();
+    EXPECT_EQ(game_state.count_repetitions(), 1u);
+    EXPECT_EQ(game_state.get_halfmove_clock(), 7u);
+}
+
+TEST(GameState, pawn_move_cuts_repetition_history)
+{
+    auto game_state = GameState::get_starting_position();
+    play_moves(game_state, {{{6, 0}, {5, 2}}, {{6, 7}, {5, 5}}, {{5, 2}, {6, 0}}});
+    EXPECT_EQ(game_state.get_halfmove_clock(), 3u);
+    play_moves(game_state, {{{4, 6}, {4, 4}}});
+    EXPECT_EQ(game_state.get_halfmove_clock(), 0u);
+    play_moves(game_state, {{{6, 0}, {5, 2}}, {{5, 5}, {6, 7}}, {{5, 2}, {6, 0}}});
+    EXPECT_FALSE(game_state.is_repetition());
+}
+
+TEST(GameState, incremental_key_matches_full_key)
+{
+    auto game_state
+        = GameState::from_fen("r3k2r/1P3ppp/8/2pP4/8/8/5PPP/R3K2R w KQkq c6 0 20");
+    EXPECT_EQ(game_state.get_key(), get_zobrist_key(game_state.get_position()));
+    const std::vector<Move> moves
+        = {{{3, 4}, {2, 5}, MoveType::EN_PASSANT},
+           {{4, 7}, {6, 7}, MoveType::KING_SIDE_CASTLE},
+           {{1, 6}, {0, 7}, MoveType::NORMAL, PromotablePieceType::KNIGHT},
+           {{5, 7}, {0, 7}},
+           {{4, 0}, {2, 0}, MoveType::QUEEN_SIDE_CASTLE}};
+    for (const auto& move : moves)
+    {
+        game_state.make_move(move);
+        EXPECT_EQ(game_state.get_key(), get_zobrist_key(game_state.get_position()));
+    }
+    for (std::size_t ply = 0; ply != moves.size(); ++ply)
+    {
+        game_state.unmake_move();
+        EXPECT_EQ(game_state.get_key(), get_zobrist_key(game_state.get_position()));
+    }
+    EXPECT_THROW(game_state.unmake_move(), std::logic_error);
+}
+
+TEST(GameState, fifty_move_rule)
+{
+    auto game_state = GameState::from_fen("4k3/8/8/8/8/8/4P3/R3K3 w - - 99 80");
+    EXPECT_EQ(game_state.get_halfmove_clock(), 99u);
+    EXPECT_FALSE(game_state.is_fifty_move_rule_draw());
+    play_moves(game_state, {{{0, 0}, {0, 1}}});
+    EXPECT_EQ(game_state.get_draw_reason(), DrawReason::FIFTY_MOVE_RULE);
+    EXPECT_THROW(GameState::from_fen("4k3/8/8/8/8/8/8/4K3 w - - x 1"), std::invalid_argument);
+}
+
+TEST(GameState, insufficient_material)
+{
+    EXPECT_TRUE(GameState::from_fen("4k3/8/8/8/8/8/8/4K3 w - -").is_insufficient_material());
+    EXPECT_TRUE(GameState::from_fen("4k3/8/8/8/8/8/8/4KN2 w - -").is_insufficient_material());
+    EXPECT_TRUE(GameState::from_fen("2b1k3/8/8/8/8/8/8/4KB2 w - -").is_insufficient_material());
+    EXPECT_FALSE(GameState::from_fen("1b2k3/8/8/8/8/8/8/4KB2 w - -").is_insufficient_material());
+    EXPECT_FALSE(GameState::from_fen("4k3/8/8/8/8/8/8/3NKN2 w - -").is_insufficient_material());
+    EXPECT_FALSE(GameState::from_fen("4k3/8/8/8/8/8/4P3/4K3 w - -").is_insufficient_material());
+
+    auto game_state = GameState::from_fen("4k3/8/8/8/8/8/3r4/4K3 w - - 0 1");
+    EXPECT_FALSE(game_state.is_insufficient_material());
+    play_moves(game_state, {{{4, 0}, {3, 1}}});
+    EXPECT_EQ(game_state.get_draw_reason(), DrawReason::INSUFFICIENT_MATERIAL);
+    game_state.unmake_move();
+    EXPECT_FALSE(game_state.is_insufficient_material());
+}
+
+TEST(GameState, can_checkmate)
+{
+    const auto can_checkmate_in = [](const char* fen, PieceColor color) {
+        return can_checkmate(PositionState::from_fen(fen).get_board(), color);
+    };
+    EXPECT_FALSE(can_checkmate_in("4k3/8/8/8/8/8/8/4K3 w - -", PieceColor::WHITE));
+    EXPECT_FALSE(can_checkmate_in("4k3/8/8/8/8/8/8/4KN2 w - -", PieceColor::WHITE));
+    EXPECT_FALSE(can_checkmate_in("3qk3/8/8/8/8/8/8/4KN2 w - -", PieceColor::WHITE));
+    EXPECT_TRUE(can_checkmate_in("3qk3/8/8/8/8/8/8/4KN2 w - -", PieceColor::BLACK));
+    EXPECT_TRUE(can_checkmate_in("3rk3/8/8/8/8/8/8/4KN2 w - -", PieceColor::WHITE));
+    EXPECT_FALSE(can_checkmate_in("2b1k3/8/8/8/8/8/8/4KB2 w - -", PieceColor::WHITE));
+    EXPECT_TRUE(can_checkmate_in("1b2k3/8/8/8/8/8/8/4KB2 w - -", PieceColor::WHITE));
+    EXPECT_TRUE(can_checkmate_in("4k1n1/8/8/8/8/8/8/4KB2 w - -", PieceColor::WHITE));
+    EXPECT_TRUE(can_checkmate_in("4k3/8/8/8/8/8/8/3BKN2 w - -", PieceColor::WHITE));
+    EXPECT_TRUE(can_checkmate_in("4k3/8/8/8/8/8/4P3/4K3 w - -", PieceColor::WHITE));
+}
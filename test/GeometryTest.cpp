@@ -0,0 +1,46 @@
+#include <gtest/gtest.h>
+
+#include <Geometry.hpp>
+
+namespace
+{
+Square square(std::int32_t x, std::int32_t y)
+{
+    return Square{Position{x, y}};
+}
+}  // namespace
+
+TEST(Geometry, between_squares)
+{
+    EXPECT_EQ(get_between_squares(square(4, 0), square(0, 0)), (SquareSet{{1, 0}, {2, 0}, {3, 0}}));
+    EXPECT_EQ(get_between_squares(square(0, 0), square(3, 3)), (SquareSet{{1, 1}, {2, 2}}));
+    EXPECT_EQ(get_between_squares(square(2, 7), square(2, 1)),
+              get_between_squares(square(2, 1), square(2, 7)));
+    EXPECT_TRUE(get_between_squares(square(0, 0), square(1, 1)).empty());
+    EXPECT_TRUE(get_between_squares(square(0, 0), square(1, 2)).empty());
+}
+
+TEST(Geometry, lines)
+{
+    EXPECT_EQ(get_line(square(3, 4), square(6, 1)).size(), 8u);
+    EXPECT_TRUE(get_line(square(3, 4), square(6, 1)).contains(square(7, 0)));
+    EXPECT_EQ(get_line(square(1, 5), square(1, 0)), get_line(square(1, 2), square(1, 7)));
+    EXPECT_TRUE(get_line(square(0, 0), square(2, 1)).empty());
+}
+
+TEST(Geometry, rays)
+{
+    EXPECT_EQ(get_ray(Direction::SOUTH_WEST, square(2, 2)), (SquareSet{{1, 1}, {0, 0}}));
+    EXPECT_EQ(get_ray(Direction::NORTH, square(5, 7)), SquareSet{});
+    for (std::uint8_t index = 0; index != SQUARE_COUNT; ++index)
+    {
+        SquareSet all_rays;
+        for (std::size_t direction = 0; direction != DIRECTION_COUNT; ++direction)
+        {
+            all_rays |= get_ray(static_cast<Direction>(direction), Square{index});
+        }
+        // every king step starts a ray
+        EXPECT_EQ((all_rays & SquareSet{KING_ATTACK_MASKS[index]}),
+                  SquareSet{KING_ATTACK_MASKS[index]});
+    }
+}
@@ -0,0 +1,88 @@
+#include <gtest/gtest.h>
+
+#include <Instrumentation.hpp>
+#include <PositionState.hpp>
+#include <cstdint>
+#include <memory>
+
+TEST(Instrumentation, counts_move_generation)
+{
+    auto position = PositionState::get_starting_position();
+    reset_thread_instrumentation_stats();
+    position.generate_available_moves();
+    const auto stats = get_thread_instrumentation_stats();
+    const auto raw_moves = stats.counters[static_cast<std::size_t>(Counter::RAW_MOVES)];
+    const auto generate_calls
+        = stats.phase_calls[static_cast<std::size_t>(Phase::GENERATE_MOVES)];
+    if (!is_instrumentation_enabled())
+    {
+        EXPECT_EQ(raw_moves, 0u);
+        EXPECT_EQ(generate_calls, 0u);
+        return;
+    }
+    EXPECT_EQ(raw_moves, 20u);
+    EXPECT_EQ(stats.counters[static_cast<std::size_t>(Counter::LEGALITY_CHECKS)], 20u);
+    EXPECT_EQ(generate_calls, 1u);
+    EXPECT_EQ(stats.phase_calls[static_cast<std::size_t>(Phase::NORMAL_MOVES)], 1u);
+}
+
+TEST(Instrumentation, counts_allocations)
+{
+    std::vector<Move> moves;
+    auto position = PositionState::get_starting_position();
+    reset_thread_instrumentation_stats();
+    position.generate_legal_moves(moves);
+    const auto& stats = get_thread_instrumentation_stats();
+    if (!is_instrumentation_enabled())
+    {
+        EXPECT_EQ(stats.allocations, 0u);
+        return;
+    }
+    EXPECT_GT(stats.allocations, 0u);
+    EXPECT_GE(stats.allocated_bytes, moves.size() * sizeof(Move));
+}
+
+TEST(Instrumentation, counts_over_aligned_allocations)
+{
+    struct alignas(64) CacheLine
+    {
+        std::array<char, 64> bytes;
+    };
+    reset_thread_instrumentation_stats();
+    const auto cache_lines = std::make_unique<CacheLine[]>(3);
+    const auto& stats = get_thread_instrumentation_stats();
+    EXPECT_EQ(reinterpret_cast<std::uintptr_t>(cache_lines.get()) % 64, 0u);
+    if (!is_instrumentation_enabled())
+    {
+        EXPECT_EQ(stats.allocations, 0u);
+        return;
+    }
+    EXPECT_EQ(stats.allocations, 1u);
+    EXPECT_GE(stats.allocated_bytes, 3 * sizeof(CacheLine));
+}
+
+TEST(Instrumentation, reset_clears_stats)
+{
+    auto position = PositionState::get_starting_position();
+    position.generate_available_moves();
+    reset_thread_instrumentation_stats();
+    const auto& stats = get_thread_instrumentation_stats();
+    EXPECT_EQ(stats.counters[static_cast<std::size_t>(Counter::RAW_MOVES)], 0u);
+    EXPECT_EQ(stats.allocations, 0u);
+}
+
+TEST(Instrumentation, json_lists_every_counter_and_phase)
+{
+    InstrumentationStats stats;
+    stats.counters[static_cast<std::size_t>(Counter::BOARD_COPIES)] = 7;
+    stats.phase_calls[static_cast<std::size_t>(Phase::ATTACK_SETS)] = 2;
+    stats.phase_cycles[static_cast<std::size_t>(Phase::ATTACK_SETS)] = 5;
+    const auto json = to_json(stats);
+    EXPECT_NE(json.find("\"board_copies\":7"), std::string::npos);
+    EXPECT_NE(json.find("\"attack_sets\":{\"calls\":2,\"cycles\":5,\"allocations\":0,"
+                        "\"cycles_per_call\":2.50"),
+              std::string::npos);
+    EXPECT_NE(json.find("\"raw_moves\":0"), std::string::npos);
+    EXPECT_EQ(json.front(), '{');
+    EXPECT_EQ(json.back(), '}');
+}
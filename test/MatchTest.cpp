@@ -0,0 +1,120 @@
+#include <gtest/gtest.h>
+
+#include <Match.hpp>
+#include <cmath>
+#include <sstream>
+
+TEST(Match, plays_game_to_the_end)
+{
+    const std::atomic<bool> stop_requested{false};
+    SearchLimits limits;
+    limits.max_depth = 2;
+    const auto mate = play_game(GameState::from_fen("6k1/5ppp/8/8/8/8/8/R5K1 w - - 0 1"), limits,
+                                limits, 10, stop_requested);
+    EXPECT_EQ(mate.result, GameResult::WHITE_WON);
+    EXPECT_EQ(mate.end_reason, GameEndReason::CHECKMATE);
+    EXPECT_EQ(mate.ply_count, 1u);
+
+    const auto adjudicated = play_game(GameState::get_starting_position(), limits, limits, 6,
+                                       stop_requested);
+    EXPECT_EQ(adjudicated.result, GameResult::DRAW);
+    EXPECT_EQ(adjudicated.end_reason, GameEndReason::MOVE_LIMIT);
+    EXPECT_EQ(adjudicated.ply_count, 6u);
+}
+
+TEST(Match, elo_and_sprt_statistics)
+{
+    const MatchScore even{10, 20, 10};
+    EXPECT_DOUBLE_EQ(estimate_elo(even).elo, 0.0);
+    EXPECT_GT(estimate_elo(even).error_margin, 0.0);
+    EXPECT_NEAR(estimate_elo({75, 0, 25}).elo, 190.8, 0.1);
+    EXPECT_TRUE(std::isinf(estimate_elo({5, 0, 0}).elo));
+    EXPECT_TRUE(std::isinf(estimate_elo({5, 0, 0}).error_margin));
+
+    const SprtParameters parameters{0.0, 10.0, 0.05, 0.05};
+    EXPECT_NEAR(get_sprt_lower_bound(parameters), -2.944, 0.001);
+    EXPECT_NEAR(get_sprt_upper_bound(parameters), 2.944, 0.001);
+    EXPECT_EQ(get_sprt_decision({}, parameters), SprtDecision::CONTINUE);
+    EXPECT_EQ(get_sprt_decision({600, 400, 400}, parameters), SprtDecision::ACCEPT_H1);
+    EXPECT_EQ(get_sprt_decision({400, 400, 600}, parameters), SprtDecision::ACCEPT_H0);
+    EXPECT_LT(get_sprt_llr({1000, 1000, 1000}, parameters), 0.0);
+    EXPECT_EQ(get_sprt_decision({100, 0, 0}, parameters), SprtDecision::ACCEPT_H1);
+}
+
+TEST(Match, stronger_engine_wins_and_callback_stops_match)
+{
+    MatchConfig config;
+    config.first.limits.max_depth = 2;
+    // a single node leaves no time to look at the opponent's replies
+    config.second.limits.max_nodes = 1;
+    config.game_count = 8;
+    config.thread_count = 2;
+    config.max_plies = 200;
+    const std::vector<std::string> openings = {
+        "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1",
+        "r1bqkbnr/pppp1ppp/2n5/4p3/4P3/5N2/PPPP1PPP/RNBQKB1R w KQkq - 2 3"};
+    std::vector<std::size_t> game_indices;
+    const auto score = run_match(openings, config, [&](const MatchGame& game, const MatchScore&) {
+        game_indices.push_back(game.game_index);
+        return true;
+    });
+    EXPECT_EQ(score.get_game_count(), 8u);
+    EXPECT_EQ(game_indices.size(), 8u);
+    EXPECT_GT(score.wins, score.losses);
+
+    config.thread_count = 1;
+    const auto stopped = run_match(openings, config,
+                                   [](const MatchGame&, const MatchScore&) { return false; });
+    EXPECT_EQ(stopped.get_game_count(), 1u);
+    EXPECT_THROW(run_match({}, config), std::invalid_argument);
+}
+
+TEST(Match, random_plies_give_pairs_distinct_start_positions)
+{
+    MatchConfig config;
+    config.first.limits.max_depth = 1;
+    config.second.limits.max_depth = 1;
+    config.game_count = 8;
+    config.max_plies = 4;
+    config.random_plies = 6;
+    const std::vector<std::string> openings = {
+        "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1"};
+    const auto get_start_keys = [&openings](const MatchConfig& match_config) {
+        std::vector<std::uint64_t> start_keys(match_config.game_count);
+        run_match(openings, match_config, [&](const MatchGame& game, const MatchScore&) {
+            start_keys[game.game_index] = game.start_key;
+            return true;
+        });
+        return start_keys;
+    };
+
+    const auto start_keys = get_start_keys(config);
+    for (std::size_t pair_index = 0; pair_index != 4; ++pair_index)
+    {
+        EXPECT_EQ(start_keys[2 * pair_index], start_keys[2 * pair_index + 1]);
+        for (std::size_t other_index = 0; other_index != pair_index; ++other_index)
+        {
+            EXPECT_NE(start_keys[2 * pair_index], start_keys[2 * other_index]);
+        }
+    }
+    config.thread_count = 3;
+    EXPECT_EQ(get_start_keys(config), start_keys);
+    config.seed = 1;
+    EXPECT_NE(get_start_keys(config), start_keys);
+}
+
+TEST(Match, reads_fen_and_epd_openings)
+{
+    std::istringstream input{
+        "# openings\n"
+        "\n"
+        "rnbqkbnr/pppppppp/8/8/4P3/8/PPPP1PPP/RNBQKBNR b KQkq e3 0 1\n"
+        "rnbqkbnr/pppppppp/8/8/3P4/8/PPP1PPPP/RNBQKBNR b KQkq - bm d5; id \"d4\";\n"};
+    const auto openings = read_openings(input);
+    ASSERT_EQ(openings.size(), 2u);
+    EXPECT_EQ(openings[0], "rnbqkbnr/pppppppp/8/8/4P3/8/PPPP1PPP/RNBQKBNR b KQkq e3 0 1");
+    EXPECT_EQ(openings[1], "rnbqkbnr/pppppppp/8/8/3P4/8/PPP1PPPP/RNBQKBNR b KQkq - 0 1");
+
+    std::istringstream broken{"8/8/8 w\n"};
+    EXPECT_THROW(read_openings(broken), std::invalid_argument);
+}
@@ -0,0 +1,75 @@
+#include <gtest/gtest.h>
+
+#include <MoveBatch.hpp>
+
+namespace
+{
+std::vector<PositionState> generate_game_positions(std::size_t position_count)
+{
+    std::vector<PositionState> positions;
+    auto position = PositionState::get_starting_position();
+    std::vector<Move> moves;
+    while (positions.size() != position_count)
+    {
+        position.generate_legal_moves(moves);
+        if (moves.empty())
+        {
+            position = PositionState::get_starting_position();
+            continue;
+        }
+        positions.push_back(position);
+        position.make_move(moves[(positions.size() * 7) % moves.size()]);
+    }
+    return positions;
+}
+
+void expect_batch_matches_positions(const MoveBatch& batch, std::vector<PositionState> positions)
+{
+    ASSERT_EQ(batch.get_position_count(), positions.size());
+    std::vector<Move> moves;
+    for (std::size_t position_index = 0; position_index != positions.size(); ++position_index)
+    {
+        positions[position_index].generate_legal_moves(moves);
+        EXPECT_EQ(std::vector<Move>(batch.get_moves_begin(position_index),
+                                    batch.get_moves_end(position_index)),
+                  moves);
+    }
+}
+}  // namespace
+
+TEST(MoveBatch, matches_moves_generated_one_by_one)
+{
+    const auto positions = generate_game_positions(150);
+    MoveBatch batch;
+    generate_available_moves_batch(positions.data(), positions.size(), batch);
+    expect_batch_matches_positions(batch, positions);
+
+    generate_available_moves_batch(positions.data(), 3, batch);
+    EXPECT_EQ(batch.get_position_count(), 3u);
+    EXPECT_EQ(batch.get_offset(0), 0u);
+    EXPECT_EQ(batch.get_move_count(0), 20u);
+}
+
+TEST(MoveBatch, threads_keep_position_order)
+{
+    const auto positions = generate_game_positions(4 * MIN_BATCH_POSITIONS_PER_THREAD + 5);
+    MoveBatchGenerator generator{4};
+    MoveBatch batch;
+    generator.generate(positions.data(), positions.size(), batch);
+    expect_batch_matches_positions(batch, positions);
+    EXPECT_EQ(batch.get_offset(batch.get_position_count()), batch.get_moves().size());
+}
+
+TEST(MoveBatch, generator_is_reused_across_batch_sizes)
+{
+    const auto positions = generate_game_positions(4 * MIN_BATCH_POSITIONS_PER_THREAD + 5);
+    MoveBatchGenerator generator{4};
+    MoveBatch batch;
+    for (const auto position_count : {positions.size(), std::size_t{3}, std::size_t{0},
+                                      2 * MIN_BATCH_POSITIONS_PER_THREAD, positions.size()})
+    {
+        generator.generate(positions.data(), position_count, batch);
+        expect_batch_matches_positions(
+            batch, {positions.begin(), positions.begin() + position_count});
+    }
+}
@@ -10,7 +10,7 @@ TEST(SquaresUnderAttackGenerator, pawn)
     chess_board.add_piece(std::make_unique<Pawn>(PieceColor::BLACK, Position{3, 4}));
     chess_board.add_piece(std::make_unique<Pawn>(PieceColor::WHITE, Position{4, 4}));
     const auto squares_under_attack = generate_squares_under_attack(chess_board, PieceColor::WHITE);
-    const std::unordered_set<Position> expected_squares_under_attack = {{3, 5}, {2, 4}, {5, 5}};
+    const SquareSet expected_squares_under_attack = {{3, 5}, {2, 4}, {5, 5}};
     EXPECT_EQ(squares_under_attack, expected_squares_under_attack);
 }
 
@@ -23,7 +23,7 @@ TEST(SquaresUnderAttackGenerator, encircled_in_opposite_color_pieces_rook)
     chess_board.add_piece(std::make_unique<Rook>(PieceColor::WHITE, Position{3, 5}));
     chess_board.add_piece(std::make_unique<Rook>(PieceColor::WHITE, Position{3, 3}));
     const auto squares_under_attack = generate_squares_under_attack(chess_board, PieceColor::BLACK);
-    const std::unordered_set<Position> expected_squares_under_attack
+    const SquareSet expected_squares_under_attack
         = {{3, 5}, {2, 4}, {3, 3}, {4, 4}};
 
     EXPECT_EQ(squares_under_attack, expected_squares_under_attack);
@@ -39,10 +39,10 @@ TEST(MoveGenerator, encircled_in_opposite_color_pieces_rook)
     chess_board.add_piece(std::make_unique<Rook>(PieceColor::WHITE, Position{3, 3}));
     chess_board.add_piece(std::make_unique<King>(PieceColor::BLACK, Position{7, 7}));
     const auto available_moves = generate_available_moves(
-        chess_board, {{7, 7}, true, std::nullopt, std::nullopt, std::nullopt}, PieceColor::BLACK);
+        chess_board, {true, std::nullopt, std::nullopt, std::nullopt}, PieceColor::BLACK);
     const NormalMoves expected_available_normal_moves
-        = {{Position{3, 4}, std::unordered_set<Position>{{4, 4}, {3, 3}, {2, 4}, {3, 5}}},
-           {Position{7, 7}, std::unordered_set<Position>{{6, 6}, {6, 7}, {7, 6}}}};
+        = {{Position{3, 4}, SquareSet{{4, 4}, {3, 3}, {2, 4}, {3, 5}}},
+           {Position{7, 7}, SquareSet{{6, 6}, {6, 7}, {7, 6}}}};
     EXPECT_EQ(available_moves.normal_moves, expected_available_normal_moves);
 }
 
@@ -53,12 +53,12 @@ TEST(MoveGenerator, en_passant)
     chess_board.add_piece(std::make_unique<Pawn>(PieceColor::WHITE, Position{4, 4}));
     chess_board.add_piece(std::make_unique<King>(PieceColor::WHITE, Position{7, 0}));
     const auto available_moves = generate_available_moves(
-        chess_board, {{7, 0}, true, std::make_optional<Position>(3, 5), std::nullopt, std::nullopt},
+        chess_board, {true, std::make_optional<Position>(3, 5), std::nullopt, std::nullopt},
         PieceColor::WHITE);
 
     const NormalMoves expected_available_moves
-        = {{Position{4, 4}, std::unordered_set<Position>{{3, 5}, {4, 5}}},
-           {Position{7, 0}, std::unordered_set<Position>{{6, 0}, {6, 1}, {7, 1}}}};
+        = {{Position{4, 4}, SquareSet{{3, 5}, {4, 5}}},
+           {Position{7, 0}, SquareSet{{6, 0}, {6, 1}, {7, 1}}}};
     EXPECT_EQ(available_moves.normal_moves, expected_available_moves);
 }
 
@@ -70,7 +70,7 @@ TEST(MoveGenerator, king_side_castling_possible)
     chess_board.add_piece(std::make_unique<Rook>(PieceColor::BLACK, Position{7, 1}));
     const auto available_moves = generate_available_moves(
         chess_board,
-        {{4, 0}, false, std::nullopt, std::nullopt, std::make_optional<Position>(7, 0)},
+        {false, std::nullopt, std::nullopt, std::make_optional<Position>(7, 0)},
         PieceColor::WHITE);
 
     EXPECT_TRUE(available_moves.king_side_castle_possible);
@@ -84,11 +84,11 @@ TEST(MoveGenerator, king_side_castling_impossible)
     chess_board.add_piece(std::make_unique<Rook>(PieceColor::BLACK, Position{4, 1}));
     const auto available_moves = generate_available_moves(
         chess_board,
-        {{4, 0}, false, std::nullopt, std::nullopt, std::make_optional<Position>(7, 0)},
+        {false, std::nullopt, std::nullopt, std::make_optional<Position>(7, 0)},
         PieceColor::WHITE);
 
     const NormalMoves expected_available_moves
-        = {{Position{4, 0}, std::unordered_set<Position>{{4, 1}, {3, 0}, {5, 0}}}};
+        = {{Position{4, 0}, SquareSet{{4, 1}, {3, 0}, {5, 0}}}};
     EXPECT_FALSE(available_moves.king_side_castle_possible);
     EXPECT_EQ(available_moves.normal_moves, expected_available_moves);
 }
@@ -101,7 +101,7 @@ TEST(MoveGenerator, queen_side_castling_possible)
     chess_board.add_piece(std::make_unique<Rook>(PieceColor::BLACK, Position{1, 1}));
     const auto available_moves = generate_available_moves(
         chess_board,
-        {{4, 0}, false, std::nullopt, std::make_optional<Position>(0, 0), std::nullopt},
+        {false, std::nullopt, std::make_optional<Position>(0, 0), std::nullopt},
         PieceColor::WHITE);
 
     EXPECT_TRUE(available_moves.queen_side_castle_possible);
@@ -114,9 +114,61 @@ TEST(MoveGenerator, king_under_check_piece_is_defended)
     chess_board.add_piece(std::make_unique<Rook>(PieceColor::BLACK, Position{4, 1}));
     chess_board.add_piece(std::make_unique<Rook>(PieceColor::BLACK, Position{4, 2}));
     const auto available_moves = generate_available_moves(
-        chess_board, {{4, 0}, false, std::nullopt, std::nullopt, std::nullopt}, PieceColor::WHITE);
+        chess_board, {false, std::nullopt, std::nullopt, std::nullopt}, PieceColor::WHITE);
 
     const NormalMoves expected_available_moves
-        = {{Position{4, 0}, std::unordered_set<Position>{{3, 0}, {5, 0}}}};
+        = {{Position{4, 0}, SquareSet{{3, 0}, {5, 0}}}};
     EXPECT_EQ(available_moves.normal_moves, expected_available_moves);
-}
\ No newline at end of file
+}
+TEST(MoveGenerator, pawn_double_push_from_starting_rank)
+{
+    Board chess_board;
+    chess_board.add_piece(std::make_unique<King>(PieceColor::WHITE, Position{7, 0}));
+    chess_board.add_piece(std::make_unique<Pawn>(PieceColor::WHITE, Position{3, 1}));
+    chess_board.add_piece(std::make_unique<Pawn>(PieceColor::WHITE, Position{4, 1}));
+    chess_board.add_piece(std::make_unique<Pawn>(PieceColor::BLACK, Position{4, 3}));
+    const auto available_moves = generate_available_moves(
+        chess_board, {true, std::nullopt, std::nullopt, std::nullopt}, PieceColor::WHITE);
+
+    EXPECT_EQ(available_moves.normal_moves.at({3, 1}),
+              (SquareSet{{3, 2}, {3, 3}}));
+    EXPECT_EQ(available_moves.normal_moves.at({4, 1}), (SquareSet{{4, 2}}));
+}
+
+TEST(SpecialMovesData, validate_reports_first_inconsistency)
+{
+    Board chess_board;
+    EXPECT_EQ(SpecialMovesData{}.validate(chess_board, PieceColor::WHITE),
+              SpecialMovesError::KING_MISSING);
+
+    chess_board.add_piece(std::make_unique<King>(PieceColor::WHITE, Position{4, 1}));
+    EXPECT_EQ(SpecialMovesData{}.validate(chess_board, PieceColor::WHITE),
+              SpecialMovesError::KING_MISPLACED);
+    EXPECT_EQ(SpecialMovesData{true}.validate(chess_board, PieceColor::WHITE),
+              SpecialMovesError::NONE);
+
+    chess_board.add_piece(std::make_unique<Pawn>(PieceColor::BLACK, Position{3, 4}));
+    EXPECT_EQ((SpecialMovesData{true, Position{3, 4}}.validate(chess_board, PieceColor::WHITE)),
+              SpecialMovesError::EN_PASSANT_SQUARE_INVALID);
+    EXPECT_EQ((SpecialMovesData{true, Position{2, 5}}.validate(chess_board, PieceColor::WHITE)),
+              SpecialMovesError::EN_PASSANT_PAWN_MISSING);
+    EXPECT_EQ((SpecialMovesData{true, Position{3, 5}}.validate(chess_board, PieceColor::WHITE)),
+              SpecialMovesError::NONE);
+
+    Board castling_board;
+    castling_board.add_piece(std::make_unique<King>(PieceColor::BLACK, Position{4, 7}));
+    castling_board.add_piece(std::make_unique<Rook>(PieceColor::BLACK, Position{7, 7}));
+    castling_board.add_piece(std::make_unique<Rook>(PieceColor::BLACK, Position{1, 7}));
+    const SpecialMovesData castling_data{false, std::nullopt, Position{0, 7}, Position{7, 7}};
+    EXPECT_EQ(castling_data.validate(castling_board, PieceColor::BLACK),
+              SpecialMovesError::ROOK_MISSING);
+    const SpecialMovesData misplaced_data{false, std::nullopt, Position{1, 7}, Position{7, 7}};
+    EXPECT_EQ(misplaced_data.validate(castling_board, PieceColor::BLACK),
+              SpecialMovesError::ROOK_MISPLACED);
+    EXPECT_EQ(misplaced_data.validate(castling_board, PieceColor::BLACK, true),
+              SpecialMovesError::NONE);
+    EXPECT_EQ((SpecialMovesData{false, std::nullopt, Position{9, 7}}.validate(
+                  castling_board, PieceColor::BLACK)),
+              SpecialMovesError::ROOK_MISSING);
+    EXPECT_FALSE(misplaced_data.is_ok(castling_board, PieceColor::BLACK));
+}
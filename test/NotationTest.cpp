@@ -0,0 +1,53 @@
+#include <gtest/gtest.h>
+
+#include <Notation.hpp>
+
+namespace
+{
+std::string get_san(PositionState& position, const Move& move)
+{
+    std::vector<Move> legal_moves;
+    position.generate_legal_moves(legal_moves);
+    std::vector<Move> next_legal_moves;
+    const auto undo_info = position.make_move(move);
+    position.generate_legal_moves(next_legal_moves);
+    const auto check_state = get_check_state(position, next_legal_moves);
+    position.unmake_move(move, undo_info);
+    return std::string{to_san(position, legal_moves, move, check_state).get_view()};
+}
+}  // namespace
+
+TEST(Notation, san_disambiguation)
+{
+    auto position = PositionState::from_fen("4k3/8/8/8/1N3N2/8/1N6/R3K2R w KQ - 0 1");
+    EXPECT_EQ(get_san(position, {{1, 3}, {3, 4}}), "Nbd5");
+    EXPECT_EQ(get_san(position, {{1, 1}, {3, 2}}), "N2d3");
+    EXPECT_EQ(get_san(position, {{1, 3}, {3, 2}}), "Nb4d3");
+    EXPECT_EQ(get_san(position, {{1, 1}, {0, 3}}), "Na4");
+    EXPECT_EQ(get_san(position, {{0, 0}, {3, 0}}), "Rd1");
+    EXPECT_EQ(get_san(position, {{4, 0}, {2, 0}, MoveType::QUEEN_SIDE_CASTLE}), "O-O-O");
+}
+
+TEST(Notation, san_captures_promotions_and_suffixes)
+{
+    auto position = PositionState::from_fen("3qk3/2P5/8/3pP3/8/8/8/4K2R w K d6 0 1");
+    EXPECT_EQ(get_san(position, {{4, 4}, {3, 5}, MoveType::EN_PASSANT}), "exd6");
+    EXPECT_EQ(get_san(position, {{2, 6}, {3, 7}, MoveType::NORMAL, PromotablePieceType::QUEEN}),
+              "cxd8=Q+");
+    EXPECT_EQ(get_san(position, {{2, 6}, {2, 7}, MoveType::NORMAL, PromotablePieceType::KNIGHT}),
+              "c8=N");
+    EXPECT_EQ(get_san(position, {{7, 0}, {7, 7}}), "Rh8+");
+
+    auto mate_position = PositionState::from_fen("6k1/5ppp/8/8/8/8/8/R3K3 w Q - 0 1");
+    EXPECT_EQ(get_san(mate_position, {{0, 0}, {0, 7}}), "Ra8#");
+}
+
+TEST(Notation, lan)
+{
+    const auto position = PositionState::from_fen("3qk3/2P5/8/8/8/8/8/4K1NR w K - 0 1");
+    EXPECT_EQ(to_lan(position, {{6, 0}, {5, 2}}).get_view(), "Ng1-f3");
+    EXPECT_EQ(
+        to_lan(position, {{2, 6}, {3, 7}, MoveType::NORMAL, PromotablePieceType::QUEEN}).get_view(),
+        "c7xd8=Q");
+    EXPECT_EQ(to_lan(position, {{4, 0}, {6, 0}, MoveType::KING_SIDE_CASTLE}).get_view(), "O-O");
+}
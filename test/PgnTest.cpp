@@ -0,0 +1,209 @@
+#include <gtest/gtest.h>
+
+#include <Pgn.hpp>
+#include <sstream>
+
+namespace
+{
+constexpr std::string_view OPERA_GAME = R"([Event "Paris"]
+[White "Paul Morphy"]
+[Black "Duke Karl / Count Isouard"]
+[Result "1-0"]
+
+1. e4 e5 2. Nf3 d6 3. d4 Bg4 {This is a weak move already.} 4. dxe5 Bxf3 5. Qxf3 dxe5
+6. Bc4 Nf6 7. Qb3 Qe7 8. Nc3 (8. Qxb7 Qb4+ 9. Qxb4 Bxb4+) 8... c6 9. Bg5 b5 $1 10. Nxb5
+cxb5 11. Bxb5+ Nbd7 12. O-O-O Rd8 13. Rxd7 Rxd7 14. Rd1 Qe6 15. Bxd7+ Nxd7 16. Qb8+
+Nxb8 17. Rd8# 1-0
+)";
+
+class CountingVisitor : public PgnVisitor
+{
+public:
+    void visit_tag(std::string_view name, std::string_view value) override
+    {
+        if (name == "White")
+        {
+            white = value;
+        }
+    }
+    void visit_move(const PositionState& position, const Move& move) override
+    {
+        moves.push_back(move);
+    }
+    void end_game(GameResult result) override
+    {
+        results.push_back(result);
+    }
+    void invalid_game(std::string_view reason) override
+    {
+        ++invalid_games;
+    }
+
+    std::string white;
+    std::vector<Move> moves;
+    std::vector<GameResult> results;
+    std::size_t invalid_games{0};
+};
+}  // namespace
+
+TEST(PgnTokenizer, tokens)
+{
+    PgnTokenizer tokenizer{
+        "[Event \"a \\\"b\\\"\"]\n%escaped line\n1. e4 {comment} $2 (1... e5) *"};
+    const std::vector<PgnTokenType> expected_types
+        = {PgnTokenType::LEFT_BRACKET,      PgnTokenType::SYMBOL,
+           PgnTokenType::STRING,            PgnTokenType::RIGHT_BRACKET,
+           PgnTokenType::SYMBOL,            PgnTokenType::PERIOD,
+           PgnTokenType::SYMBOL,            PgnTokenType::COMMENT,
+           PgnTokenType::NAG,               PgnTokenType::LEFT_PARENTHESIS,
+           PgnTokenType::SYMBOL,            PgnTokenType::PERIOD,
+           PgnTokenType::PERIOD,            PgnTokenType::PERIOD,
+           PgnTokenType::SYMBOL,            PgnTokenType::RIGHT_PARENTHESIS,
+           PgnTokenType::ASTERISK,          PgnTokenType::END_OF_INPUT};
+    std::vector<PgnTokenType> types;
+    std::vector<std::string_view> texts;
+    while (true)
+    {
+        const auto token = tokenizer.next_token();
+        types.push_back(token.type);
+        texts.push_back(token.text);
+        if (token.type == PgnTokenType::END_OF_INPUT)
+        {
+            break;
+        }
+    }
+    EXPECT_EQ(types, expected_types);
+    EXPECT_EQ(texts[2], "a \\\"b\\\"");
+    EXPECT_EQ(texts[7], "comment");
+}
+
+TEST(PgnReader, replays_game)
+{
+    CountingVisitor visitor;
+    PgnReader reader{visitor};
+    const auto stats = reader.parse(OPERA_GAME);
+    EXPECT_EQ(stats.games, 1u);
+    EXPECT_EQ(stats.invalid_games, 0u);
+    EXPECT_EQ(stats.moves, 33u);
+    EXPECT_EQ(visitor.white, "Paul Morphy");
+    ASSERT_EQ(visitor.results, std::vector<GameResult>{GameResult::WHITE_WON});
+    EXPECT_EQ(visitor.moves[22].type, MoveType::QUEEN_SIDE_CASTLE);
+    EXPECT_EQ(visitor.moves.back(), (Move{{3, 0}, {3, 7}}));
+}
+
+TEST(PgnReader, reports_illegal_move_and_continues)
+{
+    CountingVisitor visitor;
+    PgnReader reader{visitor};
+    const auto stats = reader.parse("1. e4 e5 2. Ke3 *\n\n1. d4 d5 1/2-1/2");
+    EXPECT_EQ(stats.games, 2u);
+    EXPECT_EQ(stats.invalid_games, 1u);
+    EXPECT_EQ(visitor.invalid_games, 1u);
+    EXPECT_EQ(visitor.results, std::vector<GameResult>{GameResult::DRAW});
+}
+
+TEST(PgnReader, fen_tag_and_promotion)
+{
+    CountingVisitor visitor;
+    PgnReader reader{visitor};
+    const auto stats = reader.parse(
+        "[FEN \"4k3/1P6/8/8/8/8/8/4K3 w - - 0 1\"]\n\n1. b8=N Kf7 2. Kd2 *\n\n1. e4 *");
+    EXPECT_EQ(stats.invalid_games, 0u);
+    ASSERT_EQ(visitor.moves.size(), 4u);
+    EXPECT_EQ(visitor.moves[0].promotion, PromotablePieceType::KNIGHT);
+    EXPECT_EQ(visitor.moves[3], (Move{{4, 1}, {4, 3}}));
+}
+
+TEST(resolve_san_move, disambiguation)
+{
+    const auto position = PositionState::from_fen("4k3/8/8/8/8/8/4K3/R6R w - - 0 1");
+    auto board_position = position.clone();
+    const auto available_moves = board_position.generate_available_moves();
+    EXPECT_FALSE(resolve_san_move(position, available_moves, "Rd1"));
+    EXPECT_EQ(resolve_san_move(position, available_moves, "Rad1"), (Move{{0, 0}, {3, 0}}));
+    EXPECT_EQ(resolve_san_move(position, available_moves, "R1d1"), std::nullopt);
+    EXPECT_EQ(resolve_san_move(position, available_moves, "Rhd1"), (Move{{7, 0}, {3, 0}}));
+    EXPECT_FALSE(resolve_san_move(position, available_moves, "Rh9"));
+}
+
+TEST(parse_pgn_parallel, matches_sequential_parse)
+{
+    std::string archive;
+    for (std::size_t game_index = 0; game_index != 16; ++game_index)
+    {
+        archive += OPERA_GAME;
+        archive += '\n';
+    }
+    EXPECT_EQ(split_pgn_games(archive, 4).size(), 4u);
+
+    std::vector<CountingVisitor> visitors(4);
+    std::vector<PgnVisitor*> visitor_pointers;
+    for (auto& visitor : visitors)
+    {
+        visitor_pointers.push_back(&visitor);
+    }
+    const auto stats = parse_pgn_parallel(archive, visitor_pointers);
+    EXPECT_EQ(stats.games, 16u);
+    EXPECT_EQ(stats.invalid_games, 0u);
+    EXPECT_EQ(stats.moves, 16u * 33u);
+}
+
+TEST(PgnWriter, round_trip)
+{
+    CountingVisitor visitor;
+    PgnReader reader{visitor};
+    reader.parse(OPERA_GAME);
+
+    std::ostringstream output;
+    {
+        PgnWriter writer{output, 64};
+        auto position = PositionState::get_starting_position();
+        writer.write_game({{"Event", "Paris"}, {"White", "Paul \"Morphy\""}}, position,
+                          visitor.moves, GameResult::WHITE_WON);
+    }
+    const std::string expected_pgn = R"([Event "Paris"]
+[White "Paul \"Morphy\""]
+
+1. e4 e5 2. Nf3 d6 3. d4 Bg4 4. dxe5 Bxf3 5. Qxf3 dxe5 6. Bc4 Nf6 7. Qb3 Qe7
+8. Nc3 c6 9. Bg5 b5 10. Nxb5 cxb5 11. Bxb5+ Nbd7 12. O-O-O Rd8 13. Rxd7 Rxd7
+14. Rd1 Qe6 15. Bxd7+ Nxd7 16. Qb8+ Nxb8 17. Rd8# 1-0
+
+)";
+    EXPECT_EQ(output.str(), expected_pgn);
+
+    CountingVisitor round_trip_visitor;
+    PgnReader round_trip_reader{round_trip_visitor};
+    round_trip_reader.parse(output.str());
+    EXPECT_EQ(round_trip_visitor.moves, visitor.moves);
+}
+
+TEST(PgnWriter, starts_with_black_move)
+{
+    std::ostringstream output;
+    {
+        PgnWriter writer{output};
+        auto position = PositionState::from_fen("4k3/8/8/8/8/8/8/4K3 b - - 0 1");
+        writer.write_game({}, position, {{{4, 7}, {4, 6}}, {{4, 0}, {4, 1}}}, GameResult::DRAW);
+    }
+    EXPECT_EQ(output.str(), "1... Ke7 2. Ke2 1/2-1/2\n\n");
+}
+
+TEST(PgnWriter, numbers_moves_from_fen_tag)
+{
+    constexpr auto fen = "4k3/8/8/8/8/8/8/4K3 b - - 12 34";
+    std::ostringstream output;
+    {
+        PgnWriter writer{output};
+        auto position = PositionState::from_fen(fen);
+        writer.write_game({{"SetUp", "1"}, {"FEN", fen}}, position,
+                          {{{4, 7}, {4, 6}}, {{4, 0}, {4, 1}}, {{4, 6}, {4, 5}}},
+                          GameResult::DRAW);
+    }
+    EXPECT_EQ(output.str(), std::string{"[SetUp \"1\"]\n[FEN \""} + fen
+                                + "\"]\n\n34... Ke7 35. Ke2 Ke6 1/2-1/2\n\n");
+
+    CountingVisitor visitor;
+    PgnReader reader{visitor};
+    reader.parse(output.str());
+    EXPECT_EQ(visitor.moves.size(), 3u);
+}
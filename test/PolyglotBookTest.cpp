@@ -0,0 +1,97 @@
+#include <gtest/gtest.h>
+
+#include <PolyglotBook.hpp>
+#include <Zobrist.hpp>
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+
+namespace
+{
+struct BookEntry
+{
+    std::uint64_t key;
+    std::uint16_t move;
+    std::uint16_t weight;
+};
+
+std::uint16_t encode_move(const Position& from, const Position& to)
+{
+    return static_cast<std::uint16_t>(to.x | to.y << 3 | from.x << 6 | from.y << 9);
+}
+
+std::string write_book(std::vector<BookEntry> entries)
+{
+    std::sort(entries.begin(), entries.end(),
+              [](const BookEntry& lhs, const BookEntry& rhs) { return lhs.key < rhs.key; });
+    const std::string path = testing::TempDir() + "polyglot_book_test.bin";
+    std::ofstream book{path, std::ios::binary};
+    const auto write_big_endian = [&book](std::uint64_t value, std::size_t size) {
+        for (std::size_t i = size; i != 0; --i)
+        {
+            book.put(static_cast<char>((value >> (8 * (i - 1))) & 0xff));
+        }
+    };
+    for (const auto& entry : entries)
+    {
+        write_big_endian(entry.key, 8);
+        write_big_endian(entry.move, 2);
+        write_big_endian(entry.weight, 2);
+        write_big_endian(0, 4);
+    }
+    return path;
+}
+}  // namespace
+
+TEST(PolyglotBook, lookup_and_weighted_choice)
+{
+    const auto start_key = get_zobrist_key(PositionState::get_starting_position());
+    const auto path = write_book({{start_key - 1, encode_move({0, 1}, {0, 2}), 1},
+                                  {start_key, encode_move({4, 1}, {4, 3}), 3},
+                                  {start_key, encode_move({3, 1}, {3, 3}), 1},
+                                  {start_key, encode_move({2, 1}, {2, 3}), 0},
+                                  {start_key + 1, encode_move({7, 1}, {7, 2}), 1}});
+    const auto book = PolyglotBook::open_shared(path);
+    EXPECT_EQ(book, PolyglotBook::open_shared(path));
+    EXPECT_EQ(book->get_entry_count(), 5u);
+
+    const auto position = PositionState::get_starting_position();
+    std::vector<BookMove> moves;
+    book->get_moves(position, moves);
+    ASSERT_EQ(moves.size(), 3u);
+
+    std::mt19937_64 random_generator{42};
+    std::size_t e4_count = 0;
+    for (std::size_t i = 0; i != 1000; ++i)
+    {
+        const auto move = book->choose_move(position, random_generator);
+        ASSERT_TRUE(move);
+        EXPECT_NE(move->from, (Position{2, 1}));
+        e4_count += move->from == Position{4, 1};
+    }
+    EXPECT_GT(e4_count, 650u);
+    EXPECT_LT(e4_count, 850u);
+    std::remove(path.c_str());
+}
+
+TEST(PolyglotBook, decodes_castling)
+{
+    const auto position = PositionState::from_fen("r3k2r/8/8/8/8/8/8/R3K2R w KQkq - 0 1");
+    const auto path = write_book({{get_zobrist_key(position), encode_move({4, 0}, {7, 0}), 1},
+                                  {get_zobrist_key(position), encode_move({4, 0}, {0, 0}), 1}});
+    const PolyglotBook book{path};
+    std::vector<BookMove> moves;
+    book.get_moves(position, moves);
+    ASSERT_EQ(moves.size(), 2u);
+    EXPECT_EQ(moves[0].move, (Move{{4, 0}, {6, 0}, MoveType::KING_SIDE_CASTLE}));
+    EXPECT_EQ(moves[1].move, (Move{{4, 0}, {2, 0}, MoveType::QUEEN_SIDE_CASTLE}));
+    std::remove(path.c_str());
+}
+
+TEST(PolyglotBook, rejects_truncated_file)
+{
+    const std::string path = testing::TempDir() + "polyglot_book_truncated.bin";
+    std::ofstream{path, std::ios::binary} << "short";
+    EXPECT_THROW(PolyglotBook{path}, std::runtime_error);
+    std::remove(path.c_str());
+}
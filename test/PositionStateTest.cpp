@@ -0,0 +1,147 @@
+#include <gtest/gtest.h>
+
+#include <PositionState.hpp>
+#include <algorithm>
+#include <array>
+
+TEST(PositionState, starting_position)
+{
+    auto position = PositionState::get_starting_position();
+    std::vector<Move> moves;
+    position.generate_legal_moves(moves);
+    EXPECT_EQ(moves.size(), 20u);
+    EXPECT_EQ(position.get_side_to_move(), PieceColor::WHITE);
+    EXPECT_EQ(position.get_king_position(PieceColor::BLACK), (Position{4, 7}));
+}
+
+TEST(PositionState, from_fen_rejects_malformed_input)
+{
+    EXPECT_THROW(PositionState::from_fen("8/8/8/8/8/8/8/8 w - -"), std::invalid_argument);
+    EXPECT_THROW(PositionState::from_fen("4k3/8/8/8/8/8/8/4K3 x - -"), std::invalid_argument);
+    EXPECT_THROW(PositionState::from_fen("4k3/8/8/8/8/8/8/4K3 w K -"), std::invalid_argument);
+    EXPECT_THROW(PositionState::from_fen("4k3/8/8/8/8/8/8/4K3 w - e3"), std::invalid_argument);
+    EXPECT_THROW(PositionState::from_fen("4k3/9/8/8/8/8/8/4K3 w - -"), std::invalid_argument);
+}
+
+TEST(PositionState, make_unmake_restores_position)
+{
+    auto position
+        = PositionState::from_fen("r3k2r/pppq1ppp/8/3Pp3/8/8/PPP2PPP/R3K2R w KQkq e6 0 1");
+    std::vector<Move> moves;
+    position.generate_legal_moves(moves);
+    for (const auto& move : moves)
+    {
+        const auto undo_info = position.make_move(move);
+        position.unmake_move(move, undo_info);
+
+        std::vector<Move> moves_after_unmake;
+        position.generate_legal_moves(moves_after_unmake);
+        EXPECT_EQ(moves_after_unmake.size(), moves.size());
+        EXPECT_EQ(position.get_en_passant_takable(), std::make_optional<Position>(4, 5));
+        EXPECT_EQ(position.get_castling_rights(PieceColor::WHITE).king_side_rook,
+                  std::make_optional<Position>(7, 0));
+        EXPECT_EQ(position.get_side_to_move(), PieceColor::WHITE);
+    }
+}
+
+TEST(PositionState, castling_moves_rook_and_clears_rights)
+{
+    auto position = PositionState::from_fen("r3k2r/8/8/8/8/8/8/R3K2R w KQkq - 0 1");
+    const Move castle{{4, 0}, {6, 0}, MoveType::KING_SIDE_CASTLE};
+    const auto undo_info = position.make_move(castle);
+    const auto& board = position.get_board();
+    ASSERT_FALSE(board.is_square_empty({5, 0}));
+    EXPECT_EQ(board.get_piece_at_position({5, 0}).get_type(), PieceType::ROOK);
+    EXPECT_TRUE(board.is_square_empty({7, 0}));
+    EXPECT_EQ(position.get_king_position(PieceColor::WHITE), (Position{6, 0}));
+    EXPECT_FALSE(position.get_castling_rights(PieceColor::WHITE).queen_side_rook);
+
+    position.unmake_move(castle, undo_info);
+    EXPECT_EQ(board.get_piece_at_position({7, 0}).get_type(), PieceType::ROOK);
+    EXPECT_EQ(board.get_piece_at_position({4, 0}).get_type(), PieceType::KING);
+    EXPECT_TRUE(position.get_castling_rights(PieceColor::WHITE).queen_side_rook);
+}
+
+TEST(PositionState, en_passant_capture_removes_pawn)
+{
+    auto position = PositionState::from_fen("4k3/8/8/3Pp3/8/8/8/4K3 w - e6 0 1");
+    const auto move = position.create_move({3, 4}, {4, 5});
+    EXPECT_EQ(move.type, MoveType::EN_PASSANT);
+    const auto undo_info = position.make_move(move);
+    EXPECT_TRUE(position.get_board().is_square_empty({4, 4}));
+    position.unmake_move(move, undo_info);
+    EXPECT_EQ(position.get_board().get_piece_at_position({4, 4}).get_color(), PieceColor::BLACK);
+}
+
+namespace
+{
+std::vector<PositionState> generate_test_positions()
+{
+    std::vector<PositionState> positions{
+        PositionState::get_starting_position(),
+        PositionState::from_fen(
+            "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1"),
+        PositionState::from_fen("8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8 w - - 0 1"),
+        PositionState::from_fen("8/8/8/K2pP2r/8/8/8/7k w - d6 0 1"),
+        PositionState::from_fen("r3k2r/1P6/8/8/8/8/6p1/R3K2R b KQkq - 0 1"),
+        PositionState::from_fen("4k3/8/8/8/1b6/8/3P4/4K3 w - - 0 1"),
+        PositionState::from_fen("r3k2r/8/8/8/8/5n2/8/R3K2R w KQkq - 0 1"),
+        PositionState::from_fen("4k3/8/8/8/8/8/3q4/3rK3 w - - 0 1"),
+        PositionState::from_fen("7k/5Q2/6K1/8/8/8/8/8 b - - 0 1")};
+    auto position = PositionState::get_starting_position();
+    std::vector<Move> moves;
+    for (std::size_t ply = 0; ply != 120; ++ply)
+    {
+        position.generate_legal_moves(moves);
+        if (moves.empty())
+        {
+            break;
+        }
+        positions.push_back(position);
+        position.make_move(moves[(ply * 13) % moves.size()]);
+    }
+    return positions;
+}
+}  // namespace
+
+TEST(PositionState, is_move_legal_agrees_with_generator)
+{
+    const std::array<std::optional<PromotablePieceType>, 3> promotions{
+        std::nullopt, PromotablePieceType::QUEEN, PromotablePieceType::KNIGHT};
+    auto positions = generate_test_positions();
+    std::vector<Move> moves;
+    for (auto& state : positions)
+    {
+        state.generate_legal_moves(moves);
+        for (std::int32_t from_index = 0; from_index != 64; ++from_index)
+        {
+            for (std::int32_t to_index = 0; to_index != 64; ++to_index)
+            {
+                const Position from{from_index % 8, from_index / 8};
+                const Position to{to_index % 8, to_index / 8};
+                for (const auto& promotion : promotions)
+                {
+                    const bool is_generated
+                        = std::any_of(moves.begin(), moves.end(), [&](const Move& move) {
+                              return move.from == from && move.to == to
+                                     && move.promotion == promotion;
+                          });
+                    EXPECT_EQ(state.is_move_legal(from, to, promotion), is_generated);
+                }
+            }
+        }
+    }
+}
+
+TEST(PositionState, count_legal_moves_agrees_with_generator)
+{
+    std::vector<Move> moves;
+    for (auto& position : generate_test_positions())
+    {
+        position.generate_legal_moves(moves);
+        EXPECT_EQ(position.count_legal_moves(), moves.size());
+        EXPECT_EQ(position.has_any_legal_move(), !moves.empty());
+    }
+    EXPECT_FALSE(PositionState::from_fen("4k3/8/8/8/8/8/3q4/3rK3 w - - 0 1").has_any_legal_move());
+    EXPECT_FALSE(PositionState::from_fen("7k/5Q2/6K1/8/8/8/8/8 b - - 0 1").has_any_legal_move());
+}
@@ -0,0 +1,80 @@
+#include <gtest/gtest.h>
+
+#include <Evaluation.hpp>
+#include <Search.hpp>
+
+TEST(Evaluation, starting_position_is_balanced)
+{
+    const auto position = PositionState::get_starting_position();
+    EXPECT_EQ(evaluate(position.get_board()), 0);
+    const auto black_to_move = PositionState::from_fen(
+        "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR b KQkq - 0 1");
+    EXPECT_EQ(evaluate(black_to_move), 0);
+}
+
+TEST(Evaluation, is_color_symmetric)
+{
+    const auto white_up = PositionState::from_fen("4k3/8/8/8/3P4/2N5/8/4K3 w - - 0 1");
+    const auto black_up = PositionState::from_fen("4k3/8/2n5/3p4/8/8/8/4K3 b - - 0 1");
+    EXPECT_GT(evaluate(white_up), 0);
+    EXPECT_EQ(evaluate(white_up), evaluate(black_up));
+    EXPECT_EQ(evaluate(white_up.get_board()), -evaluate(black_up.get_board()));
+}
+
+TEST(Search, finds_mate_in_one)
+{
+    const std::atomic<bool> stop_requested{false};
+    SearchLimits limits;
+    limits.max_depth = 3;
+    const auto result
+        = search(GameState::from_fen("6k1/5ppp/8/8/8/8/8/R5K1 w - - 0 1"), limits, stop_requested);
+    ASSERT_TRUE(result.best_move);
+    EXPECT_EQ(result.best_move->to, (Position{0, 7}));
+    EXPECT_TRUE(is_mate_score(result.score));
+    EXPECT_EQ(result.score, MATE_SCORE - 1);
+}
+
+TEST(Search, wins_hanging_queen)
+{
+    const std::atomic<bool> stop_requested{false};
+    SearchLimits limits;
+    limits.max_depth = 2;
+    const auto result = search(GameState::from_fen("4k3/8/8/3q4/8/8/8/3RK3 w - - 0 1"), limits,
+                               stop_requested);
+    ASSERT_TRUE(result.best_move);
+    EXPECT_EQ(result.best_move->to, (Position{3, 4}));
+    EXPECT_EQ(result.depth, 2u);
+    EXPECT_FALSE(result.principal_variation.empty());
+}
+
+TEST(Search, reports_mated_and_stalemated_positions)
+{
+    const std::atomic<bool> stop_requested{false};
+    const auto mated
+        = search(GameState::from_fen("4k3/8/8/8/8/8/3q4/3rK3 w - - 0 1"), {}, stop_requested);
+    EXPECT_FALSE(mated.best_move);
+    EXPECT_EQ(mated.score, -MATE_SCORE);
+    const auto stalemated
+        = search(GameState::from_fen("7k/5Q2/6K1/8/8/8/8/8 b - - 0 1"), {}, stop_requested);
+    EXPECT_FALSE(stalemated.best_move);
+    EXPECT_EQ(stalemated.score, 0);
+}
+
+TEST(Search, respects_node_limit_and_stop_request)
+{
+    const std::atomic<bool> stop_requested{true};
+    const auto stopped = search(GameState::get_starting_position(), {}, stop_requested);
+    ASSERT_TRUE(stopped.best_move);
+    EXPECT_EQ(stopped.depth, 0u);
+
+    const std::atomic<bool> keep_going{false};
+    SearchLimits limits;
+    limits.max_nodes = 5000;
+    std::uint32_t completed_depths = 0;
+    const auto limited = search(GameState::get_starting_position(), limits, keep_going,
+                                [&completed_depths](const SearchResult&) { ++completed_depths; });
+    ASSERT_TRUE(limited.best_move);
+    EXPECT_LE(limited.nodes, 5000u);
+    EXPECT_EQ(limited.depth, completed_depths);
+    EXPECT_LT(limited.depth, MAX_SEARCH_DEPTH);
+}
@@ -0,0 +1,127 @@
+#include <gtest/gtest.h>
+
+#include <BoundedQueue.hpp>
+#include <SelfPlay.hpp>
+#include <TrainingData.hpp>
+#include <filesystem>
+#include <thread>
+
+TEST(TrainingData, record_round_trip)
+{
+    const auto position = PositionState::from_fen(
+        "r3k2r/p1ppqpb1/bn2pnp1/3PN3/Pp2P3/2N2Q1p/1PPBBPPP/R3K2R b Kq a3 0 1");
+    const auto record = encode_training_record(position, -42, GameResult::BLACK_WON, 7, 300);
+    EXPECT_EQ(record.occupancy, position.get_board().get_occupied_squares().get_bits());
+    EXPECT_EQ(record.score, -42);
+    EXPECT_EQ(record.flags, 0b10011);
+    EXPECT_EQ(record.en_passant_file, 0);
+    EXPECT_EQ(record.halfmove_clock, 7);
+    EXPECT_EQ(record.ply, 300);
+    EXPECT_EQ(get_side_to_move(record), PieceColor::BLACK);
+    EXPECT_EQ(get_result(record), GameResult::BLACK_WON);
+
+    const auto board = decode_board(record);
+    for (std::uint8_t square = 0; square != 64; ++square)
+    {
+        EXPECT_EQ(board.get_piece_code(Square{square}),
+                  position.get_board().get_piece_code(Square{square}));
+    }
+}
+
+TEST(TrainingData, writer_rotates_files)
+{
+    const auto directory = std::filesystem::path{testing::TempDir()} / "training_data_test";
+    std::filesystem::create_directories(directory);
+    const auto prefix = (directory / "data").string();
+    const auto record = encode_training_record(PositionState::get_starting_position(), 15,
+                                               GameResult::WHITE_WON, 0, 0);
+    {
+        // magic plus three records per file
+        TrainingDataWriter writer{prefix, 8 + 3 * sizeof(TrainingRecord)};
+        for (std::size_t record_index = 0; record_index != 7; ++record_index)
+        {
+            writer.write(record);
+        }
+        EXPECT_EQ(writer.get_file_count(), 3u);
+        EXPECT_EQ(writer.get_record_count(), 7u);
+    }
+    EXPECT_EQ(read_training_records(prefix + "-000.bin").size(), 3u);
+    const auto last_records = read_training_records(prefix + "-002.bin");
+    ASSERT_EQ(last_records.size(), 1u);
+    EXPECT_EQ(last_records[0].score, 15);
+    EXPECT_EQ(get_result(last_records[0]), GameResult::WHITE_WON);
+    std::filesystem::remove_all(directory);
+}
+
+TEST(BoundedQueue, delivers_every_value_once)
+{
+    constexpr std::size_t PRODUCER_COUNT = 4;
+    constexpr std::size_t VALUES_PER_PRODUCER = 20000;
+    BoundedQueue<std::uint64_t> queue{100};
+    EXPECT_EQ(queue.get_capacity(), 128u);
+    std::vector<std::thread> producers;
+    for (std::size_t producer = 0; producer != PRODUCER_COUNT; ++producer)
+    {
+        producers.emplace_back([&queue, producer] {
+            for (std::uint64_t value = 0; value != VALUES_PER_PRODUCER; ++value)
+            {
+                while (!queue.try_push(producer * VALUES_PER_PRODUCER + value))
+                {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+    std::vector<bool> seen(PRODUCER_COUNT * VALUES_PER_PRODUCER);
+    std::vector<std::uint64_t> next_per_producer(PRODUCER_COUNT);
+    for (std::size_t received = 0; received != seen.size();)
+    {
+        std::uint64_t value;
+        if (!queue.try_pop(value))
+        {
+            std::this_thread::yield();
+            continue;
+        }
+        ASSERT_FALSE(seen[value]);
+        seen[value] = true;
+        // values of one producer keep their order
+        const auto producer = value / VALUES_PER_PRODUCER;
+        EXPECT_EQ(value % VALUES_PER_PRODUCER, next_per_producer[producer]++);
+        ++received;
+    }
+    for (auto& producer : producers)
+    {
+        producer.join();
+    }
+    std::uint64_t value;
+    EXPECT_FALSE(queue.try_pop(value));
+}
+
+TEST(SelfPlay, writes_unique_quiet_positions)
+{
+    const auto directory = std::filesystem::path{testing::TempDir()} / "self_play_test";
+    std::filesystem::create_directories(directory);
+    SelfPlayConfig config;
+    config.thread_count = 2;
+    config.game_count = 4;
+    config.limits.max_depth = 1;
+    config.min_sample_ply = 10;
+    config.max_plies = 60;
+    config.output_prefix = (directory / "games").string();
+    const std::atomic<bool> stop_requested{false};
+    const auto statistics = run_self_play(config, stop_requested);
+    EXPECT_EQ(statistics.games, 4u);
+    EXPECT_GT(statistics.written_positions, 0u);
+    EXPECT_EQ(statistics.written_positions + statistics.duplicate_positions,
+              statistics.sampled_positions);
+    EXPECT_EQ(statistics.file_count, 1u);
+
+    const auto records = read_training_records(config.output_prefix + "-000.bin");
+    EXPECT_EQ(records.size(), statistics.written_positions);
+    for (const auto& record : records)
+    {
+        EXPECT_GE(record.ply, config.min_sample_ply);
+        EXPECT_EQ(decode_board(record).get_occupied_squares().get_bits(), record.occupancy);
+    }
+    std::filesystem::remove_all(directory);
+}
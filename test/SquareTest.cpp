@@ -0,0 +1,42 @@
+#include <gtest/gtest.h>
+
+#include <Square.hpp>
+#include <vector>
+
+TEST(Square, converts_to_and_from_position)
+{
+    for (std::int32_t y = 0; y != 8; ++y)
+    {
+        for (std::int32_t x = 0; x != 8; ++x)
+        {
+            const Square square{Position{x, y}};
+            EXPECT_EQ(square.get_index(), 8 * y + x);
+            EXPECT_EQ(square.to_position(), (Position{x, y}));
+            EXPECT_EQ(Square::from_0x88(square.to_0x88()), square);
+            EXPECT_TRUE(is_0x88_on_board(square.to_0x88()));
+        }
+    }
+}
+
+TEST(Square, steps_off_board_are_detected_by_0x88_index)
+{
+    const auto h4 = Square{Position{7, 3}}.to_0x88();
+    EXPECT_FALSE(is_0x88_on_board(h4 + 1));
+    EXPECT_FALSE(is_0x88_on_board(Square{Position{0, 0}}.to_0x88() - 1));
+    EXPECT_FALSE(is_0x88_on_board(Square{Position{3, 7}}.to_0x88() + 16));
+    EXPECT_FALSE(is_0x88_on_board(Square{Position{3, 0}}.to_0x88() - 33));
+    EXPECT_TRUE(is_0x88_on_board(h4 - 1));
+}
+
+TEST(SquareSet, behaves_like_set_of_positions)
+{
+    SquareSet squares{{4, 4}, {0, 0}, {7, 7}};
+    squares.insert(Position{4, 4});
+    EXPECT_EQ(squares.size(), 3u);
+    EXPECT_EQ(squares.count({0, 0}), 1u);
+    EXPECT_EQ(squares.count({8, 0}), 0u);
+    squares.erase(Square{Position{0, 0}});
+    EXPECT_FALSE(squares.contains(Square{Position{0, 0}}));
+    EXPECT_EQ(std::vector<Position>(squares.begin(), squares.end()),
+              (std::vector<Position>{{4, 4}, {7, 7}}));
+}
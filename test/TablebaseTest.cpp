@@ -0,0 +1,176 @@
+#include <gtest/gtest.h>
+
+#include <TablebaseGenerator.hpp>
+#include <algorithm>
+#include <filesystem>
+
+namespace
+{
+TablebasePosition get_position(std::string_view fen)
+{
+    return *get_tablebase_position(PositionState::from_fen(fen));
+}
+
+std::uint8_t encode(TablebaseResult result, std::uint8_t plies_to_mate)
+{
+    return encode_tablebase_probe({result, plies_to_mate});
+}
+}  // namespace
+
+TEST(Tablebase, moves_match_move_generator)
+{
+    const std::vector<std::string_view> fens = {"8/8/8/8/8/k7/7P/6K1 w - - 0 1",
+                                                "4k3/1P6/8/8/8/8/8/4K3 w - - 0 1",
+                                                "r3k3/8/8/8/8/8/8/R3K3 w - - 0 1",
+                                                "4k3/8/8/3q4/8/8/2N5/4K3 w - - 0 1",
+                                                "3rk3/8/8/8/8/8/8/3QK3 b - - 0 1",
+                                                "4k3/3p4/8/4K3/8/8/8/8 b - - 0 1",
+                                                "8/8/8/Pp6/8/8/8/K1k5 w - b6 0 1",
+                                                "8/8/8/8/2pP4/8/8/K1k5 b - d3 0 1"};
+    std::vector<Move> moves;
+    std::vector<TablebasePosition> children;
+    for (const auto fen : fens)
+    {
+        auto position = PositionState::from_fen(fen);
+        moves.clear();
+        position.generate_legal_moves(moves);
+        generate_tablebase_moves(*get_tablebase_position(position), children);
+        EXPECT_EQ(children.size(), moves.size()) << fen;
+    }
+}
+
+TEST(Tablebase, unmoves_invert_moves)
+{
+    std::vector<TablebasePosition> children;
+    std::vector<TablebasePosition> parents;
+    for (const auto material_name : {"KQKR", "KPKP"})
+    {
+        auto position = *parse_material_name(material_name);
+        std::size_t checked_count = 0;
+        std::size_t en_passant_count = 0;
+        for (std::size_t index = 0; index < get_tablebase_size(position); index += 997)
+        {
+            set_tablebase_index(position, index);
+            if (!is_tablebase_position_valid(position))
+            {
+                continue;
+            }
+            generate_tablebase_moves(position, children);
+            for (const auto& child : children)
+            {
+                if (get_material_name(child) != material_name)
+                {
+                    continue;
+                }
+                generate_tablebase_unmoves(child, parents);
+                EXPECT_TRUE(std::any_of(parents.begin(), parents.end(),
+                                        [&position](const TablebasePosition& parent) {
+                                            return get_tablebase_index(parent)
+                                                   == get_tablebase_index(position);
+                                        }))
+                    << material_name << " " << index;
+                ++checked_count;
+                en_passant_count += child.en_passant_file >= 0;
+            }
+        }
+        EXPECT_GT(checked_count, 1000u) << material_name;
+        EXPECT_EQ(en_passant_count > 0, material_name == std::string_view{"KPKP"});
+    }
+}
+
+TEST(Tablebase, symmetric_positions_share_index)
+{
+    EXPECT_EQ(get_tablebase_size(*parse_material_name("KQKR")), 2u * 462 * 64 * 64);
+    EXPECT_EQ(get_tablebase_size(*parse_material_name("KPK")), 2u * 1806 * 64);
+    EXPECT_EQ(get_tablebase_size(*parse_material_name("KPKP")),
+              2u * 1806 * 64 * 64 + 2u * 1806 * 8 * 64);
+
+    const auto transform = [](TablebasePosition position, bool mirror_files, bool is_pawnless)
+    {
+        for (std::size_t i = 0; i != position.piece_count; ++i)
+        {
+            auto& square = position.pieces[i].square;
+            square = mirror_files ? square ^ 7 : 8 * (square & 7) + (square >> 3);
+            square = is_pawnless && mirror_files ? square ^ 56 : square;
+        }
+        if (position.en_passant_file >= 0 && mirror_files)
+        {
+            position.en_passant_file = 7 - position.en_passant_file;
+        }
+        return position;
+    };
+    for (const auto fen : {"4k3/8/8/3q4/8/8/2N5/4K3 w - - 0 1", "8/8/3k4/8/8/2K5/8/R6r b - - 0 1"})
+    {
+        const auto position = get_position(fen);
+        const auto index = get_tablebase_index(position);
+        auto symmetric_position = position;
+        for (std::int32_t i = 0; i != 8; ++i)
+        {
+            symmetric_position = transform(symmetric_position, i % 2 == 0, true);
+            EXPECT_EQ(get_tablebase_index(symmetric_position), index) << fen << " " << i;
+        }
+        auto indexed_position = position;
+        set_tablebase_index(indexed_position, index);
+        EXPECT_EQ(get_tablebase_index(indexed_position), index) << fen;
+    }
+
+    const auto position = get_position("8/8/8/Pp6/8/8/8/K1k5 w - b6 0 1");
+    EXPECT_EQ(position.en_passant_file, 1);
+    EXPECT_EQ(get_tablebase_index(transform(position, true, false)),
+              get_tablebase_index(position));
+    EXPECT_GE(get_tablebase_index(position), 2u * 1806 * 64 * 64);
+    auto indexed_position = position;
+    set_tablebase_index(indexed_position, get_tablebase_index(position));
+    EXPECT_EQ(indexed_position.en_passant_file, 1);
+    EXPECT_TRUE(is_tablebase_position_valid(indexed_position));
+    EXPECT_EQ(get_position("8/8/8/1p6/8/8/8/K1k5 w - b6 0 1").en_passant_file, -1);
+}
+
+TEST(Tablebase, solves_king_and_rook_against_king)
+{
+    TablebaseGenerator generator{2};
+    const auto& values = generator.generate("KRK");
+    std::uint8_t longest_mate = 0;
+    for (const auto value : values)
+    {
+        if (value < TABLEBASE_LOSS_OFFSET)
+        {
+            longest_mate = std::max(longest_mate, value);
+        }
+    }
+    EXPECT_EQ(longest_mate, 31);
+
+    EXPECT_EQ(generator.probe(get_position("k7/8/1K6/8/8/8/8/7R w - - 0 1")),
+              encode(TablebaseResult::WIN, 1));
+    EXPECT_EQ(generator.probe(get_position("R5k1/8/6K1/8/8/8/8/8 b - - 0 1")),
+              encode(TablebaseResult::LOSS, 0));
+    EXPECT_EQ(generator.probe(get_position("K7/8/1k6/8/8/8/8/7r b - - 0 1")),
+              encode(TablebaseResult::WIN, 1));
+    EXPECT_EQ(generator.probe(get_position("8/8/8/8/8/8/8/K1Rk4 b - - 0 1")), TABLEBASE_DRAW);
+}
+
+TEST(Tablebase, king_and_pawn_tables_are_probed_from_files)
+{
+    TablebaseGenerator generator{2};
+    generator.generate("KPK");
+    EXPECT_EQ(generator.get_material_names(),
+              (std::vector<std::string>{"KBK", "KNK", "KPK", "KQK", "KRK"}));
+    const auto directory = std::filesystem::path{testing::TempDir()} / "tablebase_test";
+    std::filesystem::create_directories(directory);
+    generator.write(directory.string());
+
+    TablebaseSet tablebases;
+    tablebases.load_directory(directory.string());
+    EXPECT_EQ(tablebases.get_table_count(), 5u);
+    const auto probe = [&tablebases](std::string_view fen)
+    { return tablebases.probe(PositionState::from_fen(fen))->result; };
+    EXPECT_EQ(probe("k7/8/8/8/8/8/P7/K7 w - - 0 1"), TablebaseResult::DRAW);
+    EXPECT_EQ(probe("8/8/8/8/8/k7/7P/6K1 w - - 0 1"), TablebaseResult::WIN);
+    EXPECT_EQ(probe("8/8/8/8/8/k7/7P/6K1 b - - 0 1"), TablebaseResult::LOSS);
+    EXPECT_EQ(probe("4k3/4P3/4K3/8/8/8/8/8 b - - 0 1"), TablebaseResult::DRAW);
+    EXPECT_EQ(probe("k7/2Q5/1K6/8/8/8/8/8 b - - 0 1"), TablebaseResult::DRAW);
+    EXPECT_EQ(probe("8/8/8/8/8/8/p7/k6K b - - 0 1"), TablebaseResult::WIN);
+    EXPECT_FALSE(tablebases.probe(PositionState::from_fen("4k3/8/8/8/8/8/8/R3K3 w Q - 0 1")));
+    EXPECT_FALSE(tablebases.probe(PositionState::from_fen("4k3/8/8/8/8/8/8/RB2K3 w - - 0 1")));
+    std::filesystem::remove_all(directory);
+}
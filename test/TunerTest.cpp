@@ -0,0 +1,99 @@
+#include <gtest/gtest.h>
+
+#include <Evaluation.hpp>
+#include <Tuner.hpp>
+
+namespace
+{
+const std::vector<const char*> TUNER_TEST_FENS = {
+    "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1",
+    "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1",
+    "8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8 w - - 0 1",
+    "r2q1rk1/pP1p2pp/Q4n2/bbp1p3/Np6/1B3NBn/pPPP1PPP/R3K2R b KQ - 0 1",
+    "4k3/8/8/8/8/8/8/2B1KB2 w - - 0 1"};
+}  // namespace
+
+TEST(Tuner, linear_evaluation_matches_evaluate)
+{
+    TunerDataset dataset;
+    for (const auto fen : TUNER_TEST_FENS)
+    {
+        dataset.add_position(PositionState::from_fen(fen).get_board(), 0.5f, 0);
+    }
+    const EvaluationTuner tuner{dataset, EvaluationParameters::get_compiled(), {}};
+    for (std::size_t position_index = 0; position_index != TUNER_TEST_FENS.size();
+         ++position_index)
+    {
+        const auto board = PositionState::from_fen(TUNER_TEST_FENS[position_index]).get_board();
+        EXPECT_DOUBLE_EQ(tuner.evaluate(position_index), evaluate(board))
+            << TUNER_TEST_FENS[position_index];
+    }
+}
+
+TEST(Tuner, training_records_keep_result_and_score)
+{
+    const auto position = PositionState::from_fen(TUNER_TEST_FENS[3]);
+    TunerDataset dataset;
+    dataset.add_records({encode_training_record(position, 25, GameResult::BLACK_WON, 0, 20)});
+    ASSERT_EQ(dataset.get_position_count(), 1u);
+    EXPECT_EQ(dataset.get_result(0), 0.0f);
+    EXPECT_EQ(dataset.get_score(0), -25);
+    EXPECT_EQ(dataset.get_bishop_pair(0), 0);
+    EXPECT_EQ(dataset.get_features_end(0) - dataset.get_features_begin(0),
+              static_cast<std::ptrdiff_t>(position.get_board().get_occupied_squares().size()));
+}
+
+TEST(Tuner, adam_learns_material_from_results)
+{
+    // the side with the extra queen always wins, tuning starts without any piece values
+    TunerDataset dataset;
+    for (const auto fen : {"4k3/8/8/8/8/8/8/3QK3 w - - 0 1", "3qk3/8/8/8/8/8/8/4K3 w - - 0 1",
+                           "4k3/8/8/8/8/8/8/2Q1K3 b - - 0 1", "2q1k3/8/8/8/8/8/8/4K3 b - - 0 1"})
+    {
+        const auto board = PositionState::from_fen(fen).get_board();
+        dataset.add_position(board, evaluate(board) > 0 ? 1.0f : 0.0f, 0);
+    }
+    TunerConfig config;
+    config.thread_count = 2;
+    config.learning_rate = 10.0;
+    const EvaluationParameters initial_parameters;
+    EvaluationTuner tuner{dataset, initial_parameters, config};
+    const auto initial_error = tuner.get_error();
+    EXPECT_DOUBLE_EQ(initial_error, 0.25);
+    for (std::size_t epoch = 0; epoch != 50; ++epoch)
+    {
+        tuner.run_epoch();
+    }
+    EXPECT_LT(tuner.get_error(), initial_error / 10);
+    EXPECT_GT(tuner.get_parameters().piece_values[static_cast<std::size_t>(PieceType::QUEEN)],
+              200);
+    EXPECT_EQ(tuner.get_parameters().piece_values[static_cast<std::size_t>(PieceType::KING)], 0);
+}
+
+TEST(Tuner, fits_scaling_constant)
+{
+    TunerDataset dataset;
+    for (const auto fen : TUNER_TEST_FENS)
+    {
+        const auto board = PositionState::from_fen(fen).get_board();
+        dataset.add_position(board, evaluate(board) > 0 ? 1.0f : 0.5f, 0);
+    }
+    EvaluationTuner tuner{dataset, EvaluationParameters::get_compiled(), {}};
+    const auto default_error = tuner.get_error();
+    const auto scaling_constant = tuner.fit_scaling_constant();
+    EXPECT_GT(scaling_constant, 0.0);
+    EXPECT_LE(tuner.get_error(), default_error);
+}
+
+TEST(Tuner, formats_parameters_header)
+{
+    const auto header = format_evaluation_parameters(EvaluationParameters::get_compiled());
+    EXPECT_EQ(header.rfind("#pragma once\n", 0), 0u);
+    EXPECT_NE(header.find("EVALUATION_PIECE_VALUES{0, 900, 330, 320, 500, 100};"),
+              std::string::npos);
+    EXPECT_NE(header.find("EVALUATION_BISHOP_PAIR_BONUS = 30;"), std::string::npos);
+    EXPECT_NE(header.find("    // pawn\n    {  0,   0,   0,   0,   0,   0,   0,   0,\n"
+                          "      50,  50,  50,  50,  50,  50,  50,  50,\n"),
+              std::string::npos);
+    EXPECT_EQ(header.substr(header.rfind("}};")), "}};\n// clang-format on\n");
+}
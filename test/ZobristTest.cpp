@@ -0,0 +1,32 @@
+#include <gtest/gtest.h>
+
+#include <Zobrist.hpp>
+
+TEST(Zobrist, polyglot_reference_keys)
+{
+    const std::vector<std::pair<std::string_view, std::uint64_t>> reference_keys = {
+        {"rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1", 0x463b96181691fc9c},
+        {"rnbqkbnr/pppppppp/8/8/4P3/8/PPPP1PPP/RNBQKBNR b KQkq e3 0 1", 0x823c9b50fd114196},
+        {"rnbqkbnr/ppp1pppp/8/3p4/4P3/8/PPPP1PPP/RNBQKBNR w KQkq d6 0 2", 0x0756b94461c50fb0},
+        {"rnbqkbnr/ppp1pppp/8/3pP3/8/8/PPPP1PPP/RNBQKBNR b KQkq - 0 2", 0x662fafb965db29d4},
+        {"rnbqkbnr/ppp1p1pp/8/3pPp2/8/8/PPPP1PPP/RNBQKBNR w KQkq f6 0 3", 0x22a48b5a8e47ff78},
+        {"rnbqkbnr/ppp1p1pp/8/3pPp2/8/8/PPPPKPPP/RNBQ1BNR b kq - 0 3", 0x652a607ca3f242c1},
+        {"rnbq1bnr/ppp1pkpp/8/3pPp2/8/8/PPPPKPPP/RNBQ1BNR w - - 0 4", 0x00fdd303c946bdd9},
+        {"rnbqkbnr/p1pppppp/8/8/PpP4P/8/1P1PPPP1/RNBQKBNR b KQkq c3 0 3", 0x3c8123ea7b067637},
+        {"rnbqkbnr/p1pppppp/8/8/P6P/R1p5/1P1PPPP1/1NBQKBNR b Kkq - 0 4", 0x5c3f9b829b279560}};
+    for (const auto& [fen, key] : reference_keys)
+    {
+        EXPECT_EQ(get_zobrist_key(PositionState::from_fen(fen)), key) << fen;
+    }
+}
+
+TEST(Zobrist, make_unmake_keeps_key)
+{
+    auto position = PositionState::get_starting_position();
+    const auto key = get_zobrist_key(position);
+    const Move move{{4, 1}, {4, 3}};
+    const auto undo_info = position.make_move(move);
+    EXPECT_EQ(get_zobrist_key(position), 0x823c9b50fd114196u);
+    position.unmake_move(move, undo_info);
+    EXPECT_EQ(get_zobrist_key(position), key);
+}
@@ -0,0 +1,217 @@
+#include <AnalysisProtocol.hpp>
+#include <UnixSocket.hpp>
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <mutex>
+#include <random>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace
+{
+using Clock = std::chrono::steady_clock;
+
+constexpr std::size_t MAX_IN_FLIGHT = 16;
+constexpr std::size_t READ_BUFFER_SIZE = 4096;
+constexpr std::uint32_t SEARCH_DEPTH = 4;
+constexpr std::chrono::milliseconds SEARCH_DEADLINE{1000};
+
+const std::array<const char*, 5> FENS = {
+    "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1",
+    "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1",
+    "8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8 w - - 0 1",
+    "r2q1rk1/pP1p2pp/Q4n2/bbp1p3/Np6/1B3NBn/pPPP1PPP/R3K2R b KQ - 0 1",
+    "rnbq1k1r/pp1Pbppp/2p5/8/2B5/8/PPP1NnPP/RNBQK2R w KQ - 1 8",
+};
+
+struct ClientStatistics
+{
+    std::vector<std::uint32_t> latencies_us;
+    std::size_t error_count{0};
+};
+
+AnalysisRequest make_request(std::uint64_t id, std::mt19937& random, std::size_t search_percent)
+{
+    AnalysisRequest request;
+    request.id = id;
+    request.fen = FENS[random() % FENS.size()];
+    const auto roll = random() % 100;
+    if (roll < search_percent)
+    {
+        request.command = AnalysisCommand::SEARCH;
+        request.limits.max_depth = SEARCH_DEPTH;
+        request.deadline = SEARCH_DEADLINE;
+    }
+    else
+    {
+        request.command = roll % 2 == 0 ? AnalysisCommand::LEGAL_MOVES : AnalysisCommand::EVALUATE;
+    }
+    return request;
+}
+
+bool send_payload(const UnixSocket& socket, const std::string& payload)
+{
+    const auto frame = encode_frame(payload);
+    return socket.write_all(frame.data(), frame.size());
+}
+
+/**
+ * @brief keeps up to MAX_IN_FLIGHT requests outstanding on one connection
+ */
+ClientStatistics run_connection(const std::string& path,
+                                std::size_t connection_index,
+                                std::size_t request_count,
+                                std::size_t search_percent)
+{
+    ClientStatistics statistics;
+    auto socket = UnixSocket::connect(path);
+    std::mt19937 random{static_cast<std::uint32_t>(connection_index)};
+    std::unordered_map<std::uint64_t, Clock::time_point> sent_at;
+    FrameDecoder decoder;
+    std::array<char, READ_BUFFER_SIZE> buffer;
+    std::size_t sent_count = 0;
+    std::size_t received_count = 0;
+    while (received_count != request_count)
+    {
+        while (sent_count != request_count && sent_at.size() != MAX_IN_FLIGHT)
+        {
+            const auto id = connection_index * request_count + sent_count + 1;
+            sent_at.emplace(id, Clock::now());
+            if (!send_payload(socket, format_analysis_request(make_request(id, random,
+                                                                           search_percent))))
+            {
+                return statistics;
+            }
+            ++sent_count;
+        }
+        const auto size = socket.read_some(buffer.data(), buffer.size());
+        if (size == 0)
+        {
+            return statistics;
+        }
+        decoder.append(buffer.data(), size);
+        while (const auto reply = decoder.next_frame())
+        {
+            const auto sent = sent_at.find(get_payload_id(*reply));
+            if (sent == sent_at.end())
+            {
+                continue;
+            }
+            statistics.latencies_us.push_back(static_cast<std::uint32_t>(
+                std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() -
+                                                                      sent->second)
+                    .count()));
+            if (reply->find(" error ") != std::string::npos)
+            {
+                ++statistics.error_count;
+            }
+            sent_at.erase(sent);
+            ++received_count;
+        }
+    }
+    return statistics;
+}
+
+std::uint32_t get_percentile(std::vector<std::uint32_t>& samples, std::size_t percent)
+{
+    if (samples.empty())
+    {
+        return 0;
+    }
+    const auto nth = samples.begin() + (samples.size() - 1) * percent / 100;
+    std::nth_element(samples.begin(), nth, samples.end());
+    return *nth;
+}
+
+std::string fetch_server_metrics(const std::string& path)
+{
+    const auto socket = UnixSocket::connect(path);
+    AnalysisRequest request;
+    request.command = AnalysisCommand::METRICS;
+    if (!send_payload(socket, format_analysis_request(request)))
+    {
+        return {};
+    }
+    FrameDecoder decoder;
+    std::array<char, READ_BUFFER_SIZE> buffer;
+    while (const auto size = socket.read_some(buffer.data(), buffer.size()))
+    {
+        decoder.append(buffer.data(), size);
+        if (auto reply = decoder.next_frame())
+        {
+            return *reply;
+        }
+    }
+    return {};
+}
+}  // namespace
+
+int main(int argc, char const* argv[])
+{
+    if (argc < 2)
+    {
+        std::fprintf(stderr,
+                     "usage: %s <socket path> [connections] [requests per connection] "
+                     "[search percent]\n",
+                     argv[0]);
+        return 1;
+    }
+    const std::string path = argv[1];
+    const std::size_t connection_count = argc > 2 ? std::strtoul(argv[2], nullptr, 10) : 8;
+    const std::size_t request_count = argc > 3 ? std::strtoul(argv[3], nullptr, 10) : 1000;
+    const std::size_t search_percent = argc > 4 ? std::strtoul(argv[4], nullptr, 10) : 5;
+
+    std::vector<ClientStatistics> statistics(connection_count);
+    std::vector<std::thread> clients;
+    std::mutex error_mutex;
+    const auto start = Clock::now();
+    for (std::size_t connection_index = 0; connection_index != connection_count;
+         ++connection_index)
+    {
+        clients.emplace_back([&, connection_index] {
+            try
+            {
+                statistics[connection_index] =
+                    run_connection(path, connection_index, request_count, search_percent);
+            }
+            catch (const std::runtime_error& error)
+            {
+                std::lock_guard lock{error_mutex};
+                std::fprintf(stderr, "connection %zu: %s\n", connection_index, error.what());
+            }
+        });
+    }
+    for (auto& client : clients)
+    {
+        client.join();
+    }
+    const std::chrono::duration<double> elapsed = Clock::now() - start;
+
+    std::vector<std::uint32_t> latencies;
+    std::size_t error_count = 0;
+    for (const auto& connection_statistics : statistics)
+    {
+        latencies.insert(latencies.end(), connection_statistics.latencies_us.begin(),
+                         connection_statistics.latencies_us.end());
+        error_count += connection_statistics.error_count;
+    }
+    std::printf("replies: %zu errors: %zu time: %.3fs requests/s: %.1f\n", latencies.size(),
+                error_count, elapsed.count(), latencies.size() / elapsed.count());
+    const auto p50 = get_percentile(latencies, 50);
+    const auto p99 = get_percentile(latencies, 99);
+    std::printf("latency us p50: %u p99: %u\n", p50, p99);
+    try
+    {
+        std::printf("server: %s\n", fetch_server_metrics(path).c_str());
+    }
+    catch (const std::runtime_error& error)
+    {
+        std::fprintf(stderr, "%s\n", error.what());
+    }
+    return 0;
+}
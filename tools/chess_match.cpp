@@ -0,0 +1,244 @@
+#include <Match.hpp>
+#include <chrono>
+#include <cinttypes>
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+#include <fstream>
+#include <optional>
+#include <set>
+#include <string>
+#include <string_view>
+#include <thread>
+
+namespace
+{
+constexpr std::uint32_t DEFAULT_MATCH_DEPTH = 4;
+constexpr std::size_t PROGRESS_INTERVAL = 10;
+/**
+ * @brief random plies after the starting position when no opening book is given
+ */
+constexpr std::uint32_t DEFAULT_RANDOM_PLIES = 8;
+
+struct MatchOptions
+{
+    MatchConfig config;
+    SprtParameters sprt;
+    bool stop_on_sprt{true};
+    std::optional<std::string> openings_path;
+    std::optional<std::uint32_t> random_plies;
+};
+
+/**
+ * @return false if option is not a limit of engine, engine is 1 or 2 at the end of option
+ */
+bool parse_engine_option(std::string_view option, const char* value, MatchConfig& config)
+{
+    if (option.empty() || (option.back() != '1' && option.back() != '2'))
+    {
+        return false;
+    }
+    auto& limits = option.back() == '1' ? config.first.limits : config.second.limits;
+    option.remove_suffix(1);
+    if (option == "--depth")
+    {
+        limits.max_depth = static_cast<std::uint32_t>(std::strtoul(value, nullptr, 10));
+    }
+    else if (option == "--nodes")
+    {
+        limits.max_nodes = std::strtoull(value, nullptr, 10);
+    }
+    else if (option == "--movetime")
+    {
+        limits.move_time = std::chrono::milliseconds{std::strtoul(value, nullptr, 10)};
+    }
+    else
+    {
+        return false;
+    }
+    return true;
+}
+
+std::optional<MatchOptions> parse_options(int argc, char const* argv[])
+{
+    MatchOptions options;
+    options.config.first = {"first", {}};
+    options.config.second = {"second", {}};
+    options.config.first.limits.max_depth = DEFAULT_MATCH_DEPTH;
+    options.config.second.limits.max_depth = DEFAULT_MATCH_DEPTH;
+    options.config.game_count = 100;
+    options.config.thread_count = std::max(1u, std::thread::hardware_concurrency());
+    for (int index = 1; index + 1 < argc; index += 2)
+    {
+        const std::string_view option = argv[index];
+        const char* value = argv[index + 1];
+        if (option == "--openings")
+        {
+            options.openings_path = value;
+        }
+        else if (option == "--games")
+        {
+            options.config.game_count = std::strtoul(value, nullptr, 10);
+        }
+        else if (option == "--threads")
+        {
+            options.config.thread_count = std::strtoul(value, nullptr, 10);
+        }
+        else if (option == "--random-plies")
+        {
+            options.random_plies = static_cast<std::uint32_t>(std::strtoul(value, nullptr, 10));
+        }
+        else if (option == "--seed")
+        {
+            options.config.seed = static_cast<std::uint32_t>(std::strtoul(value, nullptr, 10));
+        }
+        else if (option == "--max-plies")
+        {
+            options.config.max_plies = static_cast<std::uint32_t>(std::strtoul(value, nullptr, 10));
+        }
+        else if (option == "--elo0")
+        {
+            options.sprt.elo0 = std::strtod(value, nullptr);
+        }
+        else if (option == "--elo1")
+        {
+            options.sprt.elo1 = std::strtod(value, nullptr);
+        }
+        else if (option == "--alpha")
+        {
+            options.sprt.alpha = std::strtod(value, nullptr);
+        }
+        else if (option == "--beta")
+        {
+            options.sprt.beta = std::strtod(value, nullptr);
+        }
+        else if (option == "--sprt")
+        {
+            options.stop_on_sprt = std::string_view{value} != "0";
+        }
+        else if (!parse_engine_option(option, value, options.config))
+        {
+            return std::nullopt;
+        }
+    }
+    if (argc % 2 == 0)
+    {
+        return std::nullopt;
+    }
+    options.config.random_plies
+        = options.random_plies.value_or(options.openings_path ? 0 : DEFAULT_RANDOM_PLIES);
+    return options;
+}
+
+/**
+ * @param has_statistics false prints the game results only
+ */
+void print_score(const MatchScore& score, const SprtParameters& sprt, bool has_statistics)
+{
+    if (!has_statistics)
+    {
+        std::printf("games: %" PRIu64 " +%" PRIu64 " =%" PRIu64 " -%" PRIu64 " score: %.3f\n",
+                    score.get_game_count(), score.wins, score.draws, score.losses,
+                    score.get_score());
+        std::fflush(stdout);
+        return;
+    }
+    const auto elo = estimate_elo(score);
+    std::printf("games: %" PRIu64 " +%" PRIu64 " =%" PRIu64 " -%" PRIu64
+                " score: %.3f elo: %.1f +- %.1f llr: %.2f [%.2f, %.2f]\n",
+                score.get_game_count(), score.wins, score.draws, score.losses, score.get_score(),
+                elo.elo, elo.error_margin, get_sprt_llr(score, sprt), get_sprt_lower_bound(sprt),
+                get_sprt_upper_bound(sprt));
+    std::fflush(stdout);
+}
+}  // namespace
+
+int main(int argc, char const* argv[])
+{
+    const auto options = parse_options(argc, argv);
+    if (!options)
+    {
+        std::fprintf(stderr,
+                     "usage: %s [--openings EPD] [--random-plies N] [--seed S] [--games N]\n"
+                     "  [--threads N] [--max-plies N] [--depth1 N] [--nodes1 N] [--movetime1 MS]\n"
+                     "  [--depth2 N] [--nodes2 N] [--movetime2 MS] [--elo0 E] [--elo1 E]\n"
+                     "  [--alpha A] [--beta B] [--sprt 0|1]\n",
+                     argv[0]);
+        return 1;
+    }
+
+    std::vector<std::string> openings{"rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1"};
+    try
+    {
+        if (options->openings_path)
+        {
+            std::ifstream input{*options->openings_path};
+            if (!input)
+            {
+                std::fprintf(stderr, "can not open %s\n", options->openings_path->c_str());
+                return 1;
+            }
+            openings = read_openings(input);
+        }
+    }
+    catch (const std::invalid_argument& error)
+    {
+        std::fprintf(stderr, "%s\n", error.what());
+        return 1;
+    }
+
+    // the search is deterministic, pairs from the same position replay the same two games and
+    // elo and sprt would treat the copies as independent results
+    const auto pair_count = (options->config.game_count + 1) / 2;
+    const auto distinct_opening_count
+        = std::set<std::string>(openings.begin(), openings.end()).size();
+    const auto has_statistics
+        = options->config.random_plies != 0 || distinct_opening_count >= pair_count;
+    if (!has_statistics)
+    {
+        std::fprintf(stderr,
+                     "warning: %zu distinct openings for %zu game pairs repeat games, elo and"
+                     " sprt are not reported, use --random-plies or more openings\n",
+                     distinct_opening_count, pair_count);
+    }
+
+    const auto& sprt = options->sprt;
+    const auto cpu_start = std::clock();
+    const auto start = std::chrono::steady_clock::now();
+    std::optional<SprtDecision> decision;
+    MatchScore score;
+    try
+    {
+        score = run_match(openings, options->config,
+                          [&](const MatchGame&, const MatchScore& current_score) {
+                              if (current_score.get_game_count() % PROGRESS_INTERVAL == 0)
+                              {
+                                  print_score(current_score, sprt, has_statistics);
+                              }
+                              if (!has_statistics)
+                              {
+                                  return true;
+                              }
+                              decision = get_sprt_decision(current_score, sprt);
+                              return !options->stop_on_sprt || decision == SprtDecision::CONTINUE;
+                          });
+    }
+    catch (const std::invalid_argument& error)
+    {
+        std::fprintf(stderr, "%s\n", error.what());
+        return 1;
+    }
+    const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    const auto cpu_seconds = static_cast<double>(std::clock() - cpu_start) / CLOCKS_PER_SEC;
+
+    print_score(score, sprt, has_statistics);
+    if (has_statistics)
+    {
+        std::printf("sprt: %s\n", to_c_str(decision.value_or(SprtDecision::CONTINUE)));
+    }
+    std::printf("time: %.2fs games/s: %.2f cpu utilization: %.0f%% of %zu threads\n",
+                elapsed.count(), score.get_game_count() / elapsed.count(),
+                100.0 * cpu_seconds / (elapsed.count() * options->config.thread_count),
+                options->config.thread_count);
+    return 0;
+}
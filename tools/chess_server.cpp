@@ -0,0 +1,82 @@
+#include <AnalysisConnection.hpp>
+#include <csignal>
+#include <cstdio>
+#include <cstdlib>
+#include <list>
+#include <memory>
+
+namespace
+{
+constexpr int ACCEPT_POLL_MS = 200;
+
+volatile std::sig_atomic_t stop_requested = 0;
+
+void request_stop(int)
+{
+    stop_requested = 1;
+}
+
+void remove_closed_connections(std::list<std::unique_ptr<AnalysisConnection>>& connections)
+{
+    connections.remove_if([](const auto& connection) {
+        if (!connection->is_closed())
+        {
+            return false;
+        }
+        if (connection->is_slow_consumer())
+        {
+            std::fprintf(stderr, "dropped client not reading its replies\n");
+        }
+        return true;
+    });
+}
+}  // namespace
+
+int main(int argc, char const* argv[])
+{
+    if (argc < 2)
+    {
+        std::fprintf(stderr, "usage: %s <socket path> [search threads]\n", argv[0]);
+        return 1;
+    }
+    AnalysisServerConfig config;
+    if (argc > 2)
+    {
+        config.search_thread_count = std::strtoul(argv[2], nullptr, 10);
+    }
+
+    std::signal(SIGINT, request_stop);
+    std::signal(SIGTERM, request_stop);
+
+    UnixSocket listener;
+    try
+    {
+        listener = UnixSocket::listen(argv[1]);
+    }
+    catch (const std::runtime_error& error)
+    {
+        std::fprintf(stderr, "%s\n", error.what());
+        return 1;
+    }
+    std::printf("listening on %s\n", argv[1]);
+    std::fflush(stdout);
+
+    {
+        AnalysisServer server{config};
+        std::list<std::unique_ptr<AnalysisConnection>> connections;
+        while (!stop_requested)
+        {
+            remove_closed_connections(connections);
+            auto socket = listener.accept(ACCEPT_POLL_MS);
+            if (socket.is_open())
+            {
+                connections.push_back(
+                    std::make_unique<AnalysisConnection>(std::move(socket), server));
+            }
+        }
+        connections.clear();
+        std::fprintf(stderr, "%s\n", to_json(server.get_metrics()).c_str());
+    }
+    std::remove(argv[1]);
+    return 0;
+}
@@ -0,0 +1,56 @@
+#!/usr/bin/env python3
+"""Compares two chess_bench JSON outputs and flags benchmarks that got slower.
+
+usage: compare_bench.py baseline.json contender.json [--threshold 0.05]
+Exit status is 1 if any benchmark is slower than baseline by more than threshold.
+"""
+import argparse
+import json
+import sys
+
+
+def load_times(path):
+    with open(path) as json_file:
+        report = json.load(json_file)
+    times = {}
+    for benchmark in report["benchmarks"]:
+        # with repetitions only the aggregate mean is compared
+        if benchmark.get("run_type") == "aggregate" and benchmark.get("aggregate_name") != "mean":
+            continue
+        name = benchmark.get("run_name", benchmark["name"])
+        times[name] = benchmark["cpu_time"]
+    return times
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("baseline")
+    parser.add_argument("contender")
+    parser.add_argument("--threshold", type=float, default=0.05,
+                        help="relative slowdown reported as regression (default 0.05)")
+    arguments = parser.parse_args()
+
+    baseline = load_times(arguments.baseline)
+    contender = load_times(arguments.contender)
+    regressions = 0
+    for name, baseline_time in baseline.items():
+        if name not in contender:
+            print(f"{name:60} missing in contender")
+            continue
+        change = (contender[name] - baseline_time) / baseline_time
+        status = ""
+        if change > arguments.threshold:
+            status = "REGRESSION"
+            regressions += 1
+        elif change < -arguments.threshold:
+            status = "improvement"
+        print(f"{name:60} {baseline_time:12.1f} {contender[name]:12.1f} {change:+8.1%} {status}")
+    for name in contender.keys() - baseline.keys():
+        print(f"{name:60} new in contender")
+
+    print(f"{regressions} regression(s) over {arguments.threshold:.0%}")
+    return 1 if regressions else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,109 @@
+#include <Instrumentation.hpp>
+#include <MoveBatch.hpp>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <thread>
+
+namespace
+{
+constexpr std::size_t MAX_GAME_PLY = 200;
+
+/**
+ * @brief positions of random games from the starting position, like a request for every
+ *  position of a game
+ */
+std::vector<PositionState> generate_game_positions(std::size_t position_count)
+{
+    std::mt19937 random{42};
+    std::vector<PositionState> positions;
+    positions.reserve(position_count);
+    auto position = PositionState::get_starting_position();
+    std::vector<Move> moves;
+    std::size_t ply = 0;
+    while (positions.size() != position_count)
+    {
+        position.generate_legal_moves(moves);
+        if (moves.empty() || ply++ == MAX_GAME_PLY)
+        {
+            position = PositionState::get_starting_position();
+            ply = 0;
+            continue;
+        }
+        positions.push_back(position);
+        position.make_move(moves[random() % moves.size()]);
+    }
+    return positions;
+}
+
+template <typename Function>
+void measure(const char* name, std::size_t position_count, std::size_t repeat_count,
+             Function&& function)
+{
+    std::size_t move_count = 0;
+    const auto start = std::chrono::steady_clock::now();
+    for (std::size_t repeat = 0; repeat != repeat_count; ++repeat)
+    {
+        move_count += function();
+    }
+    const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    std::printf("%-22s positions/s: %11.1f moves: %zu time: %.3fs\n", name,
+                position_count * repeat_count / elapsed.count(), move_count, elapsed.count());
+}
+}  // namespace
+
+int main(int argc, char const* argv[])
+{
+    const std::size_t position_count = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 1000;
+    const std::size_t repeat_count = argc > 2 ? std::strtoul(argv[2], nullptr, 10) : 100;
+    const std::size_t max_thread_count
+        = argc > 3 ? std::strtoul(argv[3], nullptr, 10)
+                   : std::max(1u, std::thread::hardware_concurrency());
+    const auto positions = generate_game_positions(position_count);
+
+    measure("per call loop", position_count, repeat_count,
+            [&positions]
+            {
+                std::vector<std::vector<Move>> results;
+                std::size_t move_count = 0;
+                for (const auto& position : positions)
+                {
+                    auto position_copy = position.clone();
+                    std::vector<Move> moves;
+                    position_copy.generate_legal_moves(moves);
+                    move_count += moves.size();
+                    results.push_back(std::move(moves));
+                }
+                return move_count;
+            });
+    measure("count only", position_count, repeat_count,
+            [&positions]
+            {
+                std::size_t move_count = 0;
+                for (const auto& position : positions)
+                {
+                    move_count += position.count_legal_moves();
+                }
+                return move_count;
+            });
+    MoveBatch batch;
+    for (std::size_t thread_count = 1; thread_count <= max_thread_count; thread_count *= 2)
+    {
+        const auto name = "batch threads: " + std::to_string(thread_count);
+        // the pool is started once, measured calls only hand out chunks
+        MoveBatchGenerator generator{thread_count};
+        measure(name.c_str(), position_count, repeat_count,
+                [&]
+                {
+                    generator.generate(positions.data(), positions.size(), batch);
+                    return batch.get_moves().size();
+                });
+    }
+    if (is_instrumentation_enabled())
+    {
+        // stats of the main thread: per call loop, count only and single threaded batch
+        std::printf("%s\n", to_json(get_thread_instrumentation_stats()).c_str());
+    }
+    return 0;
+}
@@ -0,0 +1,138 @@
+#include <Pgn.hpp>
+#include <MappedFile.hpp>
+#include <array>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <thread>
+
+namespace
+{
+constexpr std::array<std::string_view, 3> SEED_GAMES = {
+    "1. e4 e5 2. Nf3 d6 3. d4 Bg4 4. dxe5 Bxf3 5. Qxf3 dxe5 6. Bc4 Nf6 7. Qb3 Qe7 8. Nc3 c6\n"
+    "9. Bg5 b5 10. Nxb5 cxb5 11. Bxb5+ Nbd7 12. O-O-O Rd8 13. Rxd7 Rxd7 14. Rd1 Qe6\n"
+    "15. Bxd7+ Nxd7 16. Qb8+ Nxb8 17. Rd8# 1-0",
+    "1. e4 e5 2. f4 exf4 3. Bc4 Qh4+ 4. Kf1 b5 5. Bxb5 Nf6 6. Nf3 Qh6 7. d3 Nh5 8. Nh4 Qg5\n"
+    "9. Nf5 c6 10. g4 Nf6 11. Rg1 cxb5 12. h4 Qg6 13. h5 Qg5 14. Qf3 Ng8 15. Bxf4 Qf6\n"
+    "16. Nc3 Bc5 17. Nd5 Qxb2 18. Bd6 Bxg1 19. e5 Qxa1+ 20. Ke2 Na6 21. Nxg7+ Kd8\n"
+    "22. Qf6+ Nxf6 23. Be7# 1-0",
+    "1. e4 e5 2. Nf3 Nc6 3. Bc4 Bc5 4. b4 Bxb4 5. c3 Ba5 6. d4 exd4 7. O-O d3 8. Qb3 Qf6\n"
+    "9. e5 Qg6 10. Re1 Nge7 11. Ba3 b5 12. Qxb5 Rb8 13. Qa4 Bb6 14. Nbd2 Bb7 15. Ne4 Qf5\n"
+    "16. Bxd3 Qh5 17. Nf6+ gxf6 18. exf6 Rg8 19. Rad1 Qxf3 20. Rxe7+ Nxe7 21. Qxd7+ Kxd7\n"
+    "22. Bf5+ Ke8 23. Bd7+ Kf8 24. Bxe7# 1-0"};
+
+/**
+ * @brief opening statistics the way an ingest job would collect them: results by first move
+ */
+class OpeningStatisticsVisitor : public PgnVisitor
+{
+public:
+    void begin_game() override
+    {
+        m_ply = 0;
+    }
+    void visit_move(const PositionState& position, const Move& move) override
+    {
+        if (m_ply++ == 0)
+        {
+            m_first_move_square = move.to.y * 8 + move.to.x;
+        }
+    }
+    void end_game(GameResult result) override
+    {
+        ++m_results[m_first_move_square][static_cast<std::size_t>(result)];
+    }
+
+private:
+    std::size_t m_ply{0};
+    std::size_t m_first_move_square{0};
+    std::array<std::array<std::size_t, 4>, 64> m_results{};
+};
+
+class MoveCollectingVisitor : public PgnVisitor
+{
+public:
+    void visit_move(const PositionState& position, const Move& move) override
+    {
+        games.back().push_back(move);
+    }
+    void begin_game() override
+    {
+        games.emplace_back();
+    }
+
+    std::vector<std::vector<Move>> games;
+};
+
+/**
+ * @brief writes seed games over and over through PgnWriter, doubles as the writer benchmark
+ */
+void write_synthetic_archive(const std::filesystem::path& path, std::size_t game_count)
+{
+    MoveCollectingVisitor seed_games;
+    PgnReader reader{seed_games};
+    for (const auto seed_game : SEED_GAMES)
+    {
+        reader.parse(seed_game);
+    }
+
+    std::ofstream archive{path, std::ios::binary};
+    auto position = PositionState::get_starting_position();
+    std::size_t move_count = 0;
+    const auto start = std::chrono::steady_clock::now();
+    {
+        PgnWriter writer{archive};
+        for (std::size_t game_index = 0; game_index != game_count; ++game_index)
+        {
+            const auto round = std::to_string(game_index + 1);
+            const auto& moves = seed_games.games[game_index % seed_games.games.size()];
+            writer.write_game(
+                {{"Event", "Synthetic archive"}, {"Round", round}, {"Result", "1-0"}}, position,
+                moves, GameResult::WHITE_WON);
+            move_count += moves.size();
+        }
+    }
+    const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    std::printf("written games: %zu moves: %zu time: %.3fs moves/s: %.1f\n", game_count,
+                move_count, elapsed.count(), move_count / elapsed.count());
+}
+
+void run(std::string_view pgn, std::size_t thread_count)
+{
+    std::vector<OpeningStatisticsVisitor> visitors(thread_count);
+    std::vector<PgnVisitor*> visitor_pointers;
+    for (auto& visitor : visitors)
+    {
+        visitor_pointers.push_back(&visitor);
+    }
+    const auto start = std::chrono::steady_clock::now();
+    const auto stats = parse_pgn_parallel(pgn, visitor_pointers);
+    const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    std::printf("threads: %2zu games: %zu invalid: %zu moves: %zu time: %.3fs games/s: %.1f\n",
+                thread_count, stats.games, stats.invalid_games, stats.moves, elapsed.count(),
+                stats.games / elapsed.count());
+}
+}  // namespace
+
+int main(int argc, char const* argv[])
+{
+    const std::size_t game_count = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 2000;
+    const std::size_t max_thread_count
+        = argc > 2 ? std::strtoul(argv[2], nullptr, 10)
+                   : std::max(1u, std::thread::hardware_concurrency());
+
+    const auto archive_path = std::filesystem::temp_directory_path() / "chess_pgn_bench.pgn";
+    write_synthetic_archive(archive_path, game_count);
+    {
+        const MappedFile archive{archive_path.string()};
+        for (std::size_t thread_count = 1; thread_count <= max_thread_count; thread_count *= 2)
+        {
+            run(archive.get_view(), thread_count);
+        }
+    }
+    std::filesystem::remove(archive_path);
+    return 0;
+}
@@ -0,0 +1,138 @@
+#include <SelfPlay.hpp>
+#include <atomic>
+#include <chrono>
+#include <cinttypes>
+#include <cstdio>
+#include <cstdlib>
+#include <optional>
+#include <stdexcept>
+#include <string_view>
+#include <thread>
+
+namespace
+{
+struct SelfPlayOptions
+{
+    SelfPlayConfig config;
+    std::optional<std::chrono::seconds> duration;
+};
+
+std::optional<SelfPlayOptions> parse_options(int argc, char const* argv[])
+{
+    SelfPlayOptions options;
+    options.config.thread_count = std::max(1u, std::thread::hardware_concurrency());
+    options.config.game_count = 100;
+    for (int index = 1; index + 1 < argc; index += 2)
+    {
+        const std::string_view option = argv[index];
+        const char* value = argv[index + 1];
+        if (option == "--games")
+        {
+            options.config.game_count = std::strtoul(value, nullptr, 10);
+        }
+        else if (option == "--threads")
+        {
+            options.config.thread_count = std::strtoul(value, nullptr, 10);
+        }
+        else if (option == "--depth")
+        {
+            options.config.limits.max_depth
+                = static_cast<std::uint32_t>(std::strtoul(value, nullptr, 10));
+        }
+        else if (option == "--nodes")
+        {
+            options.config.limits.max_nodes = std::strtoull(value, nullptr, 10);
+        }
+        else if (option == "--random-plies")
+        {
+            options.config.random_plies
+                = static_cast<std::uint32_t>(std::strtoul(value, nullptr, 10));
+        }
+        else if (option == "--seed")
+        {
+            options.config.seed = static_cast<std::uint32_t>(std::strtoul(value, nullptr, 10));
+        }
+        else if (option == "--output")
+        {
+            options.config.output_prefix = value;
+        }
+        else if (option == "--max-file-mb")
+        {
+            options.config.max_file_size = std::strtoul(value, nullptr, 10) << 20;
+        }
+        else if (option == "--seconds")
+        {
+            options.duration = std::chrono::seconds{std::strtoul(value, nullptr, 10)};
+        }
+        else
+        {
+            return std::nullopt;
+        }
+    }
+    if (argc % 2 == 0)
+    {
+        return std::nullopt;
+    }
+    return options;
+}
+}  // namespace
+
+int main(int argc, char const* argv[])
+{
+    const auto options = parse_options(argc, argv);
+    if (!options)
+    {
+        std::fprintf(stderr,
+                     "usage: %s [--games N (0 = until --seconds)] [--threads N] [--depth N]\n"
+                     "  [--nodes N] [--random-plies N] [--seed N] [--output PREFIX]"
+                     " [--max-file-mb N] [--seconds N]\n",
+                     argv[0]);
+        return 1;
+    }
+
+    std::atomic<bool> stop_requested{false};
+    std::thread timer;
+    if (options->duration)
+    {
+        timer = std::thread{[&stop_requested, duration = *options->duration] {
+            const auto end = std::chrono::steady_clock::now() + duration;
+            while (!stop_requested && std::chrono::steady_clock::now() < end)
+            {
+                std::this_thread::sleep_for(std::chrono::milliseconds{100});
+            }
+            stop_requested = true;
+        }};
+    }
+
+    const auto start = std::chrono::steady_clock::now();
+    SelfPlayStatistics statistics;
+    try
+    {
+        statistics = run_self_play(options->config, stop_requested);
+    }
+    catch (const std::runtime_error& error)
+    {
+        std::fprintf(stderr, "%s\n", error.what());
+        stop_requested = true;
+        if (timer.joinable())
+        {
+            timer.join();
+        }
+        return 1;
+    }
+    stop_requested = true;
+    if (timer.joinable())
+    {
+        timer.join();
+    }
+    const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+    std::printf("games: %" PRIu64 " sampled: %" PRIu64 " written: %" PRIu64
+                " duplicates: %" PRIu64 " files: %zu\n",
+                statistics.games, statistics.sampled_positions, statistics.written_positions,
+                statistics.duplicate_positions, statistics.file_count);
+    std::printf("time: %.2fs positions/hour/core: %.0f\n", elapsed.count(),
+                statistics.written_positions * 3600.0
+                    / (elapsed.count() * options->config.thread_count));
+    return 0;
+}
@@ -0,0 +1,127 @@
+#include <GameSessionManager.hpp>
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <thread>
+#include <vector>
+
+namespace
+{
+using Clock = std::chrono::steady_clock;
+
+struct PlayerStatistics
+{
+    std::vector<std::uint32_t> latencies_ns;
+    std::size_t finished_games{0};
+};
+
+/**
+ * @brief plays random moves in its own share of the games, paced to moves_per_second
+ * @note a finished game is closed and replaced, so the number of open games stays the same
+ */
+PlayerStatistics play_games(GameSessionManager& manager,
+                            std::size_t game_count,
+                            double moves_per_second,
+                            Clock::time_point end,
+                            std::uint32_t seed)
+{
+    PlayerStatistics statistics;
+    std::mt19937 random{seed};
+    std::vector<SessionId> ids;
+    for (std::size_t game = 0; game != game_count; ++game)
+    {
+        ids.push_back(manager.create_session(PositionState::get_starting_position()));
+    }
+    std::vector<Move> moves;
+    const auto interval = moves_per_second > 0
+                              ? std::chrono::duration_cast<Clock::duration>(
+                                  std::chrono::duration<double>(1.0 / moves_per_second))
+                              : Clock::duration::zero();
+    auto next_move_time = Clock::now();
+    while (Clock::now() < end)
+    {
+        if (interval != Clock::duration::zero())
+        {
+            std::this_thread::sleep_until(next_move_time);
+            next_move_time += interval;
+        }
+        auto& id = ids[random() % ids.size()];
+        manager.generate_legal_moves(id, moves);
+        if (moves.empty())
+        {
+            manager.close_session(id);
+            id = manager.create_session(PositionState::get_starting_position());
+            ++statistics.finished_games;
+            continue;
+        }
+        const auto& move = moves[random() % moves.size()];
+        const auto start = Clock::now();
+        manager.make_move(id, move.from, move.to, move.promotion);
+        statistics.latencies_ns.push_back(static_cast<std::uint32_t>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start).count()));
+    }
+    return statistics;
+}
+
+std::uint32_t get_percentile(std::vector<std::uint32_t>& samples, std::size_t percent)
+{
+    if (samples.empty())
+    {
+        return 0;
+    }
+    const auto nth = samples.begin() + (samples.size() - 1) * percent / 100;
+    std::nth_element(samples.begin(), nth, samples.end());
+    return *nth;
+}
+}  // namespace
+
+int main(int argc, char const* argv[])
+{
+    const std::size_t game_count = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 10000;
+    const std::size_t thread_count = std::max<std::size_t>(
+        1, argc > 2 ? std::strtoul(argv[2], nullptr, 10) : std::thread::hardware_concurrency());
+    const double target_moves_per_second = argc > 3 ? std::strtod(argv[3], nullptr) : 0;
+    const double seconds = argc > 4 ? std::strtod(argv[4], nullptr) : 5;
+
+    GameSessionManager manager;
+    std::vector<PlayerStatistics> statistics(thread_count);
+    std::vector<std::thread> players;
+    const auto start = Clock::now();
+    const auto end = start + std::chrono::duration_cast<Clock::duration>(
+                                 std::chrono::duration<double>(seconds));
+    for (std::size_t thread_index = 0; thread_index != thread_count; ++thread_index)
+    {
+        players.emplace_back([&, thread_index] {
+            const auto games = game_count / thread_count
+                               + (thread_index < game_count % thread_count ? 1 : 0);
+            statistics[thread_index]
+                = play_games(manager, std::max<std::size_t>(1, games),
+                             target_moves_per_second / thread_count, end,
+                             static_cast<std::uint32_t>(thread_index));
+        });
+    }
+    for (auto& player : players)
+    {
+        player.join();
+    }
+    const std::chrono::duration<double> elapsed = Clock::now() - start;
+
+    std::vector<std::uint32_t> latencies;
+    std::size_t finished_games = 0;
+    for (const auto& player_statistics : statistics)
+    {
+        latencies.insert(latencies.end(), player_statistics.latencies_ns.begin(),
+                         player_statistics.latencies_ns.end());
+        finished_games += player_statistics.finished_games;
+    }
+    std::printf("games: %zu threads: %zu target moves/s: %.0f\n", manager.get_session_count(),
+                thread_count, target_moves_per_second);
+    std::printf("moves: %zu moves/s: %.1f finished games: %zu\n", latencies.size(),
+                latencies.size() / elapsed.count(), finished_games);
+    const auto p50 = get_percentile(latencies, 50);
+    const auto p99 = get_percentile(latencies, 99);
+    std::printf("make_move ns p50: %u p99: %u\n", p50, p99);
+    return 0;
+}
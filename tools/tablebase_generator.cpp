@@ -0,0 +1,71 @@
+#include <TablebaseGenerator.hpp>
+#include <array>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <string>
+#include <thread>
+
+namespace
+{
+constexpr std::array<std::string_view, 5> DEFAULT_MATERIALS = {"KPK", "KQK", "KRK", "KBK", "KNK"};
+
+void print_statistics(const std::string& material_name, const std::vector<std::uint8_t>& values)
+{
+    std::array<std::size_t, 3> result_counts{};
+    std::size_t longest_mate = 0;
+    for (const auto value : values)
+    {
+        const auto probe = decode_tablebase_value(value);
+        if (!probe)
+        {
+            continue;
+        }
+        ++result_counts[static_cast<std::size_t>(probe->result)];
+        if (probe->result == TablebaseResult::WIN)
+        {
+            longest_mate = std::max<std::size_t>(longest_mate, probe->plies_to_mate);
+        }
+    }
+    std::printf("%-6s wins: %zu draws: %zu losses: %zu longest mate: %zu plies\n",
+                material_name.c_str(), result_counts[0], result_counts[1], result_counts[2],
+                longest_mate);
+}
+}  // namespace
+
+int main(int argc, char const* argv[])
+{
+    if (argc < 2)
+    {
+        std::printf("usage: %s <output directory> [thread count] [material...]\n", argv[0]);
+        return 1;
+    }
+    const std::string directory = argv[1];
+    const std::size_t thread_count
+        = argc > 2 ? std::strtoul(argv[2], nullptr, 10)
+                   : std::max(1u, std::thread::hardware_concurrency());
+    std::vector<std::string_view> materials(DEFAULT_MATERIALS.begin(), DEFAULT_MATERIALS.end());
+    if (argc > 3)
+    {
+        materials.assign(argv + 3, argv + argc);
+    }
+
+    TablebaseGenerator generator{thread_count};
+    const auto start = std::chrono::steady_clock::now();
+    for (const auto material : materials)
+    {
+        generator.generate(material);
+    }
+    const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    std::printf("generated %zu tables on %zu threads in %.3fs\n",
+                generator.get_material_names().size(), thread_count, elapsed.count());
+
+    std::filesystem::create_directories(directory);
+    generator.write(directory);
+    for (const auto& material_name : generator.get_material_names())
+    {
+        print_statistics(material_name, generator.generate(material_name));
+    }
+    return 0;
+}
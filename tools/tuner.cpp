@@ -0,0 +1,128 @@
+#include <Tuner.hpp>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+namespace
+{
+struct TunerOptions
+{
+    std::vector<std::string> data_paths;
+    std::size_t epoch_count{200};
+    std::size_t report_interval{10};
+    TunerConfig config;
+    std::string output_path{"EvaluationParameters.hpp"};
+};
+
+std::optional<TunerOptions> parse_options(int argc, char const* argv[])
+{
+    TunerOptions options;
+    options.config.thread_count = std::max(1u, std::thread::hardware_concurrency());
+    for (int index = 1; index + 1 < argc; index += 2)
+    {
+        const std::string_view option = argv[index];
+        const char* value = argv[index + 1];
+        if (option == "--data")
+        {
+            options.data_paths.emplace_back(value);
+        }
+        else if (option == "--epochs")
+        {
+            options.epoch_count = std::strtoul(value, nullptr, 10);
+        }
+        else if (option == "--report")
+        {
+            options.report_interval = std::max<std::size_t>(1, std::strtoul(value, nullptr, 10));
+        }
+        else if (option == "--threads")
+        {
+            options.config.thread_count = std::strtoul(value, nullptr, 10);
+        }
+        else if (option == "--lr")
+        {
+            options.config.learning_rate = std::strtod(value, nullptr);
+        }
+        else if (option == "--result-weight")
+        {
+            options.config.result_weight = std::strtod(value, nullptr);
+        }
+        else if (option == "--output")
+        {
+            options.output_path = value;
+        }
+        else
+        {
+            return std::nullopt;
+        }
+    }
+    if (argc % 2 == 0 || options.data_paths.empty())
+    {
+        return std::nullopt;
+    }
+    return options;
+}
+}  // namespace
+
+int main(int argc, char const* argv[])
+{
+    const auto options = parse_options(argc, argv);
+    if (!options)
+    {
+        std::fprintf(stderr,
+                     "usage: %s --data FILE [--data FILE ...] [--epochs N] [--report N]\n"
+                     "  [--threads N] [--lr RATE] [--result-weight W] [--output HEADER]\n",
+                     argv[0]);
+        return 1;
+    }
+
+    using Clock = std::chrono::steady_clock;
+    auto start = Clock::now();
+    TunerDataset dataset;
+    try
+    {
+        for (const auto& path : options->data_paths)
+        {
+            dataset.add_records(read_training_records(path));
+        }
+    }
+    catch (const std::runtime_error& error)
+    {
+        std::fprintf(stderr, "%s\n", error.what());
+        return 1;
+    }
+    std::chrono::duration<double> elapsed = Clock::now() - start;
+    std::printf("positions: %zu load time: %.2fs\n", dataset.get_position_count(),
+                elapsed.count());
+
+    EvaluationTuner tuner{dataset, EvaluationParameters::get_compiled(), options->config};
+    std::printf("k: %.6f error: %.6f\n", tuner.fit_scaling_constant(), tuner.get_error());
+    start = Clock::now();
+    for (std::size_t epoch = 1; epoch <= options->epoch_count; ++epoch)
+    {
+        const auto error = tuner.run_epoch();
+        if (epoch % options->report_interval == 0 || epoch == options->epoch_count)
+        {
+            elapsed = Clock::now() - start;
+            std::printf("epoch: %zu error: %.6f time/epoch: %.3fs\n", epoch, error,
+                        elapsed.count() / epoch);
+            std::fflush(stdout);
+        }
+    }
+
+    std::ofstream output{options->output_path};
+    output << format_evaluation_parameters(tuner.get_parameters());
+    if (!output)
+    {
+        std::fprintf(stderr, "can't write %s\n", options->output_path.c_str());
+        return 1;
+    }
+    std::printf("error: %.6f written to %s\n", tuner.get_error(), options->output_path.c_str());
+    return 0;
+}